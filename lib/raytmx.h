@@ -25,6 +25,11 @@ OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
     #define RAYTMX_DEC extern
   to specify raytmx function declarations as static or extern, respectively.
   The default specifier is extern.
+
+  You can define RAYTMX_TRACE_BEGIN(name) and RAYTMX_TRACE_END() before including the implementation to have the
+  heavier functions (loading, parsing, drawing, animating, and object group collisions) report when they start and
+  finish, e.g. to a profiler's timeline. 'name' is a string literal and each begin is followed by one end on the same
+  thread. By default, both expand to nothing.
 */
 
 #ifndef RAYTMX_H
@@ -32,9 +37,9 @@ OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #include <ctype.h> /* isspace() */
 #include <math.h> /* floor(), INFINITY */
-#include <stddef.h> /* NULL */
+#include <stddef.h> /* NULL, ptrdiff_t */
 #include <stdint.h> /* int32_t, uint32_t */
-#include <stdlib.h> /* atoi(), strtoul() */
+#include <stdlib.h> /* atoi(), qsort(), strtoul() */
 #include <string.h> /* memcpy(), memset(), strcpy(), strcpy_s() strlen(), strncpy(), strncpy_s() */
 
 #include "raylib.h"
@@ -170,6 +175,7 @@ typedef enum tmx_render_order {
 /* Forward declarations of TMX types */
 typedef struct tmx_image TmxImage;
 typedef struct tmx_tile_layer TmxTileLayer;
+typedef struct tmx_chunk TmxChunk;
 typedef struct tmx_object_group TmxObjectGroup;
 typedef struct tmx_image_layer TmxImageLayer;
 typedef struct tmx_layer TmxLayer;
@@ -183,6 +189,9 @@ typedef struct tmx_object TmxObject;
 typedef struct tmx_text TmxText;
 typedef struct tmx_text_line TmxTextLine;
 typedef struct tmx_map TmxMap;
+typedef struct tmx_world_map TmxWorldMap;
+typedef struct tmx_world TmxWorld;
+typedef struct tmx_memory_usage TmxMemoryUsage;
 
 /**
  * Model of an <image> element. Defines an image and relevant attributes along with a loaded texture.
@@ -196,9 +205,24 @@ typedef struct tmx_image {
     Texture2D texture; /**< The image as a raylib texture loaded into VRAM, if loading was successful. */
 } TmxImage;
 
+/**
+ * Model of a <chunk> element. Defines a rectangular piece of an infinite map's tile layer. A chunk's tiles are kept
+ * encoded until UpdateChunksTMX() decodes them, and may be released again to stay within the map's chunk budget.
+ */
+typedef struct tmx_chunk {
+    int32_t x; /**< X coordinate of the chunk's top-left tile. May be negative. */
+    int32_t y; /**< Y coordinate of the chunk's top-left tile. May be negative. */
+    uint32_t width; /**< Width of the chunk in tiles. */
+    uint32_t height; /**< Height of the chunk in tiles. */
+    char* data; /**< The chunk's tiles as they appear in the document, encoded as given by the tile layer. */
+    uint32_t* tiles; /**< (Optional) array of 'width' * 'height' decoded tile GIDs. NULL when the chunk is not resident,
+                          meaning it's neither drawn nor checked for collisions. */
+    uint32_t lastUsed; /**< Value of the map's 'chunkClock' when the chunk was last within the streamed area. */
+} TmxChunk;
+
 /**
  * Model of a <layer> element when combined with the 'TmxLayer' model. Defines a tile layer with a fixed-size list of
- * tile Global IDs (GIDs).
+ * tile Global IDs (GIDs) or, for infinite maps, a list of chunks.
  */
 typedef struct tmx_tile_layer {
     uint32_t width; /**< Width of the layer in tiles. */
@@ -207,6 +231,12 @@ typedef struct tmx_tile_layer {
     char* compression; /**< (Optional) compression used to compress tiles. May be NULL, "gzip," "zlib," or "zstd." */
     uint32_t* tiles; /**< Array of tile Global IDs (GIDs) contained by this tile layer. */
     uint32_t tilesLength; /**< Length of the 'tiles' array. */
+    TmxChunk* chunks; /**< (Optional) array of chunks containing this layer's tiles when the map is infinite. */
+    uint32_t chunksLength; /**< Length of the 'chunks' array. */
+    Texture2D gidsTexture; /**< (Optional) the 'tiles' array as a texture with one RGBA texel, the raw GID's four bytes,
+                                per tile. Only set by EnableGpuRenderingTMX() for layers it can draw. */
+    Texture2D atlasTexture; /**< (Optional) the one texture every tile in this layer is drawn from. Only set along with
+                                 'gidsTexture.' */
 } TmxTileLayer;
 
 /**
@@ -222,6 +252,16 @@ typedef struct tmx_object_group {
     TmxObject* objects; /**< Array of objects contained by this object layer. */
     uint32_t objectsLength; /**< Length of the 'objects' array. */
     uint32_t* ySortedObjects; /**< Array of indexes of 'objects' sorted by the objects' y-coordinates. */
+    /* The objects whose shapes are their AABBs (rectangles, ellipses, text, and tiles) as a structure of arrays, for */
+    /* CheckCollisionTMXBoxesRec(). Padded with empty boxes, which collide with nothing, to a multiple of 64. */
+    float* boxMinX; /**< Left edge of each box. */
+    float* boxMinY; /**< Top edge of each box. */
+    float* boxMaxX; /**< Right edge of each box. */
+    float* boxMaxY; /**< Bottom edge of each box. */
+    uint32_t* boxObjects; /**< Index in 'objects' of each box, in ascending order. */
+    uint32_t boxesLength; /**< Number of boxes, not counting the padding. */
+    uint32_t* otherObjects; /**< Indexes in 'objects' of the remaining objects, in ascending order. */
+    uint32_t otherObjectsLength; /**< Length of the 'otherObjects' array. */
 } TmxObjectGroup;
 
 /**
@@ -337,7 +377,8 @@ typedef struct tmx_tileset_tile {
  */
 typedef struct tmx_animation_frame {
     uint32_t id; /**< The local ID, not Global ID (GID), of a tile within the animation's tileset. */
-    float duration; /**< Duration in milliseconds that the frame should be displayed. */
+    float duration; /**< Duration in seconds that the frame should be displayed. TMX stores milliseconds, which are
+                         converted on load. */
 } TmxAnimationFrame;
 
 /**
@@ -423,6 +464,7 @@ typedef struct tmx_map {
     TmxRenderOrder renderOrder; /**< Order in which tiles on tile layers are rendered. */
     uint32_t width; /**< Width of this map in tiles. */
     uint32_t height; /**< Height of htis map in tiles. */
+    bool infinite; /**< When true, indicates the tile layers' tiles are split into chunks. See UpdateChunksTMX(). */
     uint32_t tileWidth; /**< Width of a tile in pixels. */
     uint32_t tileHeight; /**< Height of a tile in pixels. */
     int32_t parallaxOriginX; /**< X coordinate, in pixels, of the parallax origin. */
@@ -435,11 +477,58 @@ typedef struct tmx_map {
     uint32_t tilesetsLength; /**< Length of the 'tilesets' array. */
     TmxLayer* layers; /**< Array of layers and potential child layers that make up this map. */
     uint32_t layersLength; /**< Length of the 'layers' array. */
-    TmxTile* gidsToTiles; /**< Array of pre-calculated tile metadata with all the values needed to quickly draw a tile
+    TmxTile* gidsToTiles; /**< Array of pre-calculated tile metadata, including animations and collision objects,
                                given its GID. Allocated such that gidsToTiles[1] returns the data of tile GID 1. */
     uint32_t gidsToTilesLength; /**< Length of the 'gidsToTiles' array. */
+    struct raytmx_tile_draw* gidsToDraws; /**< Opaque array, parallel to 'gidsToTiles', of the compact records that
+                                               drawing tile layers reads instead of the full tile metadata. */
+    Texture2D* textures; /**< Array of every unique texture loaded for this map. Unloaded by UnloadTMX(). */
+    uint32_t texturesLength; /**< Length of the 'textures' array. */
+    struct raytmx_arena* arena; /**< Opaque bump allocator that owns every allocation made for this map, including the
+                                     map itself. UnloadTMX() releases it in one step. */
+    struct raytmx_gpu_renderer* gpuRenderer; /**< (Optional) opaque shader and tile table used to draw tile layers in
+                                                  a single pass. NULL unless EnableGpuRenderingTMX() succeeded. */
+    size_t chunkBudget; /**< Most bytes of decoded chunk tiles an infinite map keeps resident. Chunks outside the
+                             streamed area are released, least recently used first, when this is exceeded. */
+    size_t chunkBytes; /**< Bytes of decoded chunk tiles currently resident. */
+    uint32_t chunkClock; /**< Incremented with each call to UpdateChunksTMX(). */
 } TmxMap;
 
+/**
+ * Model of one map placed in a world by a Tiled .world file. The map is only loaded while it's near the area given to
+ * UpdateWorldTMX().
+ */
+typedef struct tmx_world_map {
+    char* fileName; /**< Path of the TMX file, resolved relative to the world file's directory. */
+    int32_t x; /**< X coordinate, in pixels, of the map's top-left corner within the world. */
+    int32_t y; /**< Y coordinate, in pixels, of the map's top-left corner within the world. */
+    uint32_t width; /**< Width of the map in pixels. */
+    uint32_t height; /**< Height of the map in pixels. */
+    TmxMap* map; /**< The loaded map model, or NULL while the map is streamed out. */
+    bool isLoadFailed; /**< When true, loading the map failed and it won't be attempted again. */
+} TmxWorldMap;
+
+/**
+ * Model of a Tiled .world file: a set of maps sharing one coordinate space, streamed in and out by UpdateWorldTMX().
+ */
+typedef struct tmx_world {
+    char* fileName; /**< File name of the .world file with extension. */
+    TmxWorldMap* maps; /**< Array of the maps placed in the world. */
+    uint32_t mapsLength; /**< Length of the 'maps' array. */
+    bool useGpuRendering; /**< When true, EnableGpuRenderingTMX() is called for each map as it's loaded. */
+    struct raytmx_arena* arena; /**< Opaque bump allocator that owns the world model, excluding its loaded maps. */
+} TmxWorld;
+
+/**
+ * Memory held by a loaded map, as reported by GetMemoryUsageTMX().
+ */
+typedef struct tmx_memory_usage {
+    size_t heapBytes; /**< Bytes allocated for the map's model, i.e. the blocks of its arena. */
+    size_t chunkBytes; /**< Bytes of decoded chunk tiles currently resident. Only infinite maps have these. */
+    size_t textureBytes; /**< Estimated bytes of VRAM used by the map's textures, including those of the GPU renderer.
+                              The estimate excludes mipmaps and any padding the driver adds. */
+} TmxMemoryUsage;
+
 /**
  * Given a path to TMX document, parse it and create an equivalent model that can be, among other uses, quickly drawn.
  * This function allocates memory and loads textures into VRAM. To clean up, use UnloadTMX().
@@ -451,7 +540,8 @@ RAYTMX_DEC TmxMap* LoadTMX(const char* fileName);
 
 /**
  * Unload a given map model by freeing memory allocations and unloading textures. In other words, free the resources
- * reserved by LoadTMX().
+ * reserved by LoadTMX(). All of the map's memory is owned by a single arena so this does not walk the map's layers,
+ * objects, or properties.
  *
  * @param map A previously-loaded map model to be freed/unloaded.
  */
@@ -492,6 +582,16 @@ RAYTMX_DEC void DrawTMX(const TmxMap* map, const Camera2D* camera, int posX, int
 RAYTMX_DEC void DrawTMXLayers(const TmxMap* map, const Camera2D* camera, const TmxLayer* layers, uint32_t layersLength,
     int posX, int posY, Color tint);
 
+/**
+ * Set the size of the area being drawn into, which drawing functions given a camera cull against. By default that's
+ * the whole framebuffer, but when only its top-left part is drawn into, e.g. a RenderTexture2D allocated larger than
+ * needed with the rest scissored away, culling against the whole framebuffer would draw tiles that can't be seen.
+ *
+ * @param width Width, in pixels, of the area being drawn into, or zero to use the framebuffer's width.
+ * @param height Height, in pixels, of the area being drawn into, or zero to use the framebuffer's height.
+ */
+RAYTMX_DEC void SetViewportTMX(int width, int height);
+
 /**
  * Progress the animations of the given map in real-time. This is intended to be called once per frame, or once per
  * BeginDrawing() an EndDrawing() call. If called more or less frequently, animation speeds will be affected.
@@ -500,6 +600,89 @@ RAYTMX_DEC void DrawTMXLayers(const TmxMap* map, const Camera2D* camera, const T
  */
 RAYTMX_DEC void AnimateTMX(TmxMap* map);
 
+/**
+ * Stream the chunks of an infinite map's tile layers. Chunks within, or near, the given area are decoded if they
+ * aren't already, and chunks that haven't been near it recently are released once the decoded tiles exceed the map's
+ * 'chunkBudget.' Drawing and collision checks only see resident chunks so this is expected to be called every frame,
+ * before either, with the area the camera sees. Does nothing for maps that aren't infinite.
+ *
+ * @param map A loaded map model whose chunks are to be streamed.
+ * @param area The rectangle, in pixels relative to the map, around which chunks should be resident.
+ */
+RAYTMX_DEC void UpdateChunksTMX(TmxMap* map, Rectangle area);
+
+/**
+ * Prepare the given map's tile layers to be drawn by a shader, one pass per layer, rather than tile by tile. Each
+ * layer's Global IDs (GIDs) are uploaded as a texture along with a small table of the map's tiles and animation frames.
+ * Afterwards, DrawTMX() and DrawTMXLayers() draw those layers with one quad each, so the CPU cost of a layer doesn't
+ * depend on the zoom or screen size, and their animations follow GetTime() without the need for AnimateTMX().
+ * A tile layer is drawn this way when the map is orthogonal and all of the layer's tiles, including animation frames,
+ * come from one texture at the map's tile size without a tile offset. Other layers are still drawn tile by tile.
+ * Requires OpenGL 3.3 or newer. The resources are released by UnloadTMX().
+ *
+ * @param map A loaded map model whose tile layers are to be drawn by the GPU.
+ * @return True if at least one tile layer will be drawn by the GPU, or false if none will.
+ */
+RAYTMX_DEC bool EnableGpuRenderingTMX(TmxMap* map);
+
+/**
+ * Given a path to a Tiled .world file, read the placement of each of its maps. No maps are loaded until
+ * UpdateWorldTMX() finds them near the given area. Only explicitly-listed maps are supported, not patterns. To clean
+ * up, use UnloadWorldTMX().
+ *
+ * @param fileName File name and/or path referencing a .world document on disk to be loaded.
+ * @return A model of the world with none of its maps loaded, or NULL if loading failed for any reason.
+ */
+RAYTMX_DEC TmxWorld* LoadWorldTMX(const char* fileName);
+
+/**
+ * Unload a given world model along with any of its maps that are loaded.
+ *
+ * @param world A previously-loaded world model to be freed/unloaded.
+ */
+RAYTMX_DEC void UnloadWorldTMX(TmxWorld* world);
+
+/**
+ * Unload any of a world's maps that are loaded while keeping the world model itself, e.g. when leaving the world for a
+ * while. UpdateWorldTMX() loads them again as needed.
+ *
+ * @param world A loaded world model whose maps are to be unloaded.
+ */
+RAYTMX_DEC void UnloadWorldMapsTMX(TmxWorld* world);
+
+/**
+ * Stream the maps of a world. Maps overlapping the given area are loaded right away, maps near it are loaded ahead of
+ * time at a rate of one per call, and maps that have moved well away from it are unloaded. The chunks of loaded
+ * infinite maps are streamed with UpdateChunksTMX() and their animations are progressed, so this is intended to be
+ * called once per frame with the area the camera sees, in place of AnimateTMX().
+ *
+ * @param world A loaded world model whose maps are to be streamed.
+ * @param area The rectangle, in pixels relative to the world, around which maps should be loaded.
+ */
+RAYTMX_DEC void UpdateWorldTMX(TmxWorld* world, Rectangle area);
+
+/**
+ * Draw the loaded maps of the given world, each at its position within the world. With a camera, maps outside of the
+ * screen are skipped. See DrawTMX().
+ *
+ * @param world A loaded world model to be drawn.
+ * @param camera (Optional) camera to be used for parallax and occlusion.
+ * @param tint A tint to be applied to the maps and their layers. This tint is combined with any individual layer tints.
+ */
+RAYTMX_DEC void DrawWorldTMX(const TmxWorld* world, const Camera2D* camera, Color tint);
+
+/**
+ * Check for collisions between a rectangle and the loaded maps of a world. Both the collision information of tiles in
+ * tile layers and the objects of object groups are checked.
+ *
+ * @param world A loaded world model to be checked for collisions.
+ * @param rec The rectangle, in pixels relative to the world, to be checked for collisions.
+ * @param outputObject Output parameter assigned with the object the rectangle collided with, translated to world
+ *                     coordinates, if a collision occurred. NULL if not wanted.
+ * @return True if a collision is found, or false otherwise.
+ */
+RAYTMX_DEC bool CheckCollisionWorldTMXRec(const TmxWorld* world, Rectangle rec, TmxObject* outputObject);
+
 /**
  * Check for collisions between two objects of arbitrary type. Objects that are not primitive shapes, namely text and
  * tiles, are treated as rectangles.
@@ -603,6 +786,18 @@ RAYTMX_DEC bool CheckCollisionTMXLayersPolyEx(const TmxMap* map, const TmxLayer*
  */
 RAYTMX_DEC bool CheckCollisionTMXObjectGroupRec(TmxObjectGroup group, Rectangle rec, TmxObject* outputObject);
 
+/**
+ * Check the given rectangle against 64 of an object group's boxes, its rectangles, ellipses, texts, and tiles, at
+ * once. Uses AVX or SSE2 when the compiler targets them. The results match CheckCollisionRecs() exactly.
+ *
+ * @param group The object group whose boxes will be checked for collisions.
+ * @param first Index of the first box to check, a multiple of 64 less than the group's 'boxesLength.'
+ * @param rec The rectangle to perform collision checks on.
+ * @return Bit n is set when box 'first' + n collides with the rectangle. The object it belongs to is
+ *         group->objects[group->boxObjects[first + n]].
+ */
+RAYTMX_DEC uint64_t CheckCollisionTMXBoxesRec(const TmxObjectGroup* group, uint32_t first, Rectangle rec);
+
 /**
  * Check for collisions between the given object group, with 0+ objects of arbitrary shape, and the given circle.
  * Note: This function assumes the map is positioned at (0, 0). If the map is drawn with an offset, normalize.
@@ -657,6 +852,15 @@ RAYTMX_DEC bool CheckCollisionTMXObjectGroupPoly(TmxObjectGroup group, Vector2*
 RAYTMX_DEC bool CheckCollisionTMXObjectGroupPolyEx(TmxObjectGroup group, Vector2* points, int pointCount,
     Rectangle aabb, TmxObject* outputObject);
 
+/**
+ * Measure the memory held by a loaded map: the heap allocations that make up its model and the VRAM of its textures.
+ * This walks a handful of arena blocks and textures so it's cheap enough to call every frame.
+ *
+ * @param map A loaded map whose memory usage is to be measured.
+ * @return The map's memory usage, or all zeros if the given map is NULL.
+ */
+RAYTMX_DEC TmxMemoryUsage GetMemoryUsageTMX(const TmxMap* map);
+
 /**
  * Log properties of the given map as a formatted string.
  * SetTraceLogFlagsTMX() may be used to exclude select information.
@@ -685,10 +889,29 @@ RAYTMX_DEC void SetTraceLogFlagsTMX(int logFlags);
 #endif
 #include "hoxml.h"
 
+#if defined(__AVX__)
+    #include <immintrin.h> /* Vectorized box collisions, 8 at a time */
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h> /* Vectorized box collisions, 4 at a time */
+#endif
+
 /******************/
 /* Implementation */
 
 #define TMX_LINE_THICKNESS 3.0f /* Thickness, in pixels, that outlines of specific objects are drawn with */
+#define RAYTMX_ARENA_BLOCK_SIZE 65536 /* Minimum size, in bytes, of the blocks arenas allocate from */
+#define RAYTMX_ARENA_ALIGNMENT 16 /* Alignment, in bytes, of every allocation made from an arena */
+#define RAYTMX_GPU_MAX_FRAMES 64 /* Most frames an animation can have and still be drawn by the tile layer shader */
+#define RAYTMX_GPU_MAX_TEXTURE_SIZE 16384 /* Largest texture dimension the GPU renderer will assume is supported */
+#define RAYTMX_DEFAULT_CHUNK_BUDGET 4194304 /* Default bytes of decoded chunk tiles an infinite map keeps resident */
+#define RAYTMX_BOX_BATCH 64 /* Boxes checked by one call to CheckCollisionTMXBoxesRec(), one per bit of its result */
+
+#ifndef RAYTMX_TRACE_BEGIN
+    #define RAYTMX_TRACE_BEGIN(name)
+#endif /* RAYTMX_TRACE_BEGIN */
+#ifndef RAYTMX_TRACE_END
+    #define RAYTMX_TRACE_END()
+#endif /* RAYTMX_TRACE_END */
 
 /* Bit flags that GIDs may be masked with in order to indicate transformations for individual tiles */
 enum tmx_flip_flags {
@@ -698,26 +921,49 @@ enum tmx_flip_flags {
     FLIP_FLAG_ROTATE_120 = 0x10000000
 };
 
+/* The corner of a tile's source rectangle used by each corner of the quad it's drawn with, for each combination of */
+/* flip flags. Indexed by the GID's horizontal, vertical, and diagonal flags shifted down to bits 2, 1, and 0. The */
+/* quad's corners are ordered top-left, bottom-left, bottom-right, top-right. Bit 0 of a value selects the right */
+/* edge of the source rectangle, rather than the left, and bit 1 selects the bottom edge, rather than the top. */
+static const unsigned char tmxFlipCorners[8][4] = {
+    { 0, 2, 3, 1 }, /* No flips */
+    { 0, 1, 3, 2 }, /* Diagonal: the bottom-left and top-right corners trade places */
+    { 2, 0, 1, 3 }, /* Vertical */
+    { 1, 0, 2, 3 }, /* Vertical and diagonal */
+    { 1, 3, 2, 0 }, /* Horizontal */
+    { 2, 3, 1, 0 }, /* Horizontal and diagonal */
+    { 3, 1, 0, 2 }, /* Horizontal and vertical */
+    { 3, 2, 0, 1 } /* Horizontal, vertical, and diagonal */
+};
+
 /* Declarations of some private stuff used to implement public stuff */
+typedef struct raytmx_arena_block RaytmxArenaBlock;
+typedef struct raytmx_arena RaytmxArena;
+typedef struct raytmx_buffer RaytmxBuffer;
 typedef struct raytmx_external_tileset RaytmxExternalTileset;
 typedef struct raytmx_object_template RaytmxObjectTemplate;
 typedef struct raytmx_cached_texture RaytmxCachedTextureNode;
 typedef struct raytmx_cached_template RaytmxCachedTemplateNode;
-typedef struct raytmx_property_node RaytmxPropertyNode;
-typedef struct raytmx_tileset_node RaytmxTilesetNode;
-typedef struct raytmx_tileset_tile_node RaytmxTilesetTileNode;
-typedef struct raytmx_animation_frame_node RaytmxAnimationFrameNode;
 typedef struct raytmx_layer_node RaytmxLayerNode;
-typedef struct raytmx_tile_layer_tile_node RaytmxTileLayerTileNode;
-typedef struct raytmx_object_node RaytmxObjectNode;
-typedef struct raytmx_object_sorting_node RaytmxObjectSortingNode;
-typedef struct raytmx_poly_point_node RaytmxPolyPointNode;
-typedef struct raytmx_text_line_node RaytmxTextLineNode;
+typedef struct raytmx_object_sorting_entry RaytmxObjectSortingEntry;
+typedef struct raytmx_gpu_renderer RaytmxGpuRenderer;
 typedef enum raytmx_document_format {
     FORMAT_TMX = 0, /* Tilemap with tilesets, layers, etc. */
     FORMAT_TSX, /* External tilesets */
     FORMAT_TX /* Object templates */
 } RaytmxDocumentFormat;
+typedef struct raytmx_arena_block {
+    RaytmxArenaBlock* next;
+    size_t capacity, used; /* In bytes, excluding this header. The block's memory directly follows the header. */
+} RaytmxArenaBlock;
+typedef struct raytmx_arena {
+    RaytmxArenaBlock* blocks; /* Allocations are bumped from the first block. The rest are full or oversized. */
+    size_t blockSize; /* Capacity of the next block to be allocated. Doubles with each block to keep the count low. */
+} RaytmxArena; /* Bump allocator whose allocations are never freed individually, only all at once */
+typedef struct raytmx_buffer {
+    void* data;
+    uint32_t length, capacity; /* In elements, not bytes */
+} RaytmxBuffer; /* Contiguous array, allocated from an arena, that doubles in capacity when it fills up */
 typedef struct raytmx_external_tileset {
     TmxTileset tileset;
     bool isSuccess; /* 'isSuccess' is true when the external tileset was successfully loaded */
@@ -737,62 +983,52 @@ typedef struct raytmx_cached_template {
     RaytmxObjectTemplate objectTemplate;
     RaytmxCachedTemplateNode* next;
 } RaytmxCachedTemplateNode; /* Associates a file name with an object template */
-typedef struct raytmx_property_node {
-    TmxProperty property;
-    RaytmxPropertyNode* next;
-} RaytmxPropertyNode;
-typedef struct raytmx_tileset_node {
-    TmxTileset tileset;
-    RaytmxTilesetNode* next;
-} RaytmxTilesetNode;
-typedef struct raytmx_tileset_tile_node {
-    TmxTilesetTile tile;
-    RaytmxTilesetTileNode* next;
-} RaytmxTilesetTileNode;
-typedef struct raytmx_animation_frame_node {
-    TmxAnimationFrame frame;
-    RaytmxAnimationFrameNode* next;
-} RaytmxAnimationFrameNode;
 typedef struct raytmx_layer_node {
     TmxLayer layer;
-    uint32_t childrenLength;
-    RaytmxLayerNode *next, *parent, *childrenRoot, *childrenTail;
+    RaytmxLayerNode* parent; /* Lives in the parent's parent's 'children', which can't grow while 'parent' is open */
+    RaytmxBuffer children; /* RaytmxLayerNodes, only used by <group>s */
 } RaytmxLayerNode;
-typedef struct raytmx_tile_layer_tile_node {
-    uint32_t gid;
-    RaytmxTileLayerTileNode* next;
-} RaytmxTileLayerTileNode;
-typedef struct raytmx_object_node {
-    TmxObject object;
-    RaytmxObjectNode* next;
-} RaytmxObjectNode;
-typedef struct raytmx_object_sorting_node {
+typedef struct raytmx_object_sorting_entry {
     double y;
     uint32_t index;
-    RaytmxObjectSortingNode* next;
-} RaytmxObjectSortingNode;
-typedef struct raytmx_poly_point_node {
-    Vector2 point;
-    RaytmxPolyPointNode* next;
-} RaytmxPolyPointNode;
-typedef struct raytmx_text_line_node {
-    TmxTextLine line;
-    RaytmxTextLineNode* next;
-} RaytmxTextLineNode;
+} RaytmxObjectSortingEntry;
+typedef struct raytmx_gpu_renderer {
+    Shader shader;
+    /* Row 0 has a texel per GID: (source X, source Y, index of first frame, number of frames) where a negative */
+    /* source X marks an unknown GID. Row 1 has a texel per animation frame: (source X, source Y, duration, total */
+    /* duration). */
+    Texture2D tileTable;
+    Texture2D* gidsTextures; /* Every layer's 'gidsTexture' so they can be unloaded without walking the layers */
+    uint32_t gidsTexturesLength;
+    int gidsLoc, tileTableLoc, layerSizeLoc, tileSizeLoc, atlasSizeLoc, timeLoc;
+} RaytmxGpuRenderer; /* Resources shared by all of a map's GPU-drawn tile layers */
+typedef struct raytmx_tile_draw {
+    float u[2], v[2]; /* Left and right, then top and bottom, texture coordinates of the tile's source rectangle */
+    float offsetX, offsetY; /* Position of the tile's top-left corner relative to its cell, in pixels */
+    float width, height; /* Size the tile is drawn with, in pixels */
+    unsigned int textureId; /* OpenGL ID of the texture the tile is drawn from, or zero if it can't be drawn */
+    uint32_t animationGid; /* When non-zero, the tile is an animation and this is the GID of its current frame */
+} RaytmxTileDraw; /* Everything needed to draw a tile layer's tile, and nothing more, precomputed per GID */
 typedef struct raytmx_state {
     RaytmxDocumentFormat format;
     char documentDirectory[512];
     bool isSuccess;
 
+    /* Arenas shared by a map and any TSX or TX documents it references. 'arena' owns everything that outlives */
+    /* parsing and is handed to the map. 'scratch' owns the linked lists, caches, and other intermediate data and */
+    /* is destroyed once when LoadTMX() is done with it. */
+    RaytmxArena *arena, *scratch;
+
     /* Variables intended for TMX (map) parsing */
     RaytmxCachedTextureNode* texturesRoot;
+    uint32_t texturesLength;
     RaytmxCachedTemplateNode* templatesRoot;
     TmxOrientation mapOrientation;
     TmxRenderOrder mapRenderOrder;
     uint32_t mapWidth, mapHeight, mapTileWidth, mapTileHeight, mapPropertiesLength;
     int32_t mapParallaxOriginX, mapParallaxOriginY;
     Color mapBackgroundColor;
-    bool mapHasBackgroundColor;
+    bool mapHasBackgroundColor, mapInfinite;
     TmxProperty* mapProperties;
 
     /* These variables, when not NULL, are assigned to the current element(s) being parsed */
@@ -805,46 +1041,76 @@ typedef struct raytmx_state {
     /* TmxWangColor* wangColor; */ /* TODO: Wang sets. Low priority. */
     TmxLayer* layer;
     TmxTileLayer* tileLayer;
+    TmxChunk* chunk;
     TmxObjectGroup* objectGroup;
     TmxImageLayer* imageLayer;
     TmxObject* object;
 
-    /* These variables are linked lists containing various elements where an arbitrary amount are allowed, such as */
-    /* 1+ <object> elements in an <objectgroup>, that will be copied to arrays of known sizes later on */
-    RaytmxPropertyNode *propertiesRoot, *propertiesTail;
-    RaytmxTilesetNode *tilesetsRoot, *tilesetsTail;
-    RaytmxTilesetTileNode *tilesetTilesRoot, *tilesetTilesTail;
-    RaytmxAnimationFrameNode *animationFramesRoot, *animationFramesTail;
-    RaytmxLayerNode *layersRoot, *layersTail, *groupNode;
-    RaytmxTileLayerTileNode *layerTilesRoot, *layerTilesTail;
-    RaytmxObjectNode *objectsRoot, *objectsTail;
-    uint32_t tilesetsLength, tilesetTilesLength, animationFramesLength, propertiesLength, layersLength,
-        layerTilesLength, objectsLength, propertiesDepth;
+    /* These variables are growable buffers, in the scratch arena, containing various elements where an arbitrary */
+    /* amount are allowed, such as 1+ <object> elements in an <objectgroup>, that will be copied to arrays of known */
+    /* sizes later on. Appending may move a buffer's elements so pointers into one, like 'object' above, are only */
+    /* held while nothing else is appended to the same buffer. */
+    RaytmxBuffer properties; /* TmxProperty */
+    RaytmxBuffer tilesets; /* TmxTileset */
+    RaytmxBuffer tilesetTiles; /* TmxTilesetTile */
+    RaytmxBuffer animationFrames; /* TmxAnimationFrame */
+    RaytmxBuffer layers; /* RaytmxLayerNode */
+    RaytmxBuffer layerTiles; /* uint32_t */
+    RaytmxBuffer layerChunks; /* TmxChunk */
+    RaytmxBuffer objects; /* TmxObject */
+    RaytmxLayerNode* groupNode;
+    uint32_t propertiesDepth;
 } RaytmxState; /* Intermediate data used internally to parse TMX (map), TSX (tileset), and TX (template) files */
 
-RaytmxExternalTileset LoadTSX(const char* fileName);
-RaytmxObjectTemplate LoadTX(const char* fileName);
+RaytmxExternalTileset LoadTSX(RaytmxState* parentState, const char* fileName);
+RaytmxObjectTemplate LoadTX(RaytmxState* parentState, const char* fileName);
+void InitChildState(RaytmxState* raytmxState, const RaytmxState* parentState, RaytmxDocumentFormat format);
+void ReturnChildState(const RaytmxState* raytmxState, RaytmxState* parentState);
 void ParseDocument(RaytmxState* raytmxState, const char* fileName);
 void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
 void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
 void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
-void FreeState(RaytmxState* raytmxState);
-void FreeString(char* str);
-void FreeTileset(TmxTileset tileset);
-void FreeProperty(TmxProperty property);
-void FreeLayer(TmxLayer layer);
-void FreeObject(TmxObject object);
+RaytmxArena* CreateArena(size_t blockSize);
+void DestroyArena(RaytmxArena* arena);
+void* ArenaAllocZero(RaytmxArena* arena, size_t size);
+void* ArenaResize(RaytmxArena* arena, void* buffer, size_t size, size_t newSize);
+char* ArenaStringCopy(RaytmxArena* arena, const char* source);
+void* BufferAppend(RaytmxArena* arena, RaytmxBuffer* buffer, uint32_t count, size_t elementSize);
+void* BufferCopy(RaytmxArena* arena, const RaytmxBuffer* buffer, size_t elementSize);
 bool IterateTileLayer(const TmxMap* map, const TmxTileLayer* layer, Rectangle screenRect, uint32_t* rawGid,
     TmxTile* tile, Rectangle* tileRect);
-void DrawTMXTileLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint);
-void DrawTMXLayerTile(const TmxMap* map, Rectangle screenRect, uint32_t rawGid, int posX, int posY, Color tint);
+bool IterateChunkedTileLayer(const TmxMap* map, const TmxTileLayer* layer, Rectangle screenRect, uint32_t* rawGid,
+    TmxTile* tile, Rectangle* tileRect);
+void UpdateLayerChunks(TmxMap* map, TmxLayer* layers, uint32_t layersLength, Rectangle area);
+TmxChunk* FindLeastRecentChunk(TmxLayer* layers, uint32_t layersLength, uint32_t clock, TmxChunk* oldest);
+void UnloadChunks(TmxLayer* layers, uint32_t layersLength);
+Rectangle GetScreenRect(const Camera2D* camera);
+const char* ParseWorldMap(const char* cursor, RaytmxArena* arena, const char* documentDirectory,
+    TmxWorldMap* worldMap);
+bool CheckCollisionWorldObjectGroupsRec(const TmxLayer* layers, uint32_t layersLength, Rectangle rec,
+    TmxObject* outputObject);
+const char* SkipJsonWhitespace(const char* cursor);
+const char* ParseJsonString(const char* cursor, char* output, size_t outputLength);
+const char* SkipJsonValue(const char* cursor);
+void DrawTMXTileLayer(const TmxMap* map, Rectangle screenRect, const TmxLayer* layer, int posX, int posY,
+    Color tint);
+void DrawTMXTileLayerGpu(const TmxMap* map, Rectangle screenRect, const TmxLayer* layer, int posX, int posY,
+    Color tint);
+uint32_t CountTileLayers(const TmxLayer* layers, uint32_t layersLength);
+void LoadGidsTextures(TmxMap* map, const uint32_t* gidAtlases, TmxLayer* layers, uint32_t layersLength);
+uint32_t GetGidAtlas(const TmxMap* map, uint32_t gid);
+void BuildTileDraws(TmxMap* map);
+void DrawTMXLayerTile(const TmxMap* map, uint32_t rawGid, int posX, int posY, Color tint);
 void DrawTMXObjectTile(const TmxMap* map, Rectangle screenRect, uint32_t rawGid, int posX, int posY, float width,
     float height, Color tint);
-void DrawTMXObjectGroup(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint);
-void DrawTMXImageLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint);
+void DrawTMXObjectGroup(const TmxMap* map, Rectangle screenRect, const TmxLayer* layer, int posX, int posY,
+    Color tint);
+void DrawTMXImageLayer(const TmxMap* map, Rectangle screenRect, const TmxLayer* layer, int posX, int posY,
+    Color tint);
 bool CheckCollisionTMXTileLayerObject(const TmxMap* map, const TmxLayer* layers, uint32_t layersLength,
     TmxObject object, TmxObject* outputObject);
 bool CheckCollisionTMXObjectGroupObject(TmxObjectGroup group, TmxObject object, TmxObject* outputObject);
+TmxObject TranslateObject(TmxObject object, float dx, float dy);
 void TraceLogTMXTilesets(int logLevel, TmxOrientation orientation, TmxTileset* tilesets, uint32_t tilesetsLength,
     int numSpaces);
 void TraceLogTMXProperties(int logLevel, TmxProperty* properties, uint32_t propertiesLength, int numSpaces);
@@ -853,18 +1119,25 @@ void TraceLogTMXObject(int logLevel, TmxObject object, int numSpaces);
 void StringCopy(char* destination, const char* source);
 TmxProperty* AddProperty(RaytmxState* raytmxState);
 void AddTileLayerTile(RaytmxState* raytmxState, uint32_t gid);
+void AddTileLayerTiles(RaytmxState* raytmxState, const unsigned char* gids, uint32_t count);
+TmxChunk* AddChunk(RaytmxState* raytmxState);
+uint32_t* DecodeTileData(const char* content, const char* encoding, const char* compression, const char* layerName,
+    uint32_t* gidsLength);
 TmxTileset* AddTileset(RaytmxState* raytmxState);
 TmxTilesetTile* AddTilesetTile(RaytmxState* raytmxState);
 TmxAnimationFrame* AddAnimationFrame(RaytmxState* raytmxState);
 TmxLayer* AddGenericLayer(RaytmxState* raytmxState, bool isGroup);
 TmxObject* AddObject(RaytmxState* raytmxState);
-void AppendLayerTo(TmxMap* map, RaytmxLayerNode* groupNode, RaytmxLayerNode* layersRoot, uint32_t layersLength);
+void AppendLayerTo(TmxMap* map, TmxLayer* groupLayer, const RaytmxBuffer* layerNodes);
+int CompareObjectSortingEntries(const void* a, const void* b);
+void BucketObjectGroup(RaytmxArena* arena, TmxObjectGroup* group);
+uint32_t LowestSetBit(uint64_t bits);
 RaytmxCachedTextureNode* LoadCachedTexture(RaytmxState* raytmxState, const char* fileName);
+void CollectCachedTextures(const RaytmxState* raytmxState, TmxMap* map);
 RaytmxCachedTemplateNode* LoadCachedTemplate(RaytmxState* raytmxState, const char* fileName);
 Color GetColorFromHexString(const char* hex);
 uint32_t GetGid(uint32_t rawGid, bool* isFlippedHorizontally, bool* isFlippedVertically, bool* isFlippedDiagonally,
     bool* isRotatedHexagonal120);
-void* MemAllocZero(unsigned int size);
 char* GetDirectoryPath2(const char* filePath);
 char* JoinPath(const char* prefix, const char* suffix);
 void StringCopyN(char* destination, const char* source, size_t number);
@@ -874,24 +1147,36 @@ void StringConcatenate(char* destination, const char* source);
 /* Public implementation.                                                                                             */
 
 RAYTMX_DEC TmxMap* LoadTMX(const char* fileName) {
+    RAYTMX_TRACE_BEGIN("LoadTMX");
     RaytmxState raytmxState[1];
     memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
     raytmxState->format = FORMAT_TMX;
 
-    /* Initialize the map object */
-    TmxMap* map = (TmxMap*)MemAllocZero(sizeof(TmxMap));
+    /* The size of the document is a decent estimate of the size of its model, and of the intermediate data needed */
+    /* to build it, so the arenas start there and rarely need more than a couple of additional blocks */
+    int fileLength = GetFileLength(fileName);
+    size_t blockSize = fileLength > RAYTMX_ARENA_BLOCK_SIZE ? (size_t)fileLength : RAYTMX_ARENA_BLOCK_SIZE;
+    raytmxState->arena = CreateArena(blockSize);
+    raytmxState->scratch = CreateArena(blockSize);
+
+    /* Initialize the map object. It's allocated from, and owns, the arena that will hold the rest of the model. */
+    TmxMap* map = (TmxMap*)ArenaAllocZero(raytmxState->arena, sizeof(TmxMap));
+    map->arena = raytmxState->arena;
 
     /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
     /* equivalent TMX, TSX, and/or TX elements. */
     ParseDocument(raytmxState, fileName);
+    /* Hand the textures that were loaded to the map, even on failure, so UnloadTMX() can unload them */
+    CollectCachedTextures(raytmxState, map);
     if (!raytmxState->isSuccess) {
+        DestroyArena(raytmxState->scratch);
         UnloadTMX(map);
+        RAYTMX_TRACE_END();
         return NULL;
     }
 
     /* Copy some top-level map properties */
-    map->fileName = (char*)MemAllocZero((unsigned int)strlen(fileName) + 1);
-    StringCopy(map->fileName, GetFileName(fileName));
+    map->fileName = ArenaStringCopy(map->arena, GetFileName(fileName));
     map->orientation = raytmxState->mapOrientation;
     map->renderOrder = raytmxState->mapRenderOrder;
     map->width = raytmxState->mapWidth;
@@ -902,84 +1187,87 @@ RAYTMX_DEC TmxMap* LoadTMX(const char* fileName) {
     map->parallaxOriginX = raytmxState->mapParallaxOriginX;
     map->parallaxOriginY = raytmxState->mapParallaxOriginY;
     map->hasBackgroundColor = raytmxState->mapHasBackgroundColor;
+    map->infinite = raytmxState->mapInfinite;
+    map->chunkBudget = RAYTMX_DEFAULT_CHUNK_BUDGET;
 
     uint32_t gidsToTilesLength = 0; /* Can also be seen as the last GID */
-    if (raytmxState->tilesetsRoot != NULL) { /* If there is at least one tileset */
-        /* Allocate the array of tilesets and zeroize every index */
-        TmxTileset* tilesets = (TmxTileset*)MemAllocZero(sizeof(TmxTileset) * raytmxState->tilesetsLength);
-        /* Copy the TmxTileset pointers into the array */
-        RaytmxTilesetNode* tilesetIterator = raytmxState->tilesetsRoot;
-        for (uint32_t i = 0; tilesetIterator != NULL; i++) {
-            TmxTileset tileset = tilesetIterator->tileset;
-            if (tileset.hasImage) /* If the tileset has a shared image and implicitly defines tiles */
-                tileset.lastGid = tileset.firstGid + tileset.tileCount - 1;
-            else if (tileset.tilesLength > 0) /* If the tileset is a "collection of images" with explicit tiles */
-                tileset.lastGid = tileset.firstGid + tileset.tiles[tileset.tilesLength - 1].id - 1;
-
-            if (gidsToTilesLength < tileset.lastGid + 1)
-                gidsToTilesLength = tileset.lastGid + 1; /* GIDs start at 1 so the length is the last GID + 1 */
-            tilesets[i] = tileset;
-            tilesetIterator = tilesetIterator->next;
+    if (raytmxState->tilesets.length > 0) { /* If there is at least one tileset */
+        /* Copy the TmxTilesets into an array of the exact size */
+        TmxTileset* tilesets = (TmxTileset*)BufferCopy(map->arena, &raytmxState->tilesets, sizeof(TmxTileset));
+        for (uint32_t i = 0; i < raytmxState->tilesets.length; i++) {
+            TmxTileset* tileset = &tilesets[i];
+            if (tileset->hasImage) /* If the tileset has a shared image and implicitly defines tiles */
+                tileset->lastGid = tileset->firstGid + tileset->tileCount - 1;
+            else if (tileset->tilesLength > 0) /* If the tileset is a "collection of images" with explicit tiles */
+                tileset->lastGid = tileset->firstGid + tileset->tiles[tileset->tilesLength - 1].id - 1;
+
+            if (gidsToTilesLength < tileset->lastGid + 1)
+                gidsToTilesLength = tileset->lastGid + 1; /* GIDs start at 1 so the length is the last GID + 1 */
         }
         /* Add the tilesets array to the map */
         map->tilesets = tilesets;
-        map->tilesetsLength = raytmxState->tilesetsLength;
+        map->tilesetsLength = raytmxState->tilesets.length;
     } else
         TraceLog(LOG_WARNING, "RAYTMX: The map does not contain any tilesets");
 
-    if (raytmxState->layersRoot != NULL) { /* If there is at least one layer within the map */
+    if (raytmxState->layers.length > 0) { /* If there is at least one layer within the map */
         /* Due to the existence of <group> layers, layers can have children of multiple generations. To form the */
         /* resulting tree-like structure, recursion is used. */
-        AppendLayerTo(map, NULL, raytmxState->layersRoot, raytmxState->layersLength);
+        AppendLayerTo(map, NULL, &raytmxState->layers);
     } else
         TraceLog(LOG_WARNING, "RAYTMX: The map does not contain any layers");
 
     if (gidsToTilesLength > 0) {
-        TmxTile* gidsToTiles = (TmxTile*)MemAllocZero(sizeof(TmxTile) * gidsToTilesLength);
+        TmxTile* gidsToTiles = (TmxTile*)ArenaAllocZero(map->arena, sizeof(TmxTile) * gidsToTilesLength);
 
         for (uint32_t i = 0; i < map->tilesetsLength; i++) {
             TmxTileset* tileset = &map->tilesets[i];
             if (tileset->hasImage) { /* If the tileset has a shared image (i.e. not a "collection of images") */
+                /* Whereas most tiles in a tile layer are implicit, some may have information given directly, like */
+                /* animation frames or sub-rectangle values, as well as less relevant information. Index the explicit */
+                /* tileset tiles by local ID so each implicit tile can find its explicit counterpart, if any, */
+                /* without searching. Entries are index + 1 so zero means there is no explicit tile. */
+                uint32_t* explicitTiles = (uint32_t*)ArenaAllocZero(raytmxState->scratch,
+                    sizeof(uint32_t) * tileset->tileCount);
+                for (uint32_t j = 0; j < tileset->tilesLength; j++) {
+                    uint32_t id = tileset->tiles[j].id;
+                    if (id < tileset->tileCount && explicitTiles[id] == 0) /* The first tile with an ID is used */
+                        explicitTiles[id] = j + 1;
+                }
+
                 for (uint32_t id = 0; id < tileset->tileCount; id++) {
                     uint32_t gid = id + tileset->firstGid, x = id % tileset->columns, y = id/ tileset->columns;
                     bool hasExplicitSourceRect = false;
                     gidsToTiles[gid].gid = gid;
 
-                    /* Search through the explicit tileset tiles for one with a matching local ID. Whereas most */
-                    /* tiles in a tile layer are implicit, some may have information given directly, like */
-                    /* animation frames or sub-rectangle values, as well as less relevant information. */
-                    for (uint32_t j = 0; j < tileset->tilesLength; j++) {
-                        TmxTilesetTile tilesetTile = tileset->tiles[j];
-                        if (tilesetTile.id == id) { /* If this tileset tile has explicitly-defined information */
-                            /* Typical tiles are implicit since everything that must be known about them can be */
-                            /* inferred from knowing the dimensions the tileset's image, dimensions of tiles, and */
-                            /* the (right-down) order of tiles within the tilest's image. However, tiles can have */
-                            /* additional, non-inferable information. This is particularly true for animations. */
-                            if (tilesetTile.hasAnimation) { /* If the tile is meta, pointing to other tiles */
-                                gidsToTiles[gid].hasAnimation = true;
-                                gidsToTiles[gid].animation = tilesetTile.animation;
-                                /* 'gid' is slightly repurposed for animations in that it's assigned with the */
-                                /* tileset's first GID rather than the tiles'. This is done because frames use */
-                                /* local IDs and the tileset's first GID is needed to get the frame's GID. */
-                                gidsToTiles[gid].gid = tileset->firstGid;
-                            } else if (tilesetTile.x != 0 || tilesetTile.y != 0 || tilesetTile.width != 0 ||
-                                    tilesetTile.height != 0) {
-                                /* This tile directly tells us the area within the tileset's image to use when */
-                                /* drawing, overriding the implicit dimensions derived from the map's 'tilewidth' */
-                                /* and 'tileheight' attributes. */
-                                hasExplicitSourceRect = true;
-                                gidsToTiles[gid].sourceRect.x = (float)tilesetTile.x;
-                                gidsToTiles[gid].sourceRect.y = (float)tilesetTile.y;
-                                gidsToTiles[gid].sourceRect.width = (float)tilesetTile.width;
-                                gidsToTiles[gid].sourceRect.height = (float)tilesetTile.height;
-                            }
-
-                            /* Tiles may have child object groups. These objects are a form of collision information. */
-                            /* The object group may be empty or may have objects. A simple assignment covers both. */
-                            gidsToTiles[gid].objectGroup = tilesetTile.objectGroup;
-
-                            break; /* The tile was found - no need to check the rest */
+                    if (explicitTiles[id] != 0) { /* If this tile has a tileset tile with explicitly-defined info */
+                        TmxTilesetTile tilesetTile = tileset->tiles[explicitTiles[id] - 1];
+                        /* Typical tiles are implicit since everything that must be known about them can be */
+                        /* inferred from knowing the dimensions the tileset's image, dimensions of tiles, and */
+                        /* the (right-down) order of tiles within the tilest's image. However, tiles can have */
+                        /* additional, non-inferable information. This is particularly true for animations. */
+                        if (tilesetTile.hasAnimation) { /* If the tile is meta, pointing to other tiles */
+                            gidsToTiles[gid].hasAnimation = true;
+                            gidsToTiles[gid].animation = tilesetTile.animation;
+                            /* 'gid' is slightly repurposed for animations in that it's assigned with the */
+                            /* tileset's first GID rather than the tiles'. This is done because frames use */
+                            /* local IDs and the tileset's first GID is needed to get the frame's GID. */
+                            gidsToTiles[gid].gid = tileset->firstGid;
+                        } else if (tilesetTile.x != 0 || tilesetTile.y != 0 || tilesetTile.width != 0 ||
+                                tilesetTile.height != 0) {
+                            /* This tile directly tells us the area within the tileset's image to use when */
+                            /* drawing, overriding the implicit dimensions derived from the map's 'tilewidth' */
+                            /* and 'tileheight' attributes. */
+                            hasExplicitSourceRect = true;
+                            gidsToTiles[gid].sourceRect.x = (float)tilesetTile.x;
+                            gidsToTiles[gid].sourceRect.y = (float)tilesetTile.y;
+                            gidsToTiles[gid].sourceRect.width = (float)tilesetTile.width;
+                            gidsToTiles[gid].sourceRect.height = (float)tilesetTile.height;
                         }
+
+                        /* Tiles may have child object groups. These objects are a form of collision information. */
+                        /* The object group may be empty or may have objects. A simple assignment covers both. */
+                        gidsToTiles[gid].objectGroup = tilesetTile.objectGroup;
                     }
 
                     if (!gidsToTiles[gid].hasAnimation) { /* If the tile is of the typical, static variety */
@@ -1025,11 +1313,13 @@ RAYTMX_DEC TmxMap* LoadTMX(const char* fileName) {
 
         map->gidsToTiles = gidsToTiles;
         map->gidsToTilesLength = gidsToTilesLength;
+        BuildTileDraws(map);
     } /* gidsToTilesLength > 0 */
 
-    /* Free the linked lists and zeroize related values */
-    FreeState(raytmxState);
+    /* Release the linked lists, caches, and other intermediate data all at once */
+    DestroyArena(raytmxState->scratch);
 
+    RAYTMX_TRACE_END();
     return map;
 }
 
@@ -1037,31 +1327,28 @@ RAYTMX_DEC void UnloadTMX(TmxMap* map) {
     if (map == NULL)
         return;
 
-    if (map->fileName != NULL)
-        MemFree(map->fileName);
-
-    if (map->properties != NULL) {
-        for (uint32_t i = 0; i < map->propertiesLength; i++)
-            FreeProperty(map->properties[i]);
-        MemFree(map->properties);
-    }
-
-    if (map->tilesets != NULL) {
-        for (uint32_t i = 0; i < map->tilesetsLength; i++)
-            FreeTileset(map->tilesets[i]);
-        MemFree(map->tilesets);
+    /* Textures live in VRAM, not the arena, so they're the only resources that must be released one by one. Each */
+    /* texture appears in this array once no matter how many tilesets, tiles, or image layers share it. */
+    for (uint32_t i = 0; i < map->texturesLength; i++)
+        UnloadTexture(map->textures[i]);
+    if (map->gpuRenderer != NULL) { /* If the map was prepared for GPU rendering */
+        UnloadShader(map->gpuRenderer->shader);
+        UnloadTexture(map->gpuRenderer->tileTable);
+        for (uint32_t i = 0; i < map->gpuRenderer->gidsTexturesLength; i++)
+            UnloadTexture(map->gpuRenderer->gidsTextures[i]);
     }
+    /* Decoded chunks come and go while the map is in use so they're allocated individually, outside the arena */
+    UnloadChunks(map->layers, map->layersLength);
 
-    if (map->layers != NULL) {
-        for (uint32_t i = 0; i < map->layersLength; i++)
-            FreeLayer(map->layers[i]);
-        MemFree(map->layers);
-    }
+    /* Every other allocation, including the map itself, belongs to the arena */
+    DestroyArena(map->arena);
+}
 
-    if (map->gidsToTiles != NULL)
-        MemFree(map->gidsToTiles);
+static int tmxViewportWidth = 0, tmxViewportHeight = 0; /* Zero when culling to the whole framebuffer */
 
-    MemFree(map);
+RAYTMX_DEC void SetViewportTMX(int width, int height) {
+    tmxViewportWidth = width;
+    tmxViewportHeight = height;
 }
 
 RAYTMX_DEC void DrawTMX(const TmxMap* map, const Camera2D* camera, int posX, int posY, Color tint) {
@@ -1081,61 +1368,58 @@ RAYTMX_DEC void DrawTMXLayers(const TmxMap* map, const Camera2D* camera, const T
     if (map == NULL || layers == NULL || layersLength == 0)
         return;
 
+    RAYTMX_TRACE_BEGIN("DrawTMXLayers");
     for (uint32_t i = 0; i < layersLength; i++) {
-        TmxLayer layer = layers[i];
-        if (!layers[i].visible) /* If the layer is not visible */
+        const TmxLayer* layer = &layers[i]; /* A pointer avoids copying the layer, which is fairly large */
+        if (!layer->visible) /* If the layer is not visible */
             continue; /* Skip it - it's literally invisible */
 
         /* All types of layers can have a couple attributes that affect color: 'opacity' and 'tintcolor' */
         Color layerTint = tint;
-        layerTint.a = (unsigned char)((double)layerTint.a * layer.opacity);
-        if (layer.hasTintColor)
-            layerTint = ColorTint(layerTint, layer.tintColor);
+        layerTint.a = (unsigned char)((double)layerTint.a * layer->opacity);
+        if (layer->hasTintColor)
+            layerTint = ColorTint(layerTint, layer->tintColor);
 
-        Rectangle screenRect;
-        if (camera != NULL) {
-            screenRect.width = GetScreenWidth() / camera->zoom;
-            screenRect.height = GetScreenHeight() / camera->zoom;
-            screenRect.x = camera->target.x - (screenRect.width / 2.0f);
-            screenRect.y = camera->target.y - (screenRect.height / 2.0f);
-        } else {
-            screenRect.x = 0.0f;
-            screenRect.y = 0.0f;
-            screenRect.width = (float)GetScreenWidth();
-            screenRect.height = (float)GetScreenHeight();
-        }
+        Rectangle screenRect = GetScreenRect(camera);
 
         int32_t parallaxOffsetX = 0, parallaxOffsetY = 0;
         if (camera != NULL) {
-            parallaxOffsetX = (int32_t)((double)(camera->target.x - map->parallaxOriginX) * (layer.parallaxX - 1.0));
-            parallaxOffsetY = (int32_t)((double)(camera->target.y - map->parallaxOriginY) * (layer.parallaxY - 1.0));
+            parallaxOffsetX = (int32_t)((double)(camera->target.x - map->parallaxOriginX) * (layer->parallaxX - 1.0));
+            parallaxOffsetY = (int32_t)((double)(camera->target.y - map->parallaxOriginY) * (layer->parallaxY - 1.0));
         }
 
-        switch (layer.type) {
+        switch (layer->type) {
         case LAYER_TYPE_TILE_LAYER:
-            DrawTMXTileLayer(map, screenRect, layer, posX + layer.offsetX + parallaxOffsetX,
-                posY + layer.offsetY + parallaxOffsetY, layerTint);
+            if (map->gpuRenderer != NULL && layer->exact.tileLayer.gidsTexture.id != 0) { /* If drawable by the GPU */
+                DrawTMXTileLayerGpu(map, screenRect, layer, posX + layer->offsetX + parallaxOffsetX,
+                    posY + layer->offsetY + parallaxOffsetY, layerTint);
+            } else {
+                DrawTMXTileLayer(map, screenRect, layer, posX + layer->offsetX + parallaxOffsetX,
+                    posY + layer->offsetY + parallaxOffsetY, layerTint);
+            }
             break;
         case LAYER_TYPE_OBJECT_GROUP:
-            DrawTMXObjectGroup(map, screenRect, layer, posX + layer.offsetX + parallaxOffsetX,
-                posY + layer.offsetY + parallaxOffsetY, layerTint);
+            DrawTMXObjectGroup(map, screenRect, layer, posX + layer->offsetX + parallaxOffsetX,
+                posY + layer->offsetY + parallaxOffsetY, layerTint);
             break;
         case LAYER_TYPE_IMAGE_LAYER:
-            DrawTMXImageLayer(map, screenRect, layer, posX + layer.offsetX + parallaxOffsetX,
-                posY + layer.offsetY + parallaxOffsetY, layerTint);
+            DrawTMXImageLayer(map, screenRect, layer, posX + layer->offsetX + parallaxOffsetX,
+                posY + layer->offsetY + parallaxOffsetY, layerTint);
         break;
         case LAYER_TYPE_GROUP:
-            DrawTMXLayers(map, camera, layer.layers, layer.layersLength, posX + layer.offsetX + parallaxOffsetX,
-                posY + layer.offsetY + parallaxOffsetY, layerTint);
+            DrawTMXLayers(map, camera, layer->layers, layer->layersLength, posX + layer->offsetX + parallaxOffsetX,
+                posY + layer->offsetY + parallaxOffsetY, layerTint);
             break;
         }
     }
+    RAYTMX_TRACE_END();
 }
 
 RAYTMX_DEC void AnimateTMX(TmxMap* map) {
     if (map == NULL)
         return;
 
+    RAYTMX_TRACE_BEGIN("AnimateTMX");
     float dt = GetFrameTime(); /* Returns the duration, in seconds, of the last frame drawn */
     /* Iterate through the tiles, searching for those that are animations */
     for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++) {
@@ -1150,9 +1434,397 @@ RAYTMX_DEC void AnimateTMX(TmxMap* map) {
                 /* ...unless the last frame was "last" in both senses */
                 if (tile->frameIndex == tile->animation.framesLength)
                     tile->frameIndex = 0; /* Wrap around to the first frame */
+                /* Point the tile's draw record at the new frame, if the frame can be drawn */
+                uint32_t frameGid = tile->gid + tile->animation.frames[tile->frameIndex].id;
+                map->gidsToDraws[gid].animationGid = frameGid < map->gidsToTilesLength ? frameGid : 0;
+            }
+        }
+    }
+    RAYTMX_TRACE_END();
+}
+
+RAYTMX_DEC void UpdateChunksTMX(TmxMap* map, Rectangle area) {
+    if (map == NULL || !map->infinite)
+        return;
+
+    /* Decode ahead by half of the area in every direction so chunks are ready before they come into view */
+    area.x -= area.width / 2.0f;
+    area.y -= area.height / 2.0f;
+    area.width *= 2.0f;
+    area.height *= 2.0f;
+
+    map->chunkClock += 1;
+    UpdateLayerChunks(map, map->layers, map->layersLength, area);
+
+    /* Evict the least recently needed chunks until the decoded tiles fit in the budget. Chunks needed right now */
+    /* are never evicted even if they alone exceed the budget. */
+    while (map->chunkBytes > map->chunkBudget) {
+        TmxChunk* oldest = FindLeastRecentChunk(map->layers, map->layersLength, map->chunkClock, NULL);
+        if (oldest == NULL)
+            break;
+        map->chunkBytes -= sizeof(uint32_t) * oldest->width * oldest->height;
+        MemFree(oldest->tiles);
+        oldest->tiles = NULL;
+    }
+}
+
+RAYTMX_DEC TmxWorld* LoadWorldTMX(const char* fileName) {
+    char* content = LoadFileText(fileName);
+    if (content == NULL) {
+        TraceLog(LOG_ERROR, "RAYTMX: Failed to open \"%s\"", fileName);
+        return NULL;
+    }
+
+    RaytmxArena* arena = CreateArena(RAYTMX_ARENA_BLOCK_SIZE);
+    TmxWorld* world = (TmxWorld*)ArenaAllocZero(arena, sizeof(TmxWorld));
+    world->arena = arena;
+    world->fileName = ArenaStringCopy(arena, fileName);
+    char documentDirectory[260];
+    StringCopy(documentDirectory, GetDirectoryPath2(fileName));
+
+    /* A .world file is a small JSON object. Only its "maps" array matters here so the other members are skipped. */
+    RaytmxBuffer maps;
+    memset(&maps, 0, sizeof(RaytmxBuffer));
+    char key[32];
+    const char* cursor = SkipJsonWhitespace(content);
+    if (*cursor == '{')
+        cursor = SkipJsonWhitespace(cursor + 1);
+    else
+        cursor = NULL;
+    while (cursor != NULL && *cursor == '"') {
+        cursor = ParseJsonString(cursor, key, sizeof(key));
+        if (cursor == NULL || *(cursor = SkipJsonWhitespace(cursor)) != ':') {
+            cursor = NULL;
+            break;
+        }
+        cursor = SkipJsonWhitespace(cursor + 1);
+
+        if (strcmp(key, "maps") == 0 && *cursor == '[') {
+            cursor = SkipJsonWhitespace(cursor + 1);
+            while (cursor != NULL && *cursor == '{') {
+                TmxWorldMap* worldMap = (TmxWorldMap*)BufferAppend(arena, &maps, 1, sizeof(TmxWorldMap));
+                cursor = ParseWorldMap(cursor, arena, documentDirectory, worldMap);
+                if (cursor != NULL && *(cursor = SkipJsonWhitespace(cursor)) == ',')
+                    cursor = SkipJsonWhitespace(cursor + 1);
+            }
+            if (cursor != NULL && *cursor == ']')
+                cursor += 1;
+            else
+                cursor = NULL;
+        } else {
+            if (strcmp(key, "patterns") == 0)
+                TraceLog(LOG_WARNING, "RAYTMX: World \"%s\" uses patterns, which are not supported", fileName);
+            cursor = SkipJsonValue(cursor);
+        }
+
+        if (cursor != NULL && *(cursor = SkipJsonWhitespace(cursor)) == ',')
+            cursor = SkipJsonWhitespace(cursor + 1);
+    }
+    UnloadFileText(content);
+
+    if (cursor == NULL || *cursor != '}') {
+        TraceLog(LOG_ERROR, "RAYTMX: Unable to parse world \"%s\"", fileName);
+        DestroyArena(arena);
+        return NULL;
+    }
+
+    world->maps = (TmxWorldMap*)maps.data;
+    world->mapsLength = maps.length;
+    return world;
+}
+
+RAYTMX_DEC void UnloadWorldTMX(TmxWorld* world) {
+    if (world == NULL)
+        return;
+
+    UnloadWorldMapsTMX(world);
+    /* Every other allocation, including the world itself, belongs to the arena */
+    DestroyArena(world->arena);
+}
+
+RAYTMX_DEC void UnloadWorldMapsTMX(TmxWorld* world) {
+    if (world == NULL)
+        return;
+
+    for (uint32_t i = 0; i < world->mapsLength; i++) {
+        UnloadTMX(world->maps[i].map);
+        world->maps[i].map = NULL;
+    }
+}
+
+RAYTMX_DEC void UpdateWorldTMX(TmxWorld* world, Rectangle area) {
+    if (world == NULL)
+        return;
+
+    /* Maps within one area's size of the area are loaded ahead of time while maps are only unloaded once they're */
+    /* twice that far. The gap between the two keeps a map near the edge from being loaded and unloaded repeatedly. */
+    Rectangle loadArea = { area.x - area.width, area.y - area.height, area.width * 3.0f, area.height * 3.0f };
+    Rectangle keepArea = { area.x - (area.width * 2.0f), area.y - (area.height * 2.0f), area.width * 5.0f,
+        area.height * 5.0f };
+    Vector2 areaCenter = { area.x + (area.width / 2.0f), area.y + (area.height / 2.0f) };
+
+    TmxWorldMap* nearest = NULL;
+    float nearestDistance = 0.0f;
+    for (uint32_t i = 0; i < world->mapsLength; i++) {
+        TmxWorldMap* worldMap = &world->maps[i];
+        Rectangle bounds = { (float)worldMap->x, (float)worldMap->y, (float)worldMap->width,
+            (float)worldMap->height };
+
+        if (worldMap->map != NULL) { /* If the map is loaded */
+            if (!CheckCollisionRecs(bounds, keepArea)) { /* If the map has moved well away from the area */
+                UnloadTMX(worldMap->map);
+                worldMap->map = NULL;
+            }
+            continue;
+        }
+        if (worldMap->isLoadFailed || !CheckCollisionRecs(bounds, loadArea))
+            continue;
+
+        if (CheckCollisionRecs(bounds, area)) { /* If the map is in view, it can't wait */
+            nearest = worldMap;
+            break;
+        }
+        /* Otherwise, only the nearest of the maps that are close to coming into view is loaded by this call */
+        float dx = bounds.x + (bounds.width / 2.0f) - areaCenter.x;
+        float dy = bounds.y + (bounds.height / 2.0f) - areaCenter.y;
+        float distance = (dx * dx) + (dy * dy);
+        if (nearest == NULL || distance < nearestDistance) {
+            nearest = worldMap;
+            nearestDistance = distance;
+        }
+    }
+
+    /* Loading a map is by far the most expensive part of streaming so it's done once per call at most, spreading */
+    /* the cost of entering a new part of the world over several frames. Maps in view are the exception: they're */
+    /* all loaded right away so none of them are drawn late. */
+    while (nearest != NULL) {
+        nearest->map = LoadTMX(nearest->fileName);
+        if (nearest->map == NULL) {
+            nearest->isLoadFailed = true;
+            break;
+        }
+        if (world->useGpuRendering)
+            EnableGpuRenderingTMX(nearest->map);
+        if (nearest->width == 0 || nearest->height == 0) { /* If the .world file omitted the size */
+            nearest->width = nearest->map->width * nearest->map->tileWidth;
+            nearest->height = nearest->map->height * nearest->map->tileHeight;
+        }
+
+        TmxWorldMap* next = NULL;
+        for (uint32_t i = 0; i < world->mapsLength && next == NULL; i++) {
+            TmxWorldMap* worldMap = &world->maps[i];
+            Rectangle bounds = { (float)worldMap->x, (float)worldMap->y, (float)worldMap->width,
+                (float)worldMap->height };
+            if (worldMap->map == NULL && !worldMap->isLoadFailed && CheckCollisionRecs(bounds, area))
+                next = worldMap;
+        }
+        nearest = next;
+    }
+
+    for (uint32_t i = 0; i < world->mapsLength; i++) {
+        TmxWorldMap* worldMap = &world->maps[i];
+        if (worldMap->map == NULL)
+            continue;
+        Rectangle localArea = { area.x - worldMap->x, area.y - worldMap->y, area.width, area.height };
+        UpdateChunksTMX(worldMap->map, localArea);
+        AnimateTMX(worldMap->map);
+    }
+}
+
+RAYTMX_DEC void DrawWorldTMX(const TmxWorld* world, const Camera2D* camera, Color tint) {
+    if (world == NULL)
+        return;
+
+    Rectangle screenRect = GetScreenRect(camera);
+
+    for (uint32_t i = 0; i < world->mapsLength; i++) {
+        const TmxWorldMap* worldMap = &world->maps[i];
+        Rectangle bounds = { (float)worldMap->x, (float)worldMap->y, (float)worldMap->width,
+            (float)worldMap->height };
+        if (worldMap->map != NULL && (camera == NULL || CheckCollisionRecs(bounds, screenRect)))
+            DrawTMX(worldMap->map, camera, worldMap->x, worldMap->y, tint);
+    }
+}
+
+RAYTMX_DEC bool CheckCollisionWorldTMXRec(const TmxWorld* world, Rectangle rec, TmxObject* outputObject) {
+    if (world == NULL)
+        return false;
+
+    for (uint32_t i = 0; i < world->mapsLength; i++) {
+        const TmxWorldMap* worldMap = &world->maps[i];
+        Rectangle bounds = { (float)worldMap->x, (float)worldMap->y, (float)worldMap->width,
+            (float)worldMap->height };
+        if (worldMap->map == NULL || !CheckCollisionRecs(bounds, rec))
+            continue;
+
+        /* Maps know nothing of the world so the check is made in the map's own coordinates */
+        const TmxMap* map = worldMap->map;
+        Rectangle localRec = { rec.x - worldMap->x, rec.y - worldMap->y, rec.width, rec.height };
+        TmxObject object;
+        if (CheckCollisionTMXTileLayersRec(map, map->layers, map->layersLength, localRec, &object) ||
+                CheckCollisionWorldObjectGroupsRec(map->layers, map->layersLength, localRec, &object)) {
+            if (outputObject != NULL)
+                *outputObject = TranslateObject(object, (float)worldMap->x, (float)worldMap->y);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Fragment shader that draws a whole tile layer. The quad's texture coordinates are positions within the layer from */
+/* 0.0 to 1.0, from which the tile and the position within it are derived. */
+static const char* tmxTileLayerShaderCode =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n" /* The layer's atlas */
+    "uniform vec4 colDiffuse;\n"
+    "uniform sampler2D gids;\n" /* The layer's raw GIDs, one RGBA texel of four bytes per tile */
+    "uniform sampler2D tileTable;\n" /* See RaytmxGpuRenderer */
+    "uniform vec2 layerSize;\n" /* In tiles */
+    "uniform vec2 tileSize;\n" /* In pixels */
+    "uniform vec2 atlasSize;\n" /* In pixels */
+    "uniform float time;\n" /* In seconds, as are the frames' durations */
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    vec2 position = fragTexCoord * layerSize;\n"
+    "    ivec2 cell = ivec2(min(floor(position), layerSize - 1.0));\n"
+    "    uvec4 bytes = uvec4(texelFetch(gids, cell, 0) * 255.0 + 0.5);\n"
+    "    uint rawGid = bytes.r | (bytes.g << 8) | (bytes.b << 16) | (bytes.a << 24);\n"
+    "    int gid = int(rawGid & 0x0FFFFFFFu);\n" /* Remove the four flag bits */
+    "    if (gid == 0 || gid >= textureSize(tileTable, 0).x) discard;\n"
+    "    vec4 tile = texelFetch(tileTable, ivec2(gid, 0), 0);\n"
+    "    if (tile.x < 0.0) discard;\n"
+    "    vec2 source = tile.xy;\n"
+    "    if (tile.w > 0.0) {\n" /* If the tile is an animation, find the frame to draw at this time */
+    "        float frameTime = mod(time, texelFetch(tileTable, ivec2(int(tile.z), 1), 0).w);\n"
+    "        for (int i = 0; i < 64; i++) {\n" /* RAYTMX_GPU_MAX_FRAMES */
+    "            if (float(i) >= tile.w) break;\n"
+    "            vec4 frame = texelFetch(tileTable, ivec2(int(tile.z) + i, 1), 0);\n"
+    "            source = frame.xy;\n"
+    "            if (frameTime < frame.z) break;\n"
+    "            frameTime -= frame.z;\n"
+    "        }\n"
+    "    }\n"
+    /* Flips are applied to the tile in the order diagonal, horizontal, vertical so they're undone in reverse here */
+    "    vec2 uv = fract(position);\n"
+    "    if ((rawGid & 0x80000000u) != 0u) uv.x = 1.0 - uv.x;\n"
+    "    if ((rawGid & 0x40000000u) != 0u) uv.y = 1.0 - uv.y;\n"
+    "    if ((rawGid & 0x20000000u) != 0u) uv = uv.yx;\n"
+    "    finalColor = texture(texture0, (source + (uv * tileSize)) / atlasSize) * colDiffuse * fragColor;\n"
+    "}\n";
+
+RAYTMX_DEC bool EnableGpuRenderingTMX(TmxMap* map) {
+    if (map == NULL)
+        return false;
+    if (map->gpuRenderer != NULL) /* If this map was already prepared */
+        return true;
+
+    if (map->orientation != ORIENTATION_NONE && map->orientation != ORIENTATION_ORTHOGONAL) {
+        TraceLog(LOG_WARNING, "RAYTMX: GPU rendering is only supported for orthogonal maps");
+        return false;
+    }
+    if (rlGetVersion() != RL_OPENGL_33 && rlGetVersion() != RL_OPENGL_43) {
+        TraceLog(LOG_WARNING, "RAYTMX: GPU rendering requires OpenGL 3.3 or newer");
+        return false;
+    }
+    if (map->gidsToTilesLength == 0 || map->gidsToTilesLength > RAYTMX_GPU_MAX_TEXTURE_SIZE)
+        return false;
+
+    /* Determine, once per GID rather than once per tile, which texture each tile is drawn from and whether the */
+    /* shader can draw it at all */
+    uint32_t* gidAtlases = (uint32_t*)MemAlloc(sizeof(uint32_t) * map->gidsToTilesLength);
+    uint32_t framesLength = 0;
+    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++) {
+        gidAtlases[gid] = GetGidAtlas(map, gid);
+        if (gidAtlases[gid] != 0 && gidAtlases[gid] != UINT32_MAX && map->gidsToTiles[gid].hasAnimation)
+            framesLength += map->gidsToTiles[gid].animation.framesLength;
+    }
+    uint32_t tableWidth = map->gidsToTilesLength > framesLength ? map->gidsToTilesLength : framesLength;
+    if (tableWidth > RAYTMX_GPU_MAX_TEXTURE_SIZE) {
+        MemFree(gidAtlases);
+        return false;
+    }
+
+    RaytmxGpuRenderer* renderer = (RaytmxGpuRenderer*)ArenaAllocZero(map->arena, sizeof(RaytmxGpuRenderer));
+    renderer->shader = LoadShaderFromMemory(NULL, tmxTileLayerShaderCode);
+    if (renderer->shader.id == rlGetShaderIdDefault()) { /* If compilation failed and raylib fell back to its own */
+        TraceLog(LOG_WARNING, "RAYTMX: Unable to compile the tile layer shader");
+        MemFree(gidAtlases);
+        return false;
+    }
+
+    /* Upload each tile layer that the shader can draw. Every tile, with its flip flags, becomes a texel. */
+    renderer->gidsTextures = (Texture2D*)ArenaAllocZero(map->arena,
+        sizeof(Texture2D) * CountTileLayers(map->layers, map->layersLength));
+    map->gpuRenderer = renderer; /* Assigned early so LoadGidsTextures() can record the textures */
+    LoadGidsTextures(map, gidAtlases, map->layers, map->layersLength);
+    MemFree(gidAtlases);
+    if (renderer->gidsTexturesLength == 0) { /* If no layer can be drawn by the shader, there's no need for it */
+        UnloadShader(renderer->shader);
+        map->gpuRenderer = NULL; /* The renderer's memory is left to the arena */
+        return false;
+    }
+
+    /* Build the tile table. See RaytmxGpuRenderer for its layout. */
+    float* table = (float*)MemAlloc(sizeof(float) * 4 * tableWidth * 2);
+    memset(table, 0, sizeof(float) * 4 * tableWidth * 2);
+    uint32_t frameIndex = 0;
+    for (uint32_t gid = 0; gid < tableWidth; gid++) {
+        float* texel = &table[gid * 4];
+        texel[0] = -1.0f; /* Marks the GID as unknown until shown otherwise */
+        if (gid >= map->gidsToTilesLength || map->gidsToTiles[gid].gid == 0)
+            continue;
+        TmxTile tile = map->gidsToTiles[gid];
+        float totalDuration = 0.0f;
+        for (uint32_t i = 0; tile.hasAnimation && i < tile.animation.framesLength; i++)
+            totalDuration += tile.animation.frames[i].duration;
+        if (!tile.hasAnimation) {
+            texel[0] = tile.sourceRect.x;
+            texel[1] = tile.sourceRect.y;
+        } else if (totalDuration <= 0.0f) {
+            /* The shader takes the time modulo the total duration so an animation whose frames all last zero */
+            /* seconds is drawn as its first frame instead */
+            uint32_t frameGid = (tile.animation.framesLength > 0) ? tile.gid + tile.animation.frames[0].id : 0;
+            if (frameGid != 0 && frameGid < map->gidsToTilesLength && map->gidsToTiles[frameGid].gid != 0) {
+                texel[0] = map->gidsToTiles[frameGid].sourceRect.x;
+                texel[1] = map->gidsToTiles[frameGid].sourceRect.y;
+            }
+        } else if (GetGidAtlas(map, gid) != UINT32_MAX) { /* If the animation is drawable by the shader */
+            texel[0] = 0.0f; /* The source comes from the frames */
+            texel[2] = (float)frameIndex;
+            texel[3] = (float)tile.animation.framesLength;
+            for (uint32_t i = 0; i < tile.animation.framesLength; i++) {
+                TmxTile frameTile = map->gidsToTiles[tile.gid + tile.animation.frames[i].id];
+                float* frameTexel = &table[(tableWidth + frameIndex) * 4];
+                frameTexel[0] = frameTile.sourceRect.x;
+                frameTexel[1] = frameTile.sourceRect.y;
+                frameTexel[2] = tile.animation.frames[i].duration;
+                frameTexel[3] = totalDuration;
+                frameIndex += 1;
             }
         }
     }
+    Image tableImage;
+    tableImage.data = table;
+    tableImage.width = (int)tableWidth;
+    tableImage.height = 2;
+    tableImage.mipmaps = 1;
+    tableImage.format = PIXELFORMAT_UNCOMPRESSED_R32G32B32A32;
+    renderer->tileTable = LoadTextureFromImage(tableImage);
+    MemFree(table);
+
+    renderer->gidsLoc = GetShaderLocation(renderer->shader, "gids");
+    renderer->tileTableLoc = GetShaderLocation(renderer->shader, "tileTable");
+    renderer->layerSizeLoc = GetShaderLocation(renderer->shader, "layerSize");
+    renderer->tileSizeLoc = GetShaderLocation(renderer->shader, "tileSize");
+    renderer->atlasSizeLoc = GetShaderLocation(renderer->shader, "atlasSize");
+    renderer->timeLoc = GetShaderLocation(renderer->shader, "time");
+
+    TraceLog(LOG_INFO, "RAYTMX: %u tile layer(s) of map \"%s\" will be drawn by the GPU",
+        renderer->gidsTexturesLength, map->fileName);
+    return true;
 }
 
 /**
@@ -1321,7 +1993,45 @@ RAYTMX_DEC bool CheckCollisionTMXObjectGroupRec(TmxObjectGroup group, Rectangle
         return false; /* Early-out opportunity. These cases would always return false. */
 
     /* Check the rectangle against TMX objects in the group for collisions */
-    return CheckCollisionTMXObjectGroupObject(group, CreateRectangularTMXObject(rec), outputObject);
+    RAYTMX_TRACE_BEGIN("CheckCollisionTMXObjectGroupRec");
+    bool isCollision = CheckCollisionTMXObjectGroupObject(group, CreateRectangularTMXObject(rec), outputObject);
+    RAYTMX_TRACE_END();
+    return isCollision;
+}
+
+RAYTMX_DEC uint64_t CheckCollisionTMXBoxesRec(const TmxObjectGroup* group, uint32_t first, Rectangle rec) {
+    /* The same comparisons, of the same values, as CheckCollisionRecs(box, rec) */
+    const float* minX = group->boxMinX + first;
+    const float* minY = group->boxMinY + first;
+    const float* maxX = group->boxMaxX + first;
+    const float* maxY = group->boxMaxY + first;
+    const float recMaxX = rec.x + rec.width, recMaxY = rec.y + rec.height;
+    uint64_t hits = 0;
+#if defined(__AVX__)
+    const __m256 left = _mm256_set1_ps(rec.x), top = _mm256_set1_ps(rec.y);
+    const __m256 right = _mm256_set1_ps(recMaxX), bottom = _mm256_set1_ps(recMaxY);
+    for (int i = 0; i < RAYTMX_BOX_BATCH; i += 8) {
+        __m256 x = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(minX + i), right, _CMP_LT_OQ),
+            _mm256_cmp_ps(_mm256_loadu_ps(maxX + i), left, _CMP_GT_OQ));
+        __m256 y = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(minY + i), bottom, _CMP_LT_OQ),
+            _mm256_cmp_ps(_mm256_loadu_ps(maxY + i), top, _CMP_GT_OQ));
+        hits |= (uint64_t)_mm256_movemask_ps(_mm256_and_ps(x, y)) << i;
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128 left = _mm_set1_ps(rec.x), top = _mm_set1_ps(rec.y);
+    const __m128 right = _mm_set1_ps(recMaxX), bottom = _mm_set1_ps(recMaxY);
+    for (int i = 0; i < RAYTMX_BOX_BATCH; i += 4) { /* Arena allocations are 16-byte aligned */
+        __m128 x = _mm_and_ps(_mm_cmplt_ps(_mm_load_ps(minX + i), right), _mm_cmpgt_ps(_mm_load_ps(maxX + i), left));
+        __m128 y = _mm_and_ps(_mm_cmplt_ps(_mm_load_ps(minY + i), bottom), _mm_cmpgt_ps(_mm_load_ps(maxY + i), top));
+        hits |= (uint64_t)_mm_movemask_ps(_mm_and_ps(x, y)) << i;
+    }
+#else
+    for (int i = 0; i < RAYTMX_BOX_BATCH; i++) {
+        if (minX[i] < recMaxX && maxX[i] > rec.x && minY[i] < recMaxY && maxY[i] > rec.y)
+            hits |= (uint64_t)1 << i;
+    }
+#endif
+    return hits;
 }
 
 RAYTMX_DEC bool CheckCollisionTMXObjectGroupCircle(TmxObjectGroup group, Vector2 center, float radius,
@@ -1360,6 +2070,34 @@ RAYTMX_DEC bool CheckCollisionTMXObjectGroupPolyEx(TmxObjectGroup group, Vector2
     return CheckCollisionTMXObjectGroupObject(group, CreatePolygonTMXObject(points, pointCount, aabb), outputObject);
 }
 
+RAYTMX_DEC TmxMemoryUsage GetMemoryUsageTMX(const TmxMap* map) {
+    TmxMemoryUsage usage;
+    memset(&usage, 0, sizeof(TmxMemoryUsage));
+    if (map == NULL)
+        return usage;
+
+    /* Blocks are counted in full, used or not, because that's what was actually allocated */
+    for (const RaytmxArenaBlock* block = map->arena->blocks; block != NULL; block = block->next)
+        usage.heapBytes += sizeof(RaytmxArenaBlock) + block->capacity;
+    usage.chunkBytes = map->chunkBytes;
+
+    for (uint32_t i = 0; i < map->texturesLength; i++) {
+        usage.textureBytes += (size_t)GetPixelDataSize(map->textures[i].width, map->textures[i].height,
+            map->textures[i].format);
+    }
+    if (map->gpuRenderer != NULL) { /* If the map was prepared for GPU rendering */
+        const RaytmxGpuRenderer* renderer = map->gpuRenderer;
+        usage.textureBytes += (size_t)GetPixelDataSize(renderer->tileTable.width, renderer->tileTable.height,
+            renderer->tileTable.format);
+        for (uint32_t i = 0; i < renderer->gidsTexturesLength; i++) {
+            usage.textureBytes += (size_t)GetPixelDataSize(renderer->gidsTextures[i].width,
+                renderer->gidsTextures[i].height, renderer->gidsTextures[i].format);
+        }
+    }
+
+    return usage;
+}
+
 static int tmxLogFlags = 0;
 
 RAYTMX_DEC void TraceLogTMX(int logLevel, const TmxMap* map) {
@@ -1404,10 +2142,9 @@ RAYTMX_DEC void SetTraceLogFlagsTMX(int logFlags) {
 /**********************************************************************************************************************/
 /* Private implementation.                                                                                            */
 
-RaytmxExternalTileset LoadTSX(const char* fileName) {
+RaytmxExternalTileset LoadTSX(RaytmxState* parentState, const char* fileName) {
     RaytmxState raytmxState[1];
-    memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
-    raytmxState->format = FORMAT_TSX;
+    InitChildState(raytmxState, parentState, FORMAT_TSX);
 
     /* Initialize an external tileset object */
     RaytmxExternalTileset externalTileset;
@@ -1416,32 +2153,25 @@ RaytmxExternalTileset LoadTSX(const char* fileName) {
     /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
     /* equivalent TMX, TSX, and/or TX elements. */
     ParseDocument(raytmxState, fileName);
+    ReturnChildState(raytmxState, parentState); /* Even on failure, as textures may have been loaded */
     if (!raytmxState->isSuccess)
         return externalTileset; /* Will have 'isSuccess' set to false to indicate a failure */
 
-    if (raytmxState->tilesetsRoot != NULL) { /* If there is at least one tileset */
+    if (raytmxState->tilesets.length > 0) { /* If there is at least one tileset */
         /* Copy the root tileset so it can be returned */
-        externalTileset.tileset = raytmxState->tilesetsRoot->tileset;
+        /* Note: TSX files should have only one tileset. Any others are ignored. Their memory belongs to the shared */
+        /* arenas and their textures to the shared texture cache so there's nothing to free. */
+        externalTileset.tileset = ((TmxTileset*)raytmxState->tilesets.data)[0];
         externalTileset.isSuccess = true;
-        /* TSX files should have only one tileset so any others will be freed/unloaded immediately */
-        RaytmxTilesetNode* tilesetIterator = raytmxState->tilesetsRoot->next;
-        while (tilesetIterator != NULL) {
-            FreeTileset(tilesetIterator->tileset);
-            tilesetIterator = tilesetIterator->next;
-        }
     } else
         TraceLog(LOG_WARNING, "RAYTMX: TSX file (external tileset) \"%s\" does not contain any tilesets", fileName);
 
-    /* Free the linked lists and zeroize related values */
-    FreeState(raytmxState);
-
     return externalTileset;
 }
 
-RaytmxObjectTemplate LoadTX(const char* fileName) {
+RaytmxObjectTemplate LoadTX(RaytmxState* parentState, const char* fileName) {
     RaytmxState raytmxState[1];
-    memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
-    raytmxState->format = FORMAT_TX;
+    InitChildState(raytmxState, parentState, FORMAT_TX);
 
     /* Initialize an object template object */
     RaytmxObjectTemplate objectTemplate;
@@ -1450,45 +2180,52 @@ RaytmxObjectTemplate LoadTX(const char* fileName) {
     /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
     /* equivalent TMX, TSX, and/or TX elements. */
     ParseDocument(raytmxState, fileName);
+    ReturnChildState(raytmxState, parentState); /* Even on failure, as textures may have been loaded */
     if (!raytmxState->isSuccess)
         return objectTemplate; /* Will have 'isSuccess' set to false to indicate a failure */
 
-    if (raytmxState->objectsRoot != NULL) { /* If there is at least one object */
-        /* Copy the root object so it can be returned */
-        objectTemplate.object = raytmxState->objectsRoot->object;
+    if (raytmxState->objects.length > 0) { /* If there is at least one object */
+        /* Copy the root object so it can be returned. TX files should have only one object so any others are */
+        /* ignored. Like all other parsed data, they belong to the shared arenas. */
+        objectTemplate.object = ((TmxObject*)raytmxState->objects.data)[0];
         objectTemplate.isSuccess = true;
-        /* TX files should have only one object so any others will be freed/unloaded immediately */
-        RaytmxObjectNode* objectIterator = raytmxState->objectsRoot->next;
-        while (objectIterator != NULL) {
-            FreeObject(objectIterator->object);
-            objectIterator = objectIterator->next;
-        }
     } else
         TraceLog(LOG_WARNING, "RAYTMX: TX file (object template) \"%s\" does not contain any objects", fileName);
 
-    if (raytmxState->tilesetsRoot != NULL) { /* If there is at least one tileset */
+    if (raytmxState->tilesets.length > 0) { /* If there is at least one tileset */
         /* Object templates may have a tileset. This is for cases where the object references a tile (i.e. its 'gid' */
-        /* attribute is set).  Copy the root tileset so it can be returned */
-        objectTemplate.tileset = raytmxState->tilesetsRoot->tileset;
+        /* attribute is set).  Copy the root tileset so it can be returned. TX files should have at most one tileset */
+        /* so any others are ignored. */
+        objectTemplate.tileset = ((TmxTileset*)raytmxState->tilesets.data)[0];
         objectTemplate.hasTileset = true;
-        /* TX files should have at most one tileset so any others will be freed/unloaded immediately */
-        RaytmxTilesetNode* tilesetsIterator = raytmxState->tilesetsRoot->next;
-        while (tilesetsIterator != NULL) {
-            FreeTileset(tilesetsIterator->tileset);
-            tilesetsIterator = tilesetsIterator->next;
-        }
     }
 
-    /* Free the linked lists and zeroize related values */
-    FreeState(raytmxState);
-
     return objectTemplate;
 }
 
+void InitChildState(RaytmxState* raytmxState, const RaytmxState* parentState, RaytmxDocumentFormat format) {
+    memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
+    raytmxState->format = format;
+    /* External tilesets and object templates become part of the map so they share its arenas. They also share the */
+    /* texture cache so an image referenced by both a map and a TSX file is loaded, and later unloaded, only once. */
+    raytmxState->arena = parentState->arena;
+    raytmxState->scratch = parentState->scratch;
+    raytmxState->texturesRoot = parentState->texturesRoot;
+    raytmxState->texturesLength = parentState->texturesLength;
+}
+
+void ReturnChildState(const RaytmxState* raytmxState, RaytmxState* parentState) {
+    /* New textures are appended to the shared cache so only the root, if it was empty, and length can change */
+    parentState->texturesRoot = raytmxState->texturesRoot;
+    parentState->texturesLength = raytmxState->texturesLength;
+}
+
 void ParseDocument(RaytmxState* raytmxState, const char* fileName) {
+    RAYTMX_TRACE_BEGIN("ParseDocument");
     char* content = LoadFileText(fileName);
     if (content == NULL) {
         TraceLog(LOG_ERROR, "RAYTMX: Failed to open \"%s\"", fileName);
+        RAYTMX_TRACE_END();
         return;
     }
     size_t contentLength = strlen(content);
@@ -1505,7 +2242,11 @@ void ParseDocument(RaytmxState* raytmxState, const char* fileName) {
         if (code > HOXML_END_OF_DOCUMENT) { /* If there's information about an element, attribute, whatever */
             switch (code) {
             case HOXML_ELEMENT_BEGIN: HandleElementBegin(raytmxState, hoxmlContext); break;
-            case HOXML_ELEMENT_END: HandleElementEnd(raytmxState, hoxmlContext); break;
+            case HOXML_ELEMENT_END:
+                RAYTMX_TRACE_BEGIN("HandleElementEnd");
+                HandleElementEnd(raytmxState, hoxmlContext);
+                RAYTMX_TRACE_END();
+                break;
             case HOXML_ATTRIBUTE: HandleAttribute(raytmxState, hoxmlContext);
             case HOXML_PROCESSING_INSTRUCTION_BEGIN: break;
             case HOXML_PROCESSING_INSTRUCTION_END: break;
@@ -1545,6 +2286,7 @@ void ParseDocument(RaytmxState* raytmxState, const char* fileName) {
             default: break; /* Keep the compiler happy */
             }
             UnloadFileText(content);
+            RAYTMX_TRACE_END();
             return;
         }
     }
@@ -1552,6 +2294,7 @@ void ParseDocument(RaytmxState* raytmxState, const char* fileName) {
     UnloadFileText(content);
     MemFree(buffer);
     raytmxState->isSuccess = true;
+    RAYTMX_TRACE_END();
 }
 
 void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
@@ -1610,6 +2353,9 @@ void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext)
         raytmxState->layer = AddGenericLayer(raytmxState, /* isGroup: */ false);
         raytmxState->layer->type = LAYER_TYPE_TILE_LAYER;
         raytmxState->tileLayer = &raytmxState->layer->exact.tileLayer;
+    } else if (strcmp(hoxmlContext->tag, "chunk") == 0) {
+        if (raytmxState->tileLayer != NULL) /* <chunk>s are children of a <layer>'s <data> in infinite maps */
+            raytmxState->chunk = AddChunk(raytmxState);
     } else if (strcmp(hoxmlContext->tag, "objectgroup") == 0) {
         if (raytmxState->tilesetTile != NULL) { /* If the object group is a child of a <tile>, it's collision info */
             raytmxState->objectGroup = &raytmxState->tilesetTile->objectGroup;
@@ -1650,7 +2396,7 @@ void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext)
     } else if (strcmp(hoxmlContext->tag, "text") == 0) {
         if (raytmxState->object != NULL) {
             raytmxState->object->type = OBJECT_TYPE_TEXT;
-            raytmxState->object->text = (TmxText*)MemAllocZero(sizeof(TmxText));
+            raytmxState->object->text = (TmxText*)ArenaAllocZero(raytmxState->arena, sizeof(TmxText));
             /* There are a couple non-zero default values for <text> attributes: */
             raytmxState->object->text->pixelSize = 16;
             raytmxState->object->text->color.a = 255; /* Full opacity black */
@@ -1698,6 +2444,8 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             raytmxState->mapWidth = atoi(hoxmlContext->value);
         else if (strcmp(hoxmlContext->attribute, "height") == 0)
             raytmxState->mapHeight = atoi(hoxmlContext->value);
+        else if (strcmp(hoxmlContext->attribute, "infinite") == 0)
+            raytmxState->mapInfinite = atoi(hoxmlContext->value) != 0;
         else if (strcmp(hoxmlContext->attribute, "tilewidth") == 0)
             raytmxState->mapTileWidth = atoi(hoxmlContext->value);
         else if (strcmp(hoxmlContext->attribute, "tileheight") == 0)
@@ -1714,8 +2462,7 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
     else if (strcmp(hoxmlContext->tag, "property") == 0) {
         if (raytmxState->property != NULL) {
             if (strcmp(hoxmlContext->attribute, "name") == 0) {
-                raytmxState->property->name = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
-                StringCopy(raytmxState->property->name, hoxmlContext->value);
+                raytmxState->property->name = ArenaStringCopy(raytmxState->arena, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "type") == 0) {
                 if (strcmp(hoxmlContext->value, "string") == 0)
                     raytmxState->property->type = PROPERTY_TYPE_STRING;
@@ -1739,8 +2486,7 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 /* attribute. In that case, doing a cast/conversion now may not be possible. To avoid this, the raw */
                 /* string value is copied to 'stringValue' temporarily, or permanently for string and file types, and */
                 /* the cast/conversion will happen at the end of the element if needed. */
-                raytmxState->property->stringValue = (char*)MemAlloc((unsigned int)strlen(hoxmlContext->value) + 1);
-                StringCopy(raytmxState->property->stringValue, hoxmlContext->value);
+                raytmxState->property->stringValue = ArenaStringCopy(raytmxState->arena, hoxmlContext->value);
             } /* strcmp(hoxmlContext->attribute, "value") == 0 */
         } /* raytmxState->property != NULL */
     } /* strcmp(hoxmlContext->tag, "property") == 0 */
@@ -1749,11 +2495,10 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             if (strcmp(hoxmlContext->attribute, "firstgid") == 0)
                 raytmxState->tileset->firstGid = atoi(hoxmlContext->value);
             else if (strcmp(hoxmlContext->attribute, "source") == 0) {
-                raytmxState->tileset->source = (char*)MemAlloc((unsigned int)strlen(hoxmlContext->value) + 1);
-                StringCopy(raytmxState->tileset->source, hoxmlContext->value);
+                raytmxState->tileset->source = ArenaStringCopy(raytmxState->arena, hoxmlContext->value);
                 /* 'source' points to an external TSX file that defines the majority of the tileset. Try to load it. */
-                RaytmxExternalTileset externalTileset = LoadTSX(JoinPath(raytmxState->documentDirectory,
-                    hoxmlContext->value));
+                RaytmxExternalTileset externalTileset = LoadTSX(raytmxState,
+                    JoinPath(raytmxState->documentDirectory, hoxmlContext->value));
                 if (externalTileset.isSuccess) {
                     /* A <tileset> within a <map> will have two attributes: 'firstgid' and 'source.' The rest of */
                     /* the tileset's details are in the external TSX that 'source' points to. They need to be merged. */
@@ -1768,11 +2513,9 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     raytmxState->tileset->source = tempSource;
                 }
             } else if (strcmp(hoxmlContext->attribute, "name") == 0) {
-                raytmxState->tileset->name = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
-                StringCopy(raytmxState->tileset->name, hoxmlContext->value);
+                raytmxState->tileset->name = ArenaStringCopy(raytmxState->arena, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "class") == 0) {
-                raytmxState->tileset->classString = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
-                StringCopy(raytmxState->tileset->classString, hoxmlContext->value);
+                raytmxState->tileset->classString = ArenaStringCopy(raytmxState->arena, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "tilewidth") == 0)
                 raytmxState->tileset->tileWidth = atoi(hoxmlContext->value);
             else if (strcmp(hoxmlContext->attribute, "tileheight") == 0)
@@ -1820,8 +2563,7 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
     else if (strcmp(hoxmlContext->tag, "image") == 0) {
         if (raytmxState->image != NULL) {
             if (strcmp(hoxmlContext->attribute, "source") == 0) {
-                raytmxState->image->source = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
-                StringCopy(raytmxState->image->source, hoxmlContext->value);
+                raytmxState->image->source = ArenaStringCopy(raytmxState->arena, hoxmlContext->value);
                 RaytmxCachedTextureNode* cachedTexture = LoadCachedTexture(raytmxState, hoxmlContext->value);
                 if (cachedTexture != NULL)
                      raytmxState->image->texture = cachedTexture->texture;
@@ -1873,18 +2615,27 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
     else if (strcmp(hoxmlContext->tag, "data") == 0) {
         if (raytmxState->tileLayer != NULL) { /* If this <data> applies to a <layer> */
             if (strcmp(hoxmlContext->attribute, "encoding") == 0) {
-                raytmxState->tileLayer->encoding = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
-                StringCopy(raytmxState->tileLayer->encoding, hoxmlContext->value);
+                raytmxState->tileLayer->encoding = ArenaStringCopy(raytmxState->arena, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "compression") == 0) {
-                raytmxState->tileLayer->compression =
-                    (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
-                StringCopy(raytmxState->tileLayer->compression, hoxmlContext->value);
+                raytmxState->tileLayer->compression = ArenaStringCopy(raytmxState->arena, hoxmlContext->value);
             }
         } else if (raytmxState->image != NULL) { /* If this <data> applies to an <image> */
             /* TODO (?): The TMX map format documentation says an <image> can contain a <data> element but doesn't */
             /* provide any more information than that. Tiled doesn't seem to have a feature for this either. */
         }
     } /* strcmp(hoxmlContext->tag, "data") == 0 */
+    else if (strcmp(hoxmlContext->tag, "chunk") == 0) {
+        if (raytmxState->chunk != NULL) {
+            if (strcmp(hoxmlContext->attribute, "x") == 0)
+                raytmxState->chunk->x = atoi(hoxmlContext->value);
+            else if (strcmp(hoxmlContext->attribute, "y") == 0)
+                raytmxState->chunk->y = atoi(hoxmlContext->value);
+            else if (strcmp(hoxmlContext->attribute, "width") == 0)
+                raytmxState->chunk->width = atoi(hoxmlContext->value);
+            else if (strcmp(hoxmlContext->attribute, "height") == 0)
+                raytmxState->chunk->height = atoi(hoxmlContext->value);
+        }
+    } /* strcmp(hoxmlContext->tag, "chunk") == 0 */
     else if (strcmp(hoxmlContext->tag, "objectgroup") == 0) {
         if (raytmxState->objectGroup != NULL) {
             /* Check for attributes specific to <objectgroup> layers */
@@ -1908,11 +2659,9 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             if (strcmp(hoxmlContext->attribute, "id") == 0)
                 raytmxState->object->id = atoi(hoxmlContext->value);
             else if (strcmp(hoxmlContext->attribute, "name") == 0) {
-                raytmxState->object->name = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
-                StringCopy(raytmxState->object->name, hoxmlContext->value);
+                raytmxState->object->name = ArenaStringCopy(raytmxState->arena, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "type") == 0) {
-                raytmxState->object->typeString = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
-                StringCopy(raytmxState->object->typeString, hoxmlContext->value);
+                raytmxState->object->typeString = ArenaStringCopy(raytmxState->arena, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "x") == 0)
                 raytmxState->object->x = atof(hoxmlContext->value);
             else if (strcmp(hoxmlContext->attribute, "y") == 0)
@@ -1930,9 +2679,7 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             } else if (strcmp(hoxmlContext->attribute, "visible") == 0)
                 raytmxState->object->visible = atoi(hoxmlContext->value) != 0 ? true : false;
             else if (strcmp(hoxmlContext->attribute, "template") == 0) {
-                raytmxState->object->templateString =
-                    (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
-                StringCopy(raytmxState->object->templateString, hoxmlContext->value);
+                raytmxState->object->templateString = ArenaStringCopy(raytmxState->arena, hoxmlContext->value);
             }
         }
     } /* strcmp(hoxmlContext->tag, "object") == 0 */
@@ -1949,8 +2696,19 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             /* points are relative to the object's position (its 'x' and 'y' attributes) */
             char x[32], y[32], *iterator, *terminator, *comma;
             iterator = hoxmlContext->value;
-            RaytmxPolyPointNode *pointsRoot = NULL, *pointsTail = NULL;
-            uint32_t pointsLength = 0;
+            /* Every point has exactly one comma so counting them gives an upper bound on the number of points. The */
+            /* first vertex will be duplicated and appended to the end of the array, for drawing purposes, and */
+            /* polygons will be drawn using raylib's DrawTriangleFan() function in which the first point is the */
+            /* centroid, so there are up to two more points than vertices. */
+            bool isPolygon = strcmp(hoxmlContext->tag, "polygon") == 0;
+            uint32_t verticesCapacity = 0;
+            for (const char* c = iterator; *c != '\0'; c++) {
+                if (*c == ',')
+                    verticesCapacity += 1;
+            }
+            Vector2* points = (Vector2*)ArenaAllocZero(raytmxState->arena, sizeof(Vector2) * (verticesCapacity + 2));
+            uint32_t verticesLength = 0;
+            uint32_t firstVertex = isPolygon ? 1 : 0; /* Skip over the first element, the centroid, for polygons only */
             Vector2 vertexSum; /* Specific to polygons, the centroid is calculated requiring a sum of all vertices */
             vertexSum.x = 0;
             vertexSum.y = 0;
@@ -1974,69 +2732,41 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 iterator = comma + 1; /* Point the iterator right after the ',' where Y begins */
                 StringCopyN(y, iterator, terminator - iterator); /* Copy 'iterator' up to but excluding 'terminator' */
                 y[terminator - iterator] = '\0';
-                /* Create a linked list node to hold the point and append it to the linked list */
-                RaytmxPolyPointNode* node = (RaytmxPolyPointNode*)MemAllocZero(sizeof(RaytmxPolyPointNode));
                 /* Note: These values may be negative. A poly(gon|line) object's position is determined by the first */
                 /* vertex added leading to the first entry to be "0,0" and all other vertices relative to it. */
-                node->point.x = (float)atof(x);
-                node->point.y = (float)atof(y);
-                vertexSum.x += node->point.x;
-                vertexSum.y += node->point.y;
-                if (pointsRoot == NULL) /* If this is the first point to add to the list */
-                    pointsRoot = node;
-                else /* If adding to the tail of the list */
-                    pointsTail->next = node;
-                pointsTail = node;
-                pointsLength += 1;
+                Vector2* point = &points[firstVertex + verticesLength];
+                point->x = (float)atof(x);
+                point->y = (float)atof(y);
+                vertexSum.x += point->x;
+                vertexSum.y += point->y;
+                verticesLength += 1;
                 iterator = *terminator != '\0' ? terminator + 1 : NULL;
             }
 
-            if (pointsRoot != NULL) { /* If a list with at least one node was created from the 'points' attribute */
-                /* The first vertex will be duplicated and appended to the end of the list, for drawing purposes, so */
-                /* the length of the points list is incremented by one */
-                pointsLength += 1;
-                bool isPolygon = strcmp(hoxmlContext->tag, "polygon") == 0;
-                if (isPolygon) { /* If the object is a polygon, not polyline */
-                    /* Polygons will be drawn using raylib's DrawTriangleFan() function in which the first point is */
-                    /* the centroid. It must also end with the first, non-centroid point. So, for polygons, the list */
-                    /* will have two more points. */
-                    pointsLength += 1;
-                }
-                /* Allocate the array and assign NULL to every index to be safe */
-                Vector2* points = (Vector2*)MemAllocZero(sizeof(Vector2) * pointsLength);
+            if (verticesLength > 0) { /* If at least one point was read from the 'points' attribute */
+                /* The first vertex is duplicated at the end and, for polygons, the centroid is at the start */
+                uint32_t pointsLength = verticesLength + 1 + firstVertex;
                 if (isPolygon) { /* If the centroid should be included as a vertex */
-                    /* Finish calculating the centroid by averaging the sum of the vertices keeping in mind that */
-                    /* 'pointsLength' is equal to N + 2 */
-                    points[0].x = vertexSum.x / (pointsLength - 2);
-                    points[0].y = vertexSum.y / (pointsLength - 2);
+                    /* Finish calculating the centroid by averaging the sum of the vertices */
+                    points[0].x = vertexSum.x / verticesLength;
+                    points[0].y = vertexSum.y / verticesLength;
                 }
-                /* Copy the points as Vector2s into the array and free the nodes while we're at it */
-                RaytmxPolyPointNode* iteratorNode = pointsRoot;
-                uint32_t i = isPolygon ? 1 : 0; /* Skip over the first element, the centroid, for polygons only */
-                while (iteratorNode != NULL) {
-                    points[i] = iteratorNode->point;
-                    RaytmxPolyPointNode* parent = iteratorNode;
-                    iteratorNode = iteratorNode->next;
-                    i += 1;
-                    MemFree(parent);
-                }
-                /* End the list with the first point. Both polygons and polylines use this when drawing. */
+                /* End the array with the first point. Both polygons and polylines use this when drawing. */
                 points[pointsLength - 1].x = points[isPolygon ? 1 : 0].x;
                 points[pointsLength - 1].y = points[isPolygon ? 1 : 0].y;
                 /* TODO: sort the vertices into counter-clockwise order as DrawTriangleFan() requires it */
                 /* Add the points array to the element it applies to */
                 raytmxState->object->points = points;
                 raytmxState->object->pointsLength = pointsLength;
-                raytmxState->object->drawPoints = (Vector2*)MemAllocZero(sizeof(Vector2) * pointsLength);
+                raytmxState->object->drawPoints = (Vector2*)ArenaAllocZero(raytmxState->arena,
+                    sizeof(Vector2) * pointsLength);
             }
         } /* raytmxState->object != NULL && strcmp(hoxmlContext->attribute, "points") == 0 */
     } /* strcmp(hoxmlContext->tag, "polygon") == 0 || strcmp(hoxmlContext->tag, "polyline") == 0 */
     else if (strcmp(hoxmlContext->tag, "text") == 0) {
         if (raytmxState->object != NULL && raytmxState->object->text != NULL) {
             if (strcmp(hoxmlContext->attribute, "fontfamily") == 0) {
-                raytmxState->object->text->fontFamily =
-                    (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
-                StringCopy(raytmxState->object->text->fontFamily, hoxmlContext->value);
+                raytmxState->object->text->fontFamily = ArenaStringCopy(raytmxState->arena, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "pixelsize") == 0)
                 raytmxState->object->text->pixelSize = atoi(hoxmlContext->value);
             else if (strcmp(hoxmlContext->attribute, "wrap") == 0)
@@ -2089,11 +2819,9 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             if (strcmp(hoxmlContext->attribute, "id") == 0)
                 raytmxState->layer->id = atoi(hoxmlContext->value);
             else if (strcmp(hoxmlContext->attribute, "name") == 0) {
-                raytmxState->layer->name = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
-                StringCopy(raytmxState->layer->name, hoxmlContext->value);
+                raytmxState->layer->name = ArenaStringCopy(raytmxState->arena, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "class") == 0) {
-                raytmxState->layer->classString = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
-                StringCopy(raytmxState->layer->classString, hoxmlContext->value);
+                raytmxState->layer->classString = ArenaStringCopy(raytmxState->arena, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "opacity") == 0)
                 raytmxState->layer->opacity = atof(hoxmlContext->value);
             else if (strcmp(hoxmlContext->attribute, "visible") == 0)
@@ -2129,20 +2857,18 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             /* Apply default values for the attribute(s) that aren't covered by a simple memset(x, 0, sizeof(x)) */
             if (layer->name == NULL) { /* If this layer didn't have a 'name' attribute */
                 /* The default value for 'name' is "" (an empty string) */
-                layer->name = (char*)MemAlloc(1);
-                layer->name[0] = '\0';
+                layer->name = ArenaStringCopy(raytmxState->arena, "");
             }
             if (layer->classString == NULL) { /* If this layer didn't have a 'class' attribute */
                 /* The default value for 'class' is "" (an empty string) */
-                layer->classString = (char*)MemAlloc(1);
-                layer->classString[0] = '\0';
+                layer->classString = ArenaStringCopy(raytmxState->arena, "");
             }
         }
     } /* strcmp(hoxmlContext->tag, "layer") == 0 || strcmp(hoxmlContext->tag, "objectgroup") == 0 || */
       /* strcmp(hoxmlContext->tag, "imagelayer") == 0 || strcmp(hoxmlContext->tag, "group") == 0 */
 
     if (strcmp(hoxmlContext->tag, "properties") == 0) {
-        if (raytmxState->propertiesRoot == NULL)
+        if (raytmxState->properties.length == 0)
             return;
         /* TMX allows nested properties (e.g. <properties><properties><property/></properties></properties>) but */
         /* that is unsupported. Depth is tracked such that all properties, included nested ones, are appended to one */
@@ -2150,49 +2876,41 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
         raytmxState->propertiesDepth -= 1;
         if (raytmxState->propertiesDepth > 0) /* If the outermost <properties> has not yet ended */
             return;
-        /* Allocate the array and assign NULL to every index to be safe */
-        TmxProperty* properties = (TmxProperty*)MemAllocZero(sizeof(TmxProperty) * raytmxState->propertiesLength);
-        /* Copy the TmxProperty pointers into the array and free the nodes while we're at it */
-        RaytmxPropertyNode* iterator = raytmxState->propertiesRoot;
-        for (uint32_t i = 0; i < raytmxState->propertiesLength; i++) {
-            properties[i] = iterator->property;
-            RaytmxPropertyNode* parent = iterator;
-            iterator = iterator->next;
-            MemFree(parent);
-        }
+        /* Copy the TmxProperties into an array of the exact size. The buffer belongs to the scratch arena. */
+        TmxProperty* properties = (TmxProperty*)BufferCopy(raytmxState->arena, &raytmxState->properties,
+            sizeof(TmxProperty));
+        uint32_t propertiesLength = raytmxState->properties.length;
         /* Add the properties array to the element it applies to */
         /* A <property>, or rather its parent <properties>, can be within 10+ other elements. The order of the checks */
         /* here is slightly important as the most-nested elements must come first in cases where one may contain */
         /* another (e.g. an <object> within an <objectgroup> layer). */
         if (raytmxState->tilesetTile != NULL && raytmxState->tilesetTile->properties == NULL) {
             raytmxState->tilesetTile->properties = properties;
-            raytmxState->tilesetTile->propertiesLength = raytmxState->propertiesLength;
+            raytmxState->tilesetTile->propertiesLength = propertiesLength;
         }
         /* else if (raytmxState->wangColor != NULL && raytmxState->wangColor->properties == NULL) {
             raytmxState->wangColor->properties = properties;
-            raytmxState->wangColor->propertiesLength = raytmxState->propertiesLength;
+            raytmxState->wangColor->propertiesLength = propertiesLength;
         }
         else if (raytmxState->wangSet != NULL && raytmxState->wangSet->properties == NULL) {
             raytmxState->wangSet->properties = properties;
-            raytmxState->wangSet->propertiesLength = raytmxState->propertiesLength;
+            raytmxState->wangSet->propertiesLength = propertiesLength;
         } */ /* TODO: Wang sets. Low priority. */
         else if (raytmxState->tileset != NULL && raytmxState->tileset->properties == NULL) {
             raytmxState->tileset->properties = properties;
-            raytmxState->tileset->propertiesLength = raytmxState->propertiesLength;
+            raytmxState->tileset->propertiesLength = propertiesLength;
         } else if (raytmxState->object != NULL && raytmxState->object->properties == NULL) {
             raytmxState->object->properties = properties;
-            raytmxState->object->propertiesLength = raytmxState->propertiesLength;
+            raytmxState->object->propertiesLength = propertiesLength;
         } else if (raytmxState->layer != NULL && raytmxState->layer->properties == NULL) {
             raytmxState->layer->properties = properties;
-            raytmxState->layer->propertiesLength = raytmxState->propertiesLength;
+            raytmxState->layer->propertiesLength = propertiesLength;
         } else {
             raytmxState->mapProperties = properties;
-            raytmxState->mapPropertiesLength = raytmxState->propertiesLength;
+            raytmxState->mapPropertiesLength = propertiesLength;
         }
-        /* Clean up the state object */
-        raytmxState->propertiesRoot = NULL;
-        raytmxState->propertiesTail = NULL;
-        raytmxState->propertiesLength = 0;
+        /* Clean up the state object. The buffer's capacity is kept for the next <properties>. */
+        raytmxState->properties.length = 0;
     } /* strcmp(hoxmlContext->tag, "properties") == 0 */
     else if (strcmp(hoxmlContext->tag, "property") == 0) {
         if (raytmxState->property != NULL) {
@@ -2207,13 +2925,10 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                         /* From the documentation: "When a string property contains newlines, the current version of */
                         /* Tiled will write out the value as characters contained inside the property element rather */
                         /* than as the value attribute." */
-                        raytmxState->property->stringValue =
-                            (char*)MemAlloc((unsigned int)strlen(hoxmlContext->content) + 1);
-                        StringCopy(raytmxState->property->stringValue, hoxmlContext->content);
+                        raytmxState->property->stringValue = ArenaStringCopy(raytmxState->arena, hoxmlContext->content);
                     } else { /* If the string's value was neither provided as an attribute nor content */
                         /* The default value for 'string' is an empty string */
-                        raytmxState->property->stringValue = (char*)MemAlloc(1);
-                        raytmxState->property->stringValue[0] = '\0';
+                        raytmxState->property->stringValue = ArenaStringCopy(raytmxState->arena, "");
                     }
                 } break;
             case PROPERTY_TYPE_INT:
@@ -2242,19 +2957,17 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 break;
             case PROPERTY_TYPE_FILE:
                 /* The default value for 'file' is "." */
-                if (raytmxState->property->stringValue == NULL) {
-                    raytmxState->property->stringValue = (char*)MemAlloc(2);
-                    raytmxState->property->stringValue[0] = '.';
-                    raytmxState->property->stringValue[1] = '\0';
-                } break;
+                if (raytmxState->property->stringValue == NULL)
+                    raytmxState->property->stringValue = ArenaStringCopy(raytmxState->arena, ".");
+                break;
             } /* switch (raytmxState->property->type) */
 
             /* If the type was neither 'string' nor 'file' and 'stringValue' is set */
             if (raytmxState->property->type != PROPERTY_TYPE_STRING &&
                     raytmxState->property->type != PROPERTY_TYPE_FILE && raytmxState->property->stringValue != NULL) {
                 /* Properties of types other than 'string' and 'file' are placed in 'stringValue' temporarily. Now */
-                /* that they have been cast and assigned appropriately, 'stringValue' can be freed. */
-                MemFree(raytmxState->property->stringValue);
+                /* that they have been cast and assigned appropriately, 'stringValue' can be dropped. Its few bytes */
+                /* are released with the rest of the arena. */
                 raytmxState->property->stringValue = NULL;
             }
         }
@@ -2265,13 +2978,11 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             /* Apply default values for the attribute(s) that aren't covered by a simple memset(x, 0, sizeof(x)) */
             if (raytmxState->tileset->name == NULL) { /* If this <tileset> didn't have a 'name' attribute */
                 /* The default value for 'name' is "" (an empty string) */
-                raytmxState->tileset->name = (char*)MemAlloc(1);
-                raytmxState->tileset->name[0] = '\0';
+                raytmxState->tileset->name = ArenaStringCopy(raytmxState->arena, "");
             }
             if (raytmxState->tileset->classString == NULL) { /* If this <tileset> didn't have a 'class' attribute */
                 /* The default value for 'class' is "" (an empty string) */
-                raytmxState->tileset->classString = (char*)MemAlloc(1);
-                raytmxState->tileset->classString[0] = '\0';
+                raytmxState->tileset->classString = ArenaStringCopy(raytmxState->arena, "");
             }
             if (raytmxState->tileset->objectAlignment == OBJECT_ALIGNMENT_UNSPECIFIED) {
                 /* There are default object alignments for orthogonal and isometric modes */
@@ -2281,25 +2992,13 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     raytmxState->tileset->objectAlignment = OBJECT_ALIGNMENT_BOTTOM;
             }
 
-            if (raytmxState->tilesetTilesRoot != NULL) {
-                /* Allocate the array and zeroize every index as initialization */
-                TmxTilesetTile* tiles = (TmxTilesetTile*)MemAllocZero(sizeof(TmxTilesetTile) *
-                    raytmxState->tilesetTilesLength);
-                /* Copy the TmxTilesetTile pointers into the array and free the nodes while we're at it */
-                RaytmxTilesetTileNode* iterator = raytmxState->tilesetTilesRoot;
-                for (uint32_t i = 0; i < raytmxState->tilesetTilesLength; i++) {
-                    tiles[i] = iterator->tile;
-                    RaytmxTilesetTileNode* parent = iterator;
-                    iterator = iterator->next;
-                    MemFree(parent);
-                }
-                /* Add the tiles array to the tileset */
-                raytmxState->tileset->tiles = tiles;
-                raytmxState->tileset->tilesLength = raytmxState->tilesetTilesLength;
+            if (raytmxState->tilesetTiles.length > 0) {
+                /* Copy the TmxTilesetTiles into an array of the exact size and add it to the tileset */
+                raytmxState->tileset->tiles = (TmxTilesetTile*)BufferCopy(raytmxState->arena,
+                    &raytmxState->tilesetTiles, sizeof(TmxTilesetTile));
+                raytmxState->tileset->tilesLength = raytmxState->tilesetTiles.length;
                 /* Clean up the state object */
-                raytmxState->tilesetTilesRoot = NULL;
-                raytmxState->tilesetTilesTail = NULL;
-                raytmxState->tilesetTilesLength = 0;
+                raytmxState->tilesetTiles.length = 0;
             }
         }
         raytmxState->tileset = NULL;
@@ -2308,26 +3007,14 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
         raytmxState->image = NULL;
     else if (strcmp(hoxmlContext->tag, "animation") == 0) {
         if (raytmxState->tilesetTile != NULL && raytmxState->tilesetTile->hasAnimation) {
-            if (raytmxState->animationFramesRoot == NULL)
+            if (raytmxState->animationFrames.length == 0)
                 return;
-            /* Allocate the array and zeroize every index as initialization */
-            TmxAnimationFrame* frames = (TmxAnimationFrame*)MemAllocZero(sizeof(TmxAnimationFrame) *
-                raytmxState->animationFramesLength);
-            /* Copy the TmxAnimationFrame pointers into the array and free the nodes while we're at it */
-            RaytmxAnimationFrameNode* iterator = raytmxState->animationFramesRoot;
-            for (uint32_t i = 0; i < raytmxState->animationFramesLength; i++) {
-                frames[i] = iterator->frame;
-                RaytmxAnimationFrameNode* parent = iterator;
-                iterator = iterator->next;
-                MemFree(parent);
-            }
-            /* Add the frames array to the tile's animation */
-            raytmxState->tilesetTile->animation.frames = frames;
-            raytmxState->tilesetTile->animation.framesLength = raytmxState->animationFramesLength;
+            /* Copy the TmxAnimationFrames into an array of the exact size and add it to the tile's animation */
+            raytmxState->tilesetTile->animation.frames = (TmxAnimationFrame*)BufferCopy(raytmxState->arena,
+                &raytmxState->animationFrames, sizeof(TmxAnimationFrame));
+            raytmxState->tilesetTile->animation.framesLength = raytmxState->animationFrames.length;
             /* Clean up the state object */
-            raytmxState->animationFramesRoot = NULL;
-            raytmxState->animationFramesTail = NULL;
-            raytmxState->animationFramesLength = 0;
+            raytmxState->animationFrames.length = 0;
         }
     } /* strcmp(hoxmlContext->tag, "animation") == 0 */
     else if (strcmp(hoxmlContext->tag, "frame") == 0)
@@ -2335,35 +3022,24 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
     else if (strcmp(hoxmlContext->tag, "layer") == 0) {
         if (raytmxState->tileLayer != NULL) {
             /* If there were 1+ <tile>s within this <layer> but this <layer> already has tiles (from a <data>?) */
-            if (raytmxState->layerTilesRoot != NULL && raytmxState->tileLayer->tiles != NULL) {
+            if (raytmxState->layerTiles.length > 0 && raytmxState->tileLayer->tiles != NULL) {
                 TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has more than one source of tile data - the latter tiles "
                     "for this layer will be dropped", raytmxState->layer->name);
-                /* Free the nodes and tiles therein */
-                RaytmxTileLayerTileNode* iterator = raytmxState->layerTilesRoot;
-                while (iterator != NULL) {
-                    RaytmxTileLayerTileNode* parent = iterator;
-                    iterator = iterator->next;
-                    MemFree(parent);
-                }
+                /* The buffer and tiles therein belong to the scratch arena so they're simply forgotten */
+            } else if (raytmxState->layerChunks.length > 0) { /* If the layer belongs to an infinite map */
+                /* Copy the chunks into an array of the exact size. Their tiles stay encoded until they're needed. */
+                raytmxState->tileLayer->chunks = (TmxChunk*)BufferCopy(raytmxState->arena, &raytmxState->layerChunks,
+                    sizeof(TmxChunk));
+                raytmxState->tileLayer->chunksLength = raytmxState->layerChunks.length;
             } else {
-                /* Allocate the array and zeroize every index as initialization */
-                uint32_t* tiles = (uint32_t*)MemAllocZero(sizeof(uint32_t) * raytmxState->layerTilesLength);
-                /* Copy the GID into the array and free the nodes while we're at it */
-                RaytmxTileLayerTileNode* iterator = raytmxState->layerTilesRoot;
-                for (uint32_t i = 0; i < raytmxState->layerTilesLength; i++) {
-                    tiles[i] = iterator->gid;
-                    RaytmxTileLayerTileNode* parent = iterator;
-                    iterator = iterator->next;
-                    MemFree(parent);
-                }
-                /* Add the tiles array to the tile layer */
-                raytmxState->tileLayer->tiles = tiles;
-                raytmxState->tileLayer->tilesLength = raytmxState->layerTilesLength;
+                /* Copy the GIDs into an array of the exact size and add it to the tile layer */
+                raytmxState->tileLayer->tiles = (uint32_t*)BufferCopy(raytmxState->arena, &raytmxState->layerTiles,
+                    sizeof(uint32_t));
+                raytmxState->tileLayer->tilesLength = raytmxState->layerTiles.length;
             }
             /* Clean up the state object */
-            raytmxState->layerTilesRoot = NULL;
-            raytmxState->layerTilesTail = NULL;
-            raytmxState->layerTilesLength = 0;
+            raytmxState->layerTiles.length = 0;
+            raytmxState->layerChunks.length = 0;
         }
         raytmxState->tileLayer = NULL;
         raytmxState->layer = NULL;
@@ -2388,185 +3064,57 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
         } else if (raytmxState->tileLayer != NULL && raytmxState->tileLayer->tiles != NULL) {
             TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has more than one source of tile data - the latter tiles for "
                 "this layer will be dropped", raytmxState->layer->name);
+        } else if (raytmxState->tileLayer != NULL && raytmxState->layerChunks.length > 0) {
+            /* The tiles of infinite maps are within the <chunk>s, which were already handled */
         } else if (raytmxState->tileLayer != NULL && raytmxState->tileLayer->encoding != NULL) {
-            RaytmxTileLayerTileNode* tiles = NULL;
-            if (strcmp(raytmxState->tileLayer->encoding, "base64") == 0) {
-                /* The layer's data is a series of unsigned, 32-bit integers encoded as a Base64 string. But, XML */
-                /* considers everything between <data> and </data> to be content meaning there is probably some */
-                /* whitespace on both ends of the content we need to ignore. So, find the actual start and stop: */
-                char *encodedStart = hoxmlContext->content, *encodedEnd;
-                while (isspace(*encodedStart))
-                    encodedStart++;
-                encodedEnd = encodedStart + strlen(encodedStart) - 1;
-                while (encodedEnd > encodedStart && isspace(*encodedEnd))
-                    encodedEnd--;
-
-                /* With the string of encoded Base64 data trimmed, decode it */
-                int decodedLength;
-                unsigned char* decoded = DecodeDataBase64((const unsigned char*)encodedStart, &decodedLength);
-                if (decoded != NULL) {
-                    if (raytmxState->tileLayer->compression == NULL) { /* If the Base64-encoded data is uncompressed */
-                        /* Iterate through N bytes ('decodedLength') with every four bytes being a single GID */
-                        /* resulting in N / 4 tiles */
-                        uint32_t* iterator = (uint32_t*)decoded;
-                        for (int i = 0; i < decodedLength / 4; i++) {
-                            AddTileLayerTile(raytmxState, *iterator);
-                            iterator += 1; /* Point to the next unsigned, 32-bit integer in the decoded data */
-                        }
-                    } else { /* If the Base-64encoded data is also compressed */
-                        if (strcmp(raytmxState->tileLayer->compression, "gzip") == 0 ||
-                                strcmp(raytmxState->tileLayer->compression, "zlib") == 0) {
-                            unsigned char* postHeaderDecoded = NULL;
-                            if (strcmp(raytmxState->tileLayer->compression, "gzip") == 0) {
-                                /* The first two bytes of a GZIP header are expected to be a magic number, 0x1F8B, */
-                                /* identifying the format and the third is expected to indicate the compression */
-                                /* method where 0x08 is DEFLATE. */
-                                /* If these values are found, decompression can continue */
-                                if (decoded[0] == 0x1F && decoded[1] == 0x8B && decoded[2] == 0x08) {
-                                    /* Skip past the GZIP header. The header is typically ten bytes. The bytes not */
-                                    /* checked are unimportant things like a timestamp and OS ID. Additional optional */
-                                    /* headers are possible but not used by Tiled so they are assumed to be missing. */
-                                    postHeaderDecoded = decoded + 10;
-                                } else { /* If the GZIP header doesn't match a decompressable one */
-                                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses GZIP compression but the stream's "
-                                        "header doesn't indicate DEFLATE compression", raytmxState->layer->name);
-                                }
-                            } else /* if (strcmp(raytmxState->tileLayer->compression, "zlib") == 0) */ {
-                                /* The first byte of a ZLIB header is expected to be 0x78 where the 8 indicates the */
-                                /* DEFLATE compression method and the 7 is "compression info" that indicates a 32K */
-                                /* LZ77 window size and, in practice, cannot be anything else. */
-                                /* If these values are found, decompression can continue */
-                                if (decoded[0] == 0x78) {
-                                    /* Skip past the ZLIB header. The header is two bytes. */
-                                    postHeaderDecoded = decoded + 2;
-                                } else { /* If the ZLIB header doesn't match a decompressable one */
-                                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses ZLIB compression but the stream's "
-                                        "header doesn't indicate DEFLATE compression", raytmxState->layer->name);
-                                }
-                            }
-
-                            if (postHeaderDecoded != NULL) {
-                                /* "zlib" and "gzip" both use the DEFLATE algorithm and raylib provides a */
-                                /* decompression function when it's built with SUPPORT_COMPRESSION_API (default) */
-                                int decompressedLength;
-                                unsigned char* decompressed = DecompressData(postHeaderDecoded, decodedLength,
-                                    &decompressedLength);
-                                if (decompressed != NULL && decompressedLength > 0) {
-                                    uint32_t* iterator = (uint32_t*)decompressed;
-                                    for (int i = 0; i < decompressedLength / 4; i++) {
-                                        AddTileLayerTile(raytmxState, *iterator);
-                                        iterator += 1; /* Point to the next unsigned integer in the decompressed data */
-                                    }
-                                    MemFree(decompressed); /* Free the memory allocated by DecompressData() */
-                                } else { /* raylib wasn't built with compression or allocation failed */
-                                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" compressed with \"%s\" cannot be parsed "
-                                        "because DEFLATE decompression failed - either raylib was not built with "
-                                        "SUPPORT_COMPRESSION_API or memory allocation failed", raytmxState->layer->name,
-                                        raytmxState->tileLayer->compression);
-                                }
-                            }
-                        } else {
-                            TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" cannot be parsed because the compression method "
-                                "\"%s\" is unsupported", raytmxState->layer->name, raytmxState->tileLayer->compression);
-                        }
-                    }
-                    MemFree(decoded); /* Free the memory allocated by DecodeDataBase64() */
-                } else {
-                    TraceLog(LOG_ERROR, "RAYTMX: Unable to decode Base64 data for layer \"%s\"",
-                        raytmxState->layer->name);
-                }
-            } /* strcmp(raytmxState->tileLayer->encoding, "base64") == 0 */
-            else if (strcmp(raytmxState->tileLayer->encoding, "csv") == 0) {
-                /* The Comma-Separated Value (CSV) list herein is a series of Global IDs (GIDs) of tiles in the form */
-                /* "31,32,33" where 31, 32, and 33 are GIDs */
-                char valueAsString[16]; /* Needs to fit all digits of a single value - should be more than enough */
-                char* iterator = hoxmlContext->content;
-                while (*iterator != '\0') { /* While not pointing to the end of the end of the string */
-                    memset(valueAsString, '\0', 16); /* Reset the value-as-a-string buffer with all zeroes */
-                    /* Copy each character into the buffer until either a comma or the terminator is reached */
-                    for (int i = 0; *iterator != ',' && *iterator != '\0'; i++) {
-                        valueAsString[i] = *iterator;
-                        iterator++;
-                    }
-                    if (*iterator == ',') /* If iteration was paused by a comma */
-                        iterator++; /* Advance one character so the comma isn't parsed with the value next iteration */
-                    AddTileLayerTile(raytmxState, atoi(valueAsString)); /* Read the value as an integer GID */
-                }
-            } /* strcmp(raytmxState->tileLayer->encoding, "csv") == 0 */
-
-            if (tiles != NULL) { /* If there was no error in parsing the data and there's a linked list of tiles */
-                /* Allocate the array and assign 0 to every index to be safe */
-                uint32_t* tiles = (uint32_t*)MemAlloc(sizeof(uint32_t) * raytmxState->layerTilesLength);
-                memset(tiles, 0, sizeof(uint32_t) * raytmxState->layerTilesLength);
-                /* Copy the GIDs into the array and free the nodes while we're at it */
-                RaytmxTileLayerTileNode* layerTilesIterator = raytmxState->layerTilesRoot;
-                for (uint32_t i = 0; i < raytmxState->layerTilesLength; i++) {
-                    tiles[i] = layerTilesIterator->gid;
-                    RaytmxTileLayerTileNode* layerTilesTemp = layerTilesIterator;
-                    layerTilesIterator = layerTilesIterator->next;
-                    MemFree(layerTilesTemp);
-                }
-                /* Add the tiles array to the element it applies to */
-                raytmxState->tileLayer->tiles = tiles;
-                raytmxState->tileLayer->tilesLength = raytmxState->layerTilesLength;
-                /* Clean up the state object */
-                raytmxState->layerTilesRoot = NULL;
-                raytmxState->layerTilesTail = NULL;
-                raytmxState->layerTilesLength = 0;
+            /* The GIDs are appended to the state's buffer of layer tiles and copied to the layer when it ends */
+            uint32_t gidsLength;
+            uint32_t* gids = DecodeTileData(hoxmlContext->content, raytmxState->tileLayer->encoding,
+                raytmxState->tileLayer->compression, raytmxState->layer->name, &gidsLength);
+            if (gids != NULL) {
+                AddTileLayerTiles(raytmxState, (const unsigned char*)gids, gidsLength);
+                MemFree(gids); /* Free the memory allocated by DecodeTileData() */
             }
         } /* raytmxState->tileLayer != NULL && raytmxState->tileLayer->encoding != NULL */
     } /* strcmp(hoxmlContext->tag, "data") == 0 */
+    else if (strcmp(hoxmlContext->tag, "chunk") == 0) {
+        if (raytmxState->chunk != NULL) {
+            if (raytmxState->tileLayer->encoding == NULL) {
+                TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has a chunk of XML <tile>s, which aren't supported - the "
+                    "chunk will be empty", raytmxState->layer->name);
+            } else {
+                /* Keep the still-encoded content. It's decoded, possibly several times, as the chunk is streamed. */
+                raytmxState->chunk->data = ArenaStringCopy(raytmxState->arena, hoxmlContext->content);
+            }
+            raytmxState->chunk = NULL;
+        }
+    } /* strcmp(hoxmlContext->tag, "chunk") == 0 */
     else if (strcmp(hoxmlContext->tag, "objectgroup") == 0) {
         if (raytmxState->objectGroup != NULL) {
-            if (raytmxState->objectsRoot == NULL)
+            uint32_t objectsLength = raytmxState->objects.length;
+            if (objectsLength == 0)
                 return;
-            /* Allocate the arrays and zeroize every index as initialization */
-            TmxObject* objects = (TmxObject*)MemAllocZero(sizeof(TmxObject) * raytmxState->objectsLength);
-            uint32_t* ySortedObjects = (uint32_t*)MemAllocZero(sizeof(uint32_t) * raytmxState->objectsLength);
-            /* Create a contiguous array of TmxObjects, create a sorted linked list of indexes within that array of */
-            /* TmxObjects (sorted by ascending y-coordinate), and free the object linked list */
-            RaytmxObjectNode *objectsIterator = raytmxState->objectsRoot, *objectsTemp;
-            RaytmxObjectSortingNode *sortingRoot = NULL, *sortingIterator, *sortingTemp, *newSortingNode;
-            for (uint32_t i = 0; objectsIterator != NULL; i++) {
-                objects[i] = objectsIterator->object;
-                /* Add a new node into the sorted list */
-                newSortingNode = (RaytmxObjectSortingNode*)MemAllocZero(sizeof(RaytmxObjectSortingNode));
-                newSortingNode->y = objects[i].y;
-                newSortingNode->index = i;
-                if (sortingRoot == NULL) /* If this is the first node */
-                    sortingRoot = newSortingNode;
-                else if (sortingRoot->y >= newSortingNode->y) { /* If replacing the root node */
-                    newSortingNode->next = sortingRoot;
-                    sortingRoot = newSortingNode;
-                } else { /* If inserting at some location after the root */
-                    sortingIterator = sortingRoot;
-                    while (sortingIterator->next != NULL && newSortingNode->y > sortingIterator->next->y)
-                        sortingIterator = sortingIterator->next;
-                    newSortingNode->next = sortingIterator->next;
-                    sortingIterator->next = newSortingNode;
-                }
-                /* Free the object node */
-                objectsTemp = objectsIterator;
-                objectsIterator = objectsIterator->next;
-                MemFree(objectsTemp);
-            }
-            /* Create a contiguous array from the sorted linked list such that index 0 of this array points to the */
-            /* TmxObject (via its index in 'objects') with the lowest (visually, highest) y-coordinate */
-            sortingIterator = sortingRoot;
-            for (uint32_t i = 0; sortingIterator != NULL; i++) {
-                ySortedObjects[i] = sortingIterator->index;
-                sortingTemp = sortingIterator;
-                sortingIterator = sortingIterator->next;
-                MemFree(sortingTemp);
+            /* Copy the TmxObjects into an array of the exact size. The buffer belongs to the scratch arena. */
+            TmxObject* objects = (TmxObject*)BufferCopy(raytmxState->arena, &raytmxState->objects, sizeof(TmxObject));
+            /* Sort the objects' indexes by ascending y-coordinate such that index 0 of 'ySortedObjects' points to */
+            /* the TmxObject (via its index in 'objects') with the lowest (visually, highest) y-coordinate */
+            RaytmxObjectSortingEntry* sortingEntries = (RaytmxObjectSortingEntry*)ArenaAllocZero(raytmxState->scratch,
+                sizeof(RaytmxObjectSortingEntry) * objectsLength);
+            for (uint32_t i = 0; i < objectsLength; i++) {
+                sortingEntries[i].y = objects[i].y;
+                sortingEntries[i].index = i;
             }
+            qsort(sortingEntries, objectsLength, sizeof(RaytmxObjectSortingEntry), CompareObjectSortingEntries);
+            uint32_t* ySortedObjects = (uint32_t*)ArenaAllocZero(raytmxState->arena, sizeof(uint32_t) * objectsLength);
+            for (uint32_t i = 0; i < objectsLength; i++)
+                ySortedObjects[i] = sortingEntries[i].index;
             /* Add the objects and ySortedObjects array to the object layer */
             raytmxState->objectGroup->objects = objects;
-            raytmxState->objectGroup->objectsLength = raytmxState->objectsLength;
+            raytmxState->objectGroup->objectsLength = objectsLength;
             raytmxState->objectGroup->ySortedObjects = ySortedObjects;
+            BucketObjectGroup(raytmxState->arena, raytmxState->objectGroup);
             /* Clean up the state object */
-            raytmxState->objectsRoot = NULL;
-            raytmxState->objectsTail = NULL;
-            raytmxState->objectsLength = 0;
+            raytmxState->objects.length = 0;
         }
         raytmxState->objectGroup = NULL;
         raytmxState->layer = NULL;
@@ -2575,13 +3123,11 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             /* Apply default values for the attribute(s) that aren't covered by a simple memset(x, 0, sizeof(x)) */
             if (raytmxState->object->name == NULL) { /* If this <object> didn't have a 'name' attribute */
                 /* The default value for 'name' is "" (an empty string) */
-                raytmxState->object->name = (char*)MemAlloc(1);
-                raytmxState->object->name[0] = '\0';
+                raytmxState->object->name = ArenaStringCopy(raytmxState->arena, "");
             }
             if (raytmxState->object->typeString == NULL) { /* If this <object> didn't have a 'type' attribute */
                 /* The default value for 'type' is "" (an empty string) */
-                raytmxState->object->typeString = (char*)MemAlloc(1);
-                raytmxState->object->typeString[0] = '\0';
+                raytmxState->object->typeString = ArenaStringCopy(raytmxState->arena, "");
             }
 
             if (raytmxState->object->templateString != NULL) {
@@ -2599,14 +3145,11 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     /* define one of its own. The template's <object> needs to be checked for non-default values and */
                     /* <properties> and they need to be applied to the instanced <object> where none exist. */
                     if (objectTemplate.object.name != NULL && raytmxState->object->name == NULL) {
-                        raytmxState->object->name =
-                            (char*)MemAllocZero((unsigned int)strlen(objectTemplate.object.name) + 1);
-                        StringCopy(raytmxState->object->name, objectTemplate.object.name);
+                        raytmxState->object->name = ArenaStringCopy(raytmxState->arena, objectTemplate.object.name);
                     }
                     if (objectTemplate.object.typeString != NULL && raytmxState->object->typeString != NULL) {
                         raytmxState->object->typeString =
-                            (char*)MemAllocZero((unsigned int)strlen(objectTemplate.object.typeString) + 1);
-                        StringCopy(raytmxState->object->typeString, objectTemplate.object.typeString);
+                            ArenaStringCopy(raytmxState->arena, objectTemplate.object.typeString);
                     }
                     if (objectTemplate.object.x != 0.0 && raytmxState->object->x == 0.0)
                         raytmxState->object->x = objectTemplate.object.x;
@@ -2636,58 +3179,29 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                         } else {
                             /* The two <properties> need to be merged keeping in mind that they may, or probably, */
                             /* have overlapping entries. (When both have properties of the same name, the instanced */
-                            /* <object>'s takes priority.) Create a linked list from which to create this new, merged */
-                            /* properties array. */
-                            RaytmxPropertyNode *propertiesRoot = NULL, *propertiesTail = NULL, *node;
-                            uint32_t propertiesLength = 0;
-                            /* Add the properties from the instanced <object> */
-                            for (uint32_t i = 0; i < raytmxState->object->propertiesLength; i++) {
-                                node = (RaytmxPropertyNode*)MemAllocZero(sizeof(RaytmxPropertyNode));
-                                node->property = raytmxState->object->properties[i];
-                                if (propertiesRoot == NULL)
-                                    propertiesRoot = node;
-                                else
-                                    propertiesTail->next = node;
-                                propertiesTail = node;
-                                propertiesLength += 1;
-                            }
+                            /* <object>'s takes priority.) Allocate a new array large enough for both, leaving the */
+                            /* previous array to the arena, and start it with the instanced <object>'s properties. */
+                            uint32_t instanceLength = raytmxState->object->propertiesLength;
+                            uint32_t propertiesLength = instanceLength;
+                            TmxProperty* properties = (TmxProperty*)ArenaAllocZero(raytmxState->arena,
+                                sizeof(TmxProperty) * (instanceLength + objectTemplate.object.propertiesLength));
+                            memcpy(properties, raytmxState->object->properties, sizeof(TmxProperty) * instanceLength);
                             /* Add the properties from the template's <object> if they do not already exist */
                             for (uint32_t i = 0; i < objectTemplate.object.propertiesLength; i++) {
-                                RaytmxPropertyNode* propertiesIterator = propertiesRoot;
                                 bool isNew = true;
-                                while (propertiesIterator != NULL) {
-                                    if (strcmp(objectTemplate.object.properties[i].name,
-                                            propertiesIterator->property.name) == 0) {
+                                for (uint32_t j = 0; j < instanceLength; j++) {
+                                    if (strcmp(objectTemplate.object.properties[i].name, properties[j].name) == 0) {
                                         isNew = false;
                                         break;
                                     }
-                                    propertiesIterator = propertiesIterator->next;
                                 }
                                 if (isNew) {
-                                    node = (RaytmxPropertyNode*)MemAllocZero(sizeof(RaytmxPropertyNode));
-                                    node->property = objectTemplate.object.properties[i];
-                                    if (propertiesRoot == NULL)
-                                        propertiesRoot = node;
-                                    else
-                                        propertiesTail->next = node;
-                                    propertiesTail = node;
+                                    properties[propertiesLength] = objectTemplate.object.properties[i];
                                     propertiesLength += 1;
                                 }
                             }
-                            /* Free the separate array that was previously allocated */
-                            MemFree(raytmxState->object->properties);
-                            /* Allocate a new array to be populated with the merged properties */
-                            raytmxState->object->properties =
-                                (TmxProperty*)MemAllocZero(sizeof(TmxProperty) * propertiesLength);
+                            raytmxState->object->properties = properties;
                             raytmxState->object->propertiesLength = propertiesLength;
-                            /* Copy the TmxProperty entires into the array and free the nodes while we're at it */
-                            RaytmxPropertyNode* propertiesIterator = propertiesRoot;
-                            for (uint32_t i = 0; propertiesIterator != NULL; i++) {
-                                raytmxState->object->properties[i] = propertiesIterator->property;
-                                RaytmxPropertyNode* propertiesTemp = propertiesIterator;
-                                propertiesIterator = propertiesIterator->next;
-                                MemFree(propertiesTemp);
-                            }
                         }
                     }
                 } else
@@ -2752,19 +3266,16 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             TmxObject* object = raytmxState->object;
             TmxText* objectText = object->text;
             if (hoxmlContext->content != NULL) { /* If the element had content e.g. <text>Content here</text> */
-                objectText->content = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->content) + 1);
-                StringCopy(objectText->content, hoxmlContext->content);
+                objectText->content = ArenaStringCopy(raytmxState->arena, hoxmlContext->content);
             }
 
             if (objectText->fontFamily == NULL) { /* If this <text> didn't have a 'fontfamily' attribute */
                 /* The default value for 'fontfamily' is "sans-serif" */
-                objectText->fontFamily = (char*)MemAllocZero((unsigned int)strlen("sans-serif") + 1);
-                StringCopy(objectText->fontFamily, "sans-serif");
+                objectText->fontFamily = ArenaStringCopy(raytmxState->arena, "sans-serif");
             }
 
             if (objectText->content != NULL) { /* If there's text to be drawn */
-                RaytmxTextLineNode *linesRoot = NULL, *linesTail = NULL;
-                uint32_t linesLength = 0;
+                RaytmxBuffer linesBuffer = { 0 }; /* TmxTextLine */
 
                 /* There's some aligning and allocating to be done in order to draw the text. This isn't something */
                 /* that should be done per-draw and, given the text is static, can be done ahead of time. */
@@ -2774,18 +3285,18 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 unsigned int bufferLength = (unsigned int)strlen(objectText->content) + 1;
                 /* This buffer will hold hold subsets of the content while iterating through it. The string in this */
                 /* buffer may exceed the bounds. */
-                char* testingBuffer = (char*)MemAllocZero(bufferLength);
+                char* testingBuffer = (char*)ArenaAllocZero(raytmxState->scratch, bufferLength);
                 /* This one will hold the last known good string whose graphical text would fit within the bounds */
-                char* validBuffer = (char*)MemAllocZero(bufferLength);
+                char* validBuffer = (char*)ArenaAllocZero(raytmxState->scratch, bufferLength);
                 /* This one will hold space-delimited subsets of the above */
-                char* delimtedBuffer = (char*)MemAllocZero(bufferLength);
+                char* delimtedBuffer = (char*)ArenaAllocZero(raytmxState->scratch, bufferLength);
                 bool isDelimited = false;
 
                 char *start = objectText->content, *end = start, *validEnd = start, *delimitedEnd = start;
                 /* While the 'end' iterator hasn't reached the end of the content AND further lines will fit within */
                 /* the Y bounds of the object */
                 while (*end != '\0' &&
-                        object->y + (objectText->pixelSize * (linesLength + 1)) <= object->y + object->height) {
+                        object->y + (objectText->pixelSize * (linesBuffer.length + 1)) <= object->y + object->height) {
                     end++;
                     int length = (int)(end - start);
                     if (length <= 0) /* Quick error check for a case that is hopefully impossible in practice */
@@ -2844,22 +3355,13 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                         /* incremented at the start of the next loop. */
                         end = start;
 
-                        TmxTextLine line;
-                        line.content = (char*)MemAllocZero((unsigned int)strlen(sourceBuffer) + 1);
-                        StringCopy(line.content, sourceBuffer);
-                        line.font = font;
-                        line.spacing = spacing;
+                        TmxTextLine* line = (TmxTextLine*)BufferAppend(raytmxState->scratch, &linesBuffer, 1,
+                            sizeof(TmxTextLine));
+                        line->content = ArenaStringCopy(raytmxState->arena, sourceBuffer);
+                        line->font = font;
+                        line->spacing = spacing;
                         /* Note: The number of lines is not yet known but needs to be for Y positioning */
 
-                        RaytmxTextLineNode* node = (RaytmxTextLineNode*)MemAllocZero(sizeof(RaytmxTextLineNode));
-                        node->line = line;
-                        if (linesRoot == NULL)
-                            linesRoot = node;
-                        else
-                            linesTail->next = node;
-                        linesTail = node;
-                        linesLength += 1;
-
                         /* Reset variables */
                         memset(testingBuffer, '\0', bufferLength);
                         memset(validBuffer, '\0', bufferLength);
@@ -2873,19 +3375,14 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                         }
                     } /* textSize.x > object->width || *end == '\0' */
                 } /* *end != '\0' && */
-                  /* object->y + (objectText->pixelSize * (linesLength + 1)) <= object->y + object->height */
-
-                MemFree(testingBuffer);
-                MemFree(validBuffer);
-                MemFree(delimtedBuffer);
+                  /* object->y + (objectText->pixelSize * (linesBuffer.length + 1)) <= object->y + object->height */
 
-                if (linesRoot != NULL) {
-                    /* Allocate the array and zero out every value as initialization */
-                    TmxTextLine* lines = (TmxTextLine*)MemAllocZero(sizeof(TmxTextLine) * linesLength);
-                    /* Copy the TmxTextLines into the array and free the nodes while we're at it */
-                    RaytmxTextLineNode* iterator = linesRoot;
+                uint32_t linesLength = linesBuffer.length;
+                if (linesLength > 0) {
+                    /* Copy the TmxTextLines into an array of the exact size. The buffer is in the scratch arena. */
+                    TmxTextLine* lines = (TmxTextLine*)BufferCopy(raytmxState->arena, &linesBuffer,
+                        sizeof(TmxTextLine));
                     for (uint32_t i = 0; i < linesLength; i++) {
-                        lines[i] = iterator->line;
                         Vector2 textSize = MeasureTextEx(font, lines[i].content,
                             (float)objectText->pixelSize, lines[i].spacing);
 
@@ -2919,7 +3416,8 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                                     (uint32_t)floor((idealNumAdditionalSpaces - (float)numSpaces) / (float)numSpaces);
                                 /* Create a new string with the additional space */
                                 size_t justifiedLength = length + (numSpacesToAddPer * numSpaces);
-                                char* justifiedContent = (char*)MemAllocZero((unsigned int)justifiedLength + 1);
+                                char* justifiedContent = (char*)ArenaAllocZero(raytmxState->arena,
+                                    justifiedLength + 1);
                                 uint32_t sourceIndex = 0, destinationIndex = 0;
                                 while (lines[i].content[sourceIndex] != '\0') {
                                     justifiedContent[destinationIndex++] = lines[i].content[sourceIndex];
@@ -2932,8 +3430,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                                     }
                                     sourceIndex++;
                                 }
-                                /* Free the original content buffer and replace it with the justified one */
-                                MemFree(lines[i].content);
+                                /* Replace the original content buffer with the justified one */
                                 lines[i].content = justifiedContent;
                                 length = justifiedLength;
                             }
@@ -2957,10 +3454,6 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                                 (float)(objectText->pixelSize * (i + 1));
                         } else /* if (objectText->valign == VERTICAL_ALIGNMENT_TOP) */
                             lines[i].position.y = (float)object->y + (float)(objectText->pixelSize * i);
-
-                        RaytmxTextLineNode* parent = iterator;
-                        iterator = iterator->next;
-                        MemFree(parent);
                     }
                     /* Add the lines array to the text object */
                     objectText->lines = lines;
@@ -2979,223 +3472,6 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
     }
 }
 
-void FreeStateLayers(RaytmxLayerNode* layers) {
-    RaytmxLayerNode *layersIterator = layers, *layersTemp;
-    while (layersIterator != NULL) {
-        /* Group layers may have children, forming a tree-like structure. Free the children. */
-        FreeStateLayers(layersIterator->childrenRoot);
-        /* Iterate to the next node and free this one */
-        layersTemp = layersIterator;
-        layersIterator = layersIterator->next;
-        MemFree(layersTemp);
-    }
-}
-
-void FreeState(RaytmxState* raytmxState) {
-    if (raytmxState == NULL)
-        return;
-
-    /* Clear the caches. These allow for quick lookups of previously-loaded textures and object templates. They */
-    /* aren't needed once loading is complete. */
-    RaytmxCachedTextureNode *cachedTextureIterator = raytmxState->texturesRoot, *cachedTextureTemp;
-    while (cachedTextureIterator != NULL) {
-        cachedTextureTemp = cachedTextureIterator;
-        cachedTextureIterator = cachedTextureIterator->next;
-        if (cachedTextureTemp->fileName != NULL) /* Just in case. Should always be set. */
-            MemFree(cachedTextureTemp->fileName);
-        MemFree(cachedTextureTemp);
-    }
-    raytmxState->texturesRoot = NULL;
-    RaytmxCachedTemplateNode *cachedTemplateIterator = raytmxState->templatesRoot, *cachedTemplateTemp;
-    while (cachedTemplateIterator != NULL) {
-        cachedTemplateTemp = cachedTemplateIterator;
-        cachedTemplateIterator = cachedTemplateIterator->next;
-        FreeObject(cachedTemplateTemp->objectTemplate.object);
-        if (cachedTemplateTemp->fileName != NULL) /* Just in case. Should always be set. */
-            MemFree(cachedTemplateTemp->fileName);
-        MemFree(cachedTemplateTemp);
-    }
-    raytmxState->templatesRoot = NULL;
-
-    raytmxState->property = NULL;
-    raytmxState->tileset = NULL;
-    raytmxState->image = NULL;
-    raytmxState->tilesetTile = NULL;
-    raytmxState->animationFrame = NULL;
-    /* raytmxState->wangSet = NULL; */ /* TODO:  Wang sets. Low priority. */
-    /* raytmxState->wangColor = NULL; */ /* TODO:  Wang sets. Low priority. */
-    raytmxState->layer = NULL;
-    raytmxState->tileLayer = NULL;
-    raytmxState->objectGroup = NULL;
-    raytmxState->imageLayer = NULL;
-    raytmxState->object = NULL;
-
-    /* Free each property in the linked list of properties */
-    RaytmxPropertyNode *propertiesIterator = raytmxState->propertiesRoot, *propertiesTemp;
-    while (propertiesIterator != NULL) {
-        propertiesTemp = propertiesIterator;
-        propertiesIterator = propertiesIterator->next;
-        MemFree(propertiesTemp);
-    }
-    /* Zeroize this linked list's properties */
-    raytmxState->propertiesRoot = NULL;
-    raytmxState->propertiesTail = NULL;
-    raytmxState->propertiesLength = 0;
-
-    /* Free each node in the linked list of tilesets */
-    RaytmxTilesetNode *tilesetsIterator = raytmxState->tilesetsRoot, *tilesetsTemp;
-    while (tilesetsIterator != NULL) {
-        tilesetsTemp = tilesetsIterator;
-        tilesetsIterator = tilesetsIterator->next;
-        MemFree(tilesetsTemp);
-    }
-    /* Zeroize this linked list's properties */
-    raytmxState->tilesetsRoot = NULL;
-    raytmxState->tilesetsTail = NULL;
-    raytmxState->tilesetsLength = 0;
-
-    /* Free each node in the linked list of tileset tiles */
-    RaytmxTilesetTileNode *tilesetTilesIterator = raytmxState->tilesetTilesRoot, *tilesetTilesTemp;
-    while (tilesetTilesIterator != NULL) {
-        tilesetTilesTemp = tilesetTilesIterator;
-        tilesetTilesIterator = tilesetTilesIterator->next;
-        MemFree(tilesetTilesTemp);
-    }
-    /* Zeroize this linked list's properties */
-    raytmxState->tilesetTilesRoot = NULL;
-    raytmxState->tilesetTilesTail = NULL;
-    raytmxState->tilesetTilesLength = 0;
-
-    /* Free each node in the linked list of animation frames */
-    RaytmxAnimationFrameNode *animationFramesIterator = raytmxState->animationFramesRoot, *animationFramesTemp;
-    while (animationFramesIterator != NULL) {
-        animationFramesTemp = animationFramesIterator;
-        animationFramesIterator = animationFramesIterator->next;
-        MemFree(animationFramesTemp);
-    }
-    /* Zeroize this linked list's properties */
-    raytmxState->animationFramesRoot = NULL;
-    raytmxState->animationFramesTail = NULL;
-    raytmxState->animationFramesLength = 0;
-
-    /* Layers may be groups. The resulting collection isn't a link list as much as it is a tree. So freeing layers is */
-    /* best done with a recursive approach. */
-    FreeStateLayers(raytmxState->layersRoot);
-    /* Zeroize this linked list's properties */
-    raytmxState->layersRoot = NULL;
-    raytmxState->layersTail = NULL;
-    raytmxState->layersLength = 0;
-
-    /* Free each node in the linked list of layer tiles */
-    RaytmxTileLayerTileNode *layerTilesIterator = raytmxState->layerTilesRoot, *layerTilesTemp;
-    while (layerTilesIterator != NULL) {
-        layerTilesTemp = layerTilesIterator;
-        layerTilesIterator = layerTilesIterator->next;
-        MemFree(layerTilesTemp);
-    }
-    /* Zeroize this linked list's properties */
-    raytmxState->layerTilesRoot = NULL;
-    raytmxState->layerTilesTail = NULL;
-    raytmxState->layerTilesLength = 0;
-
-    /* Free each node in the linked list of objects */
-    RaytmxObjectNode *objectsIterator = raytmxState->objectsRoot, *objectsTemp;
-    while (objectsIterator != NULL) {
-        objectsTemp = objectsIterator;
-        objectsIterator = objectsIterator->next;
-        MemFree(objectsTemp);
-    }
-    /* Zeroize this linked list's properties */
-    raytmxState->objectsRoot = NULL;
-    raytmxState->objectsTail = NULL;
-    raytmxState->objectsLength = 0;
-}
-
-void inline FreeString(char* str) {
-    if (str != NULL)
-        MemFree(str);
-}
-
-void FreeTileset(TmxTileset tileset) {
-    FreeString(tileset.source);
-    FreeString(tileset.name);
-    FreeString(tileset.classString);
-    if (tileset.hasImage) {
-        FreeString(tileset.image.source);
-        UnloadTexture(tileset.image.texture);
-    }
-    if (tileset.properties != NULL) {
-        for (uint32_t i = 0; i < tileset.propertiesLength; i++)
-            FreeProperty(tileset.properties[i]);
-        MemFree(tileset.properties);
-    }
-    for (uint32_t i = 0; i < tileset.tilesLength; i++) {
-        TmxTilesetTile tile = tileset.tiles[i];
-        if (tile.hasImage) {
-            FreeString(tile.image.source);
-            UnloadTexture(tile.image.texture);
-            if (tile.properties != NULL) {
-                for (uint32_t j = 0; j < tile.propertiesLength; j++)
-                    FreeProperty(tile.properties[j]);
-                MemFree(tile.properties);
-            }
-        }
-        if (tile.hasAnimation && tile.animation.frames != NULL)
-            MemFree(tile.animation.frames);
-    }
-}
-
-void FreeProperty(TmxProperty property) {
-    FreeString(property.name);
-    FreeString(property.stringValue);
-}
-
-void FreeLayer(TmxLayer layer) {
-    FreeString(layer.name);
-    FreeString(layer.classString);
-    if (layer.properties != NULL) {
-        for (uint32_t i = 0; i < layer.propertiesLength; i++)
-            FreeProperty(layer.properties[i]);
-        MemFree(layer.properties);
-    }
-    switch (layer.type) {
-    case LAYER_TYPE_TILE_LAYER:
-        FreeString(layer.exact.tileLayer.encoding);
-        FreeString(layer.exact.tileLayer.compression);
-        MemFree(layer.exact.tileLayer.tiles);
-    break;
-    case LAYER_TYPE_OBJECT_GROUP:
-        for (uint32_t j = 0; j < layer.exact.objectGroup.objectsLength; j++)
-            FreeObject(layer.exact.objectGroup.objects[j]);
-        MemFree(layer.exact.objectGroup.objects);
-    break;
-    case LAYER_TYPE_IMAGE_LAYER:
-        if (layer.exact.imageLayer.hasImage)
-            UnloadTexture(layer.exact.imageLayer.image.texture);
-    break;
-    case LAYER_TYPE_GROUP: break; /* Nothing to do for this case but compilers like to complain */
-    }
-    /* <group> layers are expected to have child layers, or child <group>s, so recursively free them too */
-    for (uint32_t i = 0; i < layer.layersLength; i++)
-        FreeLayer(layer.layers[i]);
-}
-
-void FreeObject(TmxObject object) {
-    FreeString(object.name);
-    FreeString(object.typeString);
-    FreeString(object.templateString);
-    if (object.points != NULL)
-        MemFree(object.points);
-    if (object.text != NULL) {
-        if (object.text->lines != NULL) {
-            for (uint32_t j = 0; j < object.text->linesLength; j++)
-                FreeString(object.text->lines[j].content);
-            MemFree(object.text->lines);
-        } /* object.text->lines != NULL */
-        MemFree(object.text);
-    } /* object.text != NULL */
-}
-
 #define SIGN(x) (x < 0 ? -1 : +1)
 
 /**
@@ -3240,6 +3516,9 @@ bool IterateTileLayer(const TmxMap* map, const TmxTileLayer* layer, Rectangle sc
     static int currentX = 0; /* Current tile X position (column) within the iteration */
     static int currentY = 0; /* Current tile Y position (row) within the iteration */
 
+    if (map != NULL && map->tileWidth > 0 && map->tileHeight > 0 && layer != NULL && layer->chunksLength > 0)
+        return IterateChunkedTileLayer(map, layer, screenRect, rawGid, tile, tileRect);
+
     if (map == NULL || map->width == 0 || map->height == 0 || map->tileWidth == 0 || map->tileHeight == 0 ||
             layer == NULL || layer->tilesLength == 0)
         return false;
@@ -3334,18 +3613,345 @@ bool IterateTileLayer(const TmxMap* map, const TmxTileLayer* layer, Rectangle sc
     return true;
 }
 
-void DrawTMXTileLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint) {
-    if (map == NULL || layer.type != LAYER_TYPE_TILE_LAYER || layer.exact.tileLayer.tilesLength == 0)
+void UpdateLayerChunks(TmxMap* map, TmxLayer* layers, uint32_t layersLength, Rectangle area) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        if (layers[i].type == LAYER_TYPE_GROUP) {
+            UpdateLayerChunks(map, layers[i].layers, layers[i].layersLength, area);
+            continue;
+        }
+        if (layers[i].type != LAYER_TYPE_TILE_LAYER)
+            continue;
+
+        TmxTileLayer* tileLayer = &layers[i].exact.tileLayer;
+        for (uint32_t j = 0; j < tileLayer->chunksLength; j++) {
+            TmxChunk* chunk = &tileLayer->chunks[j];
+            Rectangle chunkRect;
+            chunkRect.x = (float)(chunk->x * (int32_t)map->tileWidth);
+            chunkRect.y = (float)(chunk->y * (int32_t)map->tileHeight);
+            chunkRect.width = (float)(chunk->width * map->tileWidth);
+            chunkRect.height = (float)(chunk->height * map->tileHeight);
+            if (!CheckCollisionRecs(area, chunkRect)) /* If the chunk isn't needed */
+                continue;
+
+            chunk->lastUsed = map->chunkClock;
+            if (chunk->tiles != NULL) /* If the chunk is already resident */
+                continue;
+
+            uint32_t tilesLength = chunk->width * chunk->height;
+            uint32_t gidsLength;
+            uint32_t* gids = DecodeTileData(chunk->data, tileLayer->encoding, tileLayer->compression,
+                layers[i].name, &gidsLength);
+            /* Resident chunks always have exactly width * height tiles so drawing and collision never bounds check */
+            chunk->tiles = (uint32_t*)MemAlloc(sizeof(uint32_t) * tilesLength);
+            memset(chunk->tiles, 0, sizeof(uint32_t) * tilesLength);
+            if (gids != NULL) {
+                memcpy(chunk->tiles, gids, sizeof(uint32_t) * (gidsLength < tilesLength ? gidsLength : tilesLength));
+                MemFree(gids);
+            }
+            map->chunkBytes += sizeof(uint32_t) * tilesLength;
+        }
+    }
+}
+
+TmxChunk* FindLeastRecentChunk(TmxLayer* layers, uint32_t layersLength, uint32_t clock, TmxChunk* oldest) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        if (layers[i].type == LAYER_TYPE_GROUP)
+            oldest = FindLeastRecentChunk(layers[i].layers, layers[i].layersLength, clock, oldest);
+        else if (layers[i].type == LAYER_TYPE_TILE_LAYER) {
+            TmxTileLayer* tileLayer = &layers[i].exact.tileLayer;
+            for (uint32_t j = 0; j < tileLayer->chunksLength; j++) {
+                TmxChunk* chunk = &tileLayer->chunks[j];
+                if (chunk->tiles != NULL && chunk->lastUsed != clock &&
+                        (oldest == NULL || chunk->lastUsed < oldest->lastUsed))
+                    oldest = chunk;
+            }
+        }
+    }
+    return oldest;
+}
+
+void UnloadChunks(TmxLayer* layers, uint32_t layersLength) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        if (layers[i].type == LAYER_TYPE_GROUP)
+            UnloadChunks(layers[i].layers, layers[i].layersLength);
+        else if (layers[i].type == LAYER_TYPE_TILE_LAYER) {
+            TmxTileLayer* tileLayer = &layers[i].exact.tileLayer;
+            for (uint32_t j = 0; j < tileLayer->chunksLength; j++) {
+                if (tileLayer->chunks[j].tiles != NULL)
+                    MemFree(tileLayer->chunks[j].tiles);
+                tileLayer->chunks[j].tiles = NULL;
+            }
+        }
+    }
+}
+
+/**
+ * Counterpart of IterateTileLayer() for the chunks of an infinite map's tile layer. Only resident chunks, those
+ * decoded by UpdateChunksTMX(), are iterated. Tiles are provided chunk by chunk, row by row, regardless of the map's
+ * render order.
+ */
+bool IterateChunkedTileLayer(const TmxMap* map, const TmxTileLayer* layer, Rectangle screenRect, uint32_t* rawGid,
+        TmxTile* tile, Rectangle* tileRect) {
+    /* Static variables whose values will persist between calls. These are needed to initialize and iterate. */
+    static const TmxTileLayer* currentLayer = NULL; /* Tile layer being iterated */
+    static uint32_t chunkIndex = 0; /* Index of the chunk being iterated */
+    static bool needsChunk = true; /* When true, the next overlapping, resident chunk must be found */
+    static int32_t fromX = 0, fromY = 0, toX = 0, toY = 0; /* Range of tiles, relative to the chunk, to iterate */
+    static int32_t currentX = 0, currentY = 0; /* Current tile position relative to the chunk */
+
+    if (currentLayer != layer) { /* If the layer has changed (i.e. iteration should initialize) */
+        currentLayer = layer;
+        chunkIndex = 0;
+        needsChunk = true;
+    } else if (currentX < toX) /* If still iterating through the current row */
+        currentX += 1;
+    else if (currentY < toY) { /* If the end of the current row was reached */
+        currentX = fromX;
+        currentY += 1;
+    } else { /* If the end of the chunk was reached */
+        chunkIndex += 1;
+        needsChunk = true;
+    }
+
+    /* The range of tiles, in map coordinates, that overlap with the screen rectangle */
+    int32_t screenFromX = (int32_t)floorf(screenRect.x / (float)map->tileWidth);
+    int32_t screenFromY = (int32_t)floorf(screenRect.y / (float)map->tileHeight);
+    int32_t screenToX = (int32_t)floorf((screenRect.x + screenRect.width) / (float)map->tileWidth);
+    int32_t screenToY = (int32_t)floorf((screenRect.y + screenRect.height) / (float)map->tileHeight);
+    for (; needsChunk && chunkIndex < layer->chunksLength; chunkIndex++) {
+        const TmxChunk* chunk = &layer->chunks[chunkIndex];
+        if (chunk->tiles == NULL) /* If the chunk isn't resident */
+            continue;
+        fromX = (screenFromX > chunk->x ? screenFromX : chunk->x) - chunk->x;
+        fromY = (screenFromY > chunk->y ? screenFromY : chunk->y) - chunk->y;
+        toX = (screenToX < chunk->x + (int32_t)chunk->width - 1 ? screenToX : chunk->x + (int32_t)chunk->width - 1) -
+            chunk->x;
+        toY = (screenToY < chunk->y + (int32_t)chunk->height - 1 ? screenToY : chunk->y + (int32_t)chunk->height - 1) -
+            chunk->y;
+        if (fromX <= toX && fromY <= toY) { /* If the chunk overlaps with the screen rectangle */
+            currentX = fromX;
+            currentY = fromY;
+            needsChunk = false;
+            break;
+        }
+    }
+    if (needsChunk) { /* If there are no more chunks to iterate */
+        currentLayer = NULL;
+        chunkIndex = 0;
+        fromX = fromY = toX = toY = currentX = currentY = 0;
+        return false;
+    }
+
+    const TmxChunk* chunk = &layer->chunks[chunkIndex];
+    uint32_t localRawGid = chunk->tiles[((uint32_t)currentY * chunk->width) + (uint32_t)currentX];
+    if (rawGid != NULL)
+        *rawGid = localRawGid;
+    if (tile != NULL) {
+        uint32_t gid = GetGid(localRawGid, NULL, NULL, NULL, NULL);
+        if (gid < map->gidsToTilesLength)
+            *tile = map->gidsToTiles[gid];
+        else
+            memset(tile, 0, sizeof(TmxTile));
+    }
+    if (tileRect != NULL) {
+        tileRect->x = (float)((chunk->x + currentX) * (int32_t)map->tileWidth);
+        tileRect->y = (float)((chunk->y + currentY) * (int32_t)map->tileHeight);
+        tileRect->width = (float)map->tileWidth;
+        tileRect->height = (float)map->tileHeight;
+    }
+
+    return true;
+}
+
+/**
+ * Helper function that determines the area, in world coordinates, visible through the given camera.
+ * The size of the framebuffer being drawn to is used rather than the size of the screen, so drawing into a
+ * RenderTexture2D smaller than the screen, within BeginTextureMode(), culls to the texture's size. A size given to
+ * SetViewportTMX() takes precedence.
+ *
+ * @param camera (Optional) camera through which the framebuffer is seen.
+ * @return The visible area, or the framebuffer's own area if there is no camera.
+ */
+Rectangle GetScreenRect(const Camera2D* camera) {
+    Rectangle screenRect;
+    screenRect.x = 0.0f;
+    screenRect.y = 0.0f;
+    screenRect.width = (float)(tmxViewportWidth > 0 ? tmxViewportWidth : rlGetFramebufferWidth());
+    screenRect.height = (float)(tmxViewportHeight > 0 ? tmxViewportHeight : rlGetFramebufferHeight());
+    if (camera != NULL) {
+        screenRect.width /= camera->zoom;
+        screenRect.height /= camera->zoom;
+        screenRect.x = camera->target.x - (screenRect.width / 2.0f);
+        screenRect.y = camera->target.y - (screenRect.height / 2.0f);
+    }
+    return screenRect;
+}
+
+void DrawTMXTileLayer(const TmxMap* map, Rectangle screenRect, const TmxLayer* layer, int posX, int posY,
+        Color tint) {
+    if (map == NULL || map->gidsToDraws == NULL || layer->type != LAYER_TYPE_TILE_LAYER ||
+            (layer->exact.tileLayer.tilesLength == 0 && layer->exact.tileLayer.chunksLength == 0) || tint.a == 0)
         return;
 
-    /* Iterate through each tile that the screen rectangle overlaps with */
+    /* Tiles are iterated in the layer's own coordinates so the screen rectangle is moved into them. This matters for */
+    /* layers drawn away from the origin, such as layers with offsets or maps placed within a world. */
+    screenRect.x -= (float)posX;
+    screenRect.y -= (float)posY;
+
+    /* Iterate through each tile that the screen rectangle overlaps with. The iteration is the only culling needed. */
     uint32_t rawGid;
     Rectangle tileRect;
-    while (IterateTileLayer(/* map: */ map, /* layer: */ &layer.exact.tileLayer, /* screenRect: */ screenRect,
+    while (IterateTileLayer(/* map: */ map, /* layer: */ &layer->exact.tileLayer, /* screenRect: */ screenRect,
             /* rawGid: */ &rawGid, /* tile: */ NULL, /* tileRect: */ &tileRect)) {
-        DrawTMXLayerTile(/* map: */ map, /* screenRect: */ screenRect, /* rawGid: */ rawGid,
-                         /* posX: */ posX + (int)tileRect.x, /* posY: */ posY + (int)tileRect.y, /* tint: */ tint);
+        DrawTMXLayerTile(/* map: */ map, /* rawGid: */ rawGid, /* posX: */ posX + (int)tileRect.x,
+                         /* posY: */ posY + (int)tileRect.y, /* tint: */ tint);
+    }
+}
+
+void DrawTMXTileLayerGpu(const TmxMap* map, Rectangle screenRect, const TmxLayer* layer, int posX, int posY,
+        Color tint) {
+    if (map == NULL || map->gpuRenderer == NULL || layer->type != LAYER_TYPE_TILE_LAYER || tint.a == 0)
+        return;
+
+    const RaytmxGpuRenderer* renderer = map->gpuRenderer;
+    const TmxTileLayer* tileLayer = &layer->exact.tileLayer;
+
+    /* Only the part of the layer that's on the screen is covered by the quad, no matter how many tiles that is */
+    Rectangle layerRect;
+    layerRect.x = (float)posX;
+    layerRect.y = (float)posY;
+    layerRect.width = (float)(tileLayer->width * map->tileWidth);
+    layerRect.height = (float)(tileLayer->height * map->tileHeight);
+    Rectangle drawRect = GetCollisionRec(screenRect, layerRect);
+    if (drawRect.width <= 0.0f || drawRect.height <= 0.0f) /* If the layer isn't on the screen */
+        return;
+
+    float layerSize[2] = { (float)tileLayer->width, (float)tileLayer->height };
+    float tileSize[2] = { (float)map->tileWidth, (float)map->tileHeight };
+    float atlasSize[2] = { (float)tileLayer->atlasTexture.width, (float)tileLayer->atlasTexture.height };
+    float time = (float)GetTime(); /* Animation frame durations are in seconds */
+
+    BeginShaderMode(renderer->shader);
+    SetShaderValue(renderer->shader, renderer->layerSizeLoc, layerSize, SHADER_UNIFORM_VEC2);
+    SetShaderValue(renderer->shader, renderer->tileSizeLoc, tileSize, SHADER_UNIFORM_VEC2);
+    SetShaderValue(renderer->shader, renderer->atlasSizeLoc, atlasSize, SHADER_UNIFORM_VEC2);
+    SetShaderValue(renderer->shader, renderer->timeLoc, &time, SHADER_UNIFORM_FLOAT);
+    SetShaderValueTexture(renderer->shader, renderer->gidsLoc, tileLayer->gidsTexture);
+    SetShaderValueTexture(renderer->shader, renderer->tileTableLoc, renderer->tileTable);
+
+    /* The texture coordinates are the drawn area's position within the layer, from 0.0 to 1.0 */
+    float u0 = (drawRect.x - layerRect.x) / layerRect.width;
+    float v0 = (drawRect.y - layerRect.y) / layerRect.height;
+    float u1 = (drawRect.x + drawRect.width - layerRect.x) / layerRect.width;
+    float v1 = (drawRect.y + drawRect.height - layerRect.y) / layerRect.height;
+
+    rlSetTexture(tileLayer->atlasTexture.id);
+    rlBegin(RL_QUADS);
+    {
+        rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+        rlNormal3f(0.0f, 0.0f, 1.0f); /* Normal vector pointing towards viewer */
+
+        rlTexCoord2f(u0, v0); /* Top-left corner of the quad */
+        rlVertex2f(drawRect.x, drawRect.y);
+        rlTexCoord2f(u0, v1); /* Bottom-left corner of the quad */
+        rlVertex2f(drawRect.x, drawRect.y + drawRect.height);
+        rlTexCoord2f(u1, v1); /* Bottom-right corner of the quad */
+        rlVertex2f(drawRect.x + drawRect.width, drawRect.y + drawRect.height);
+        rlTexCoord2f(u1, v0); /* Top-right corner of the quad */
+        rlVertex2f(drawRect.x + drawRect.width, drawRect.y);
     }
+    rlEnd();
+    rlSetTexture(0);
+    EndShaderMode(); /* Draws the quad while the GIDs and tile table are still bound */
+}
+
+uint32_t CountTileLayers(const TmxLayer* layers, uint32_t layersLength) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < layersLength; i++) {
+        if (layers[i].type == LAYER_TYPE_TILE_LAYER)
+            count += 1;
+        else if (layers[i].type == LAYER_TYPE_GROUP)
+            count += CountTileLayers(layers[i].layers, layers[i].layersLength);
+    }
+    return count;
+}
+
+void LoadGidsTextures(TmxMap* map, const uint32_t* gidAtlases, TmxLayer* layers, uint32_t layersLength) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        if (layers[i].type == LAYER_TYPE_GROUP) {
+            LoadGidsTextures(map, gidAtlases, layers[i].layers, layers[i].layersLength);
+            continue;
+        }
+        if (layers[i].type != LAYER_TYPE_TILE_LAYER)
+            continue;
+
+        TmxTileLayer* tileLayer = &layers[i].exact.tileLayer;
+        if (tileLayer->width == 0 || tileLayer->height == 0 || tileLayer->width > RAYTMX_GPU_MAX_TEXTURE_SIZE ||
+                tileLayer->height > RAYTMX_GPU_MAX_TEXTURE_SIZE ||
+                tileLayer->tilesLength != tileLayer->width * tileLayer->height)
+            continue;
+
+        /* The shader samples one texture so every tile in the layer must come from the same one */
+        uint32_t atlas = 0;
+        bool isDrawable = true;
+        for (uint32_t j = 0; j < tileLayer->tilesLength && isDrawable; j++) {
+            uint32_t gid = GetGid(tileLayer->tiles[j], NULL, NULL, NULL, NULL);
+            if (gid >= map->gidsToTilesLength || gidAtlases[gid] == 0) /* If the GID isn't drawn by either renderer */
+                continue;
+            if (gidAtlases[gid] == UINT32_MAX || (atlas != 0 && gidAtlases[gid] != atlas))
+                isDrawable = false;
+            atlas = gidAtlases[gid];
+        }
+        if (!isDrawable || atlas == 0)
+            continue;
+
+        for (uint32_t j = 0; j < map->texturesLength; j++) {
+            if (map->textures[j].id == atlas)
+                tileLayer->atlasTexture = map->textures[j];
+        }
+
+        /* Each raw GID's four bytes become a texel's red, green, blue, and alpha values, in that order, on the */
+        /* little-endian platforms raylib runs on. The shader reassembles them, flip flags included. */
+        Image gidsImage;
+        gidsImage.data = tileLayer->tiles;
+        gidsImage.width = (int)tileLayer->width;
+        gidsImage.height = (int)tileLayer->height;
+        gidsImage.mipmaps = 1;
+        gidsImage.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+        tileLayer->gidsTexture = LoadTextureFromImage(gidsImage);
+        map->gpuRenderer->gidsTextures[map->gpuRenderer->gidsTexturesLength] = tileLayer->gidsTexture;
+        map->gpuRenderer->gidsTexturesLength += 1;
+    }
+}
+
+uint32_t GetGidAtlas(const TmxMap* map, uint32_t gid) {
+    /* Returns the ID of the texture the tile is drawn from, zero if the GID is unknown and won't be drawn by either */
+    /* renderer, or UINT32_MAX if the tile can only be drawn tile by tile */
+    if (gid == 0 || gid >= map->gidsToTilesLength || map->gidsToTiles[gid].gid == 0)
+        return 0;
+
+    TmxTile tile = map->gidsToTiles[gid];
+    if (tile.hasAnimation) { /* Every frame must be drawable and from the same texture */
+        if (tile.animation.framesLength == 0 || tile.animation.framesLength > RAYTMX_GPU_MAX_FRAMES)
+            return UINT32_MAX;
+        uint32_t atlas = 0;
+        for (uint32_t i = 0; i < tile.animation.framesLength; i++) {
+            uint32_t frameGid = tile.gid + tile.animation.frames[i].id;
+            if (frameGid >= map->gidsToTilesLength || map->gidsToTiles[frameGid].hasAnimation)
+                return UINT32_MAX;
+            uint32_t frameAtlas = GetGidAtlas(map, frameGid);
+            if (frameAtlas == 0 || frameAtlas == UINT32_MAX || (atlas != 0 && frameAtlas != atlas))
+                return UINT32_MAX;
+            atlas = frameAtlas;
+        }
+        return atlas;
+    }
+
+    /* The shader draws every tile at the map's tile size with no offset */
+    if (tile.texture.id == 0 || tile.sourceRect.width != (float)map->tileWidth ||
+            tile.sourceRect.height != (float)map->tileHeight || tile.offset.x != 0.0f || tile.offset.y != 0.0f)
+        return UINT32_MAX;
+    return tile.texture.id;
 }
 
 void DrawTextureTile(Texture2D texture, Rectangle source, Rectangle dest, bool flipX, bool flipY, bool flipDiag,
@@ -3445,52 +4051,83 @@ void DrawTextureTile(Texture2D texture, Rectangle source, Rectangle dest, bool f
     rlSetTexture(0);
 }
 
-void DrawTMXLayerTile(const TmxMap* map, Rectangle screenRect, uint32_t rawGid, int posX, int posY, Color tint) {
-    if (map == NULL || tint.a == 0)
-        return;
+void BuildTileDraws(TmxMap* map) {
+    RaytmxTileDraw* draws = (RaytmxTileDraw*)ArenaAllocZero(map->arena,
+        sizeof(RaytmxTileDraw) * map->gidsToTilesLength);
 
-    bool isFlippedHorizontally, isFlippedVertically, isFlippedDiagonally, isRotatedHexagonal120;
-    /* Tile Global IDs (GIDs) can have several bit flags that indicate transforms. This function is used to both get */
-    /* those possible transform flags as well as the actual GID value without those bit flags. */
-    uint32_t gid = GetGid(rawGid, &isFlippedHorizontally, &isFlippedVertically, &isFlippedDiagonally,
-        &isRotatedHexagonal120);
+    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++) {
+        const TmxTile* tile = &map->gidsToTiles[gid];
+        if (tile->gid == 0) /* If the GID is not known to exist in any tilesets within the map */
+            continue; /* Leave the record zeroed so it's never drawn */
+
+        if (tile->hasAnimation) {
+            /* Animations aren't really tiles. Instead, they contain frames that identify a tile to draw for the */
+            /* duration of that frame. The 'gid' of an animation tile is assigned with the first GID of the tileset */
+            /* and the frames have local IDs within that tileset so the frame's GID is their sum. AnimateTMX() keeps */
+            /* this current. */
+            if (tile->animation.framesLength > 0) {
+                uint32_t frameGid = tile->gid + tile->animation.frames[tile->frameIndex].id;
+                draws[gid].animationGid = frameGid < map->gidsToTilesLength ? frameGid : 0;
+            }
+            continue;
+        }
+        if (tile->texture.id == 0 || tile->texture.width == 0 || tile->texture.height == 0)
+            continue;
+
+        /* Normalize the source rectangle now so drawing doesn't divide by the texture's dimensions for every tile */
+        draws[gid].u[0] = tile->sourceRect.x / (float)tile->texture.width;
+        draws[gid].u[1] = (tile->sourceRect.x + tile->sourceRect.width) / (float)tile->texture.width;
+        draws[gid].v[0] = tile->sourceRect.y / (float)tile->texture.height;
+        draws[gid].v[1] = (tile->sourceRect.y + tile->sourceRect.height) / (float)tile->texture.height;
+        /* raylib's coordinates consider [x, y] to be the top-left corner of the rectangle being drawn. The TMX */
+        /* documentation complicates things a bit saying "Larger tiles will extend at the top and right (anchored to */
+        /* the bottom left)" meaning that TMX considers [x, y] to be the bottom-left corner. The simplest way to */
+        /* reconcile the Y coordinate differences is to substract the texture's height at Y + 1. This way, tiles */
+        /* larger than the map's tile height values will be drawn further up (negative Y direction). */
+        draws[gid].offsetX = tile->offset.x;
+        draws[gid].offsetY = tile->offset.y + (float)map->tileHeight - tile->sourceRect.height;
+        draws[gid].width = tile->sourceRect.width;
+        draws[gid].height = tile->sourceRect.height;
+        draws[gid].textureId = tile->texture.id;
+    }
+
+    map->gidsToDraws = draws;
+}
+
+void DrawTMXLayerTile(const TmxMap* map, uint32_t rawGid, int posX, int posY, Color tint) {
+    /* Remove the flip flags to get the actual GID value */
+    uint32_t gid = rawGid & ~(uint32_t)(FLIP_FLAG_HORIZONTAL | FLIP_FLAG_VERTICAL | FLIP_FLAG_DIAGONAL |
+        FLIP_FLAG_ROTATE_120);
     if (gid >= map->gidsToTilesLength) /* If the GID is outside the range of known GIDs */
-        return; /* Do not attempt to draw this time */
-    /* With the GID, grab the relevant tile information (texture, animation, etc.) from the global mapping */
-    TmxTile tile = map->gidsToTiles[gid];
-    if (tile.gid == 0) /* If the GID is not known to exist in any tilesets within the map */
         return; /* Do not attempt to draw this tile */
+    const RaytmxTileDraw* draw = &map->gidsToDraws[gid];
+    if (draw->animationGid != 0) /* If the tile is an animation, draw its current frame with the same flip flags */
+        draw = &map->gidsToDraws[draw->animationGid];
+    if (draw->textureId == 0) /* If the GID is unknown or has nothing to draw */
+        return;
 
-    if (tile.hasAnimation) {
-        /* Animations aren't really tiles. Instead, they contain frames that identify a tile to draw for the duration */
-        /* of that frame. */
-        /* The 'gid' of an animation tile is assigned with the first GID of the tileset and the frames have local IDs */
-        /* within that tileset. The GID of the frame, then, can be calculated by adding them together. */
-        gid = tile.gid + tile.animation.frames[tile.frameIndex].id;
-        /* Copy any flip flags that may be present in the layer data. */
-        gid |= rawGid & (FLIP_FLAG_HORIZONTAL | FLIP_FLAG_VERTICAL | FLIP_FLAG_DIAGONAL | FLIP_FLAG_ROTATE_120);
-        /* Draw the tile using the calculated GID of the frame, along with the possible flags. */
-        DrawTMXLayerTile(map, screenRect, gid, posX, posY, tint);
-    } else {
-        /* Determine where the tile will be drawn. raylib's coordinates consider [x, y] to be the top-left corner of */
-        /* the rectangle being drawn. The TMX documentation complicates things a bit saying "Larger tiles will extend */
-        /* at the top and right (anchored to the bottom left)" meaning that TMX considers [x, y] to be the */
-        /* bottom-left corner. The simplest way to reconcile the Y coordinate differences is to substract the */
-        /* texture's height at Y + 1. This way, tiles larger than the map's tile height values will be drawn further */
-        /* up (negative Y direction). */
-        Rectangle destRect;
-        destRect.x = posX + tile.offset.x;
-        destRect.y = posY + tile.offset.y + map->tileHeight - tile.sourceRect.height;
-        destRect.width = tile.sourceRect.width;
-        destRect.height = tile.sourceRect.height;
+    /* The horizontal, vertical, and diagonal flags are the GID's three most significant bits */
+    const unsigned char* corners = tmxFlipCorners[rawGid >> 29];
+    float left = (float)posX + draw->offsetX, top = (float)posY + draw->offsetY;
+    float right = left + draw->width, bottom = top + draw->height;
 
-        /* If the screen and destination rectangles are overlapping to any degree (i.e. if the tile is visible) */
-        if (CheckCollisionRecs(screenRect, destRect)) {
-            DrawTextureTile(/* texture: */ tile.texture, /* source: */ tile.sourceRect, /* dest: */ destRect,
-                /* flipX: */ isFlippedHorizontally, /* flipY: */ isFlippedVertically,
-                /* flipDiag: */ isFlippedDiagonally, /* tint: */ tint);
-        }
+    rlSetTexture(draw->textureId);
+    rlBegin(RL_QUADS);
+    {
+        rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+        rlNormal3f(0.0f, 0.0f, 1.0f); /* Normal vector pointing towards viewer */
+
+        rlTexCoord2f(draw->u[corners[0] & 1], draw->v[corners[0] >> 1]); /* Top-left corner of the quad */
+        rlVertex2f(left, top);
+        rlTexCoord2f(draw->u[corners[1] & 1], draw->v[corners[1] >> 1]); /* Bottom-left corner of the quad */
+        rlVertex2f(left, bottom);
+        rlTexCoord2f(draw->u[corners[2] & 1], draw->v[corners[2] >> 1]); /* Bottom-right corner of the quad */
+        rlVertex2f(right, bottom);
+        rlTexCoord2f(draw->u[corners[3] & 1], draw->v[corners[3] >> 1]); /* Top-right corner of the quad */
+        rlVertex2f(right, top);
     }
+    rlEnd();
+    rlSetTexture(0);
 }
 
 void DrawTMXObjectTile(const TmxMap* map, Rectangle screenRect, uint32_t rawGid, int posX, int posY, float width,
@@ -3513,7 +4150,8 @@ void DrawTMXObjectTile(const TmxMap* map, Rectangle screenRect, uint32_t rawGid,
     if (tile.hasAnimation) {
         /* Animations aren't really tiles. Instead, they contain frames that identify a tile to draw for the duration */
         /* of that frame. That current tile should be drawn. */
-        DrawTMXLayerTile(map, screenRect, tile.gid + tile.animation.frames[tile.frameIndex].id, posX, posY, tint);
+        DrawTMXObjectTile(map, screenRect, tile.gid + tile.animation.frames[tile.frameIndex].id, posX, posY, width,
+            height, tint);
     } else {
         /* Determine the area in which to draw, and potentially stretch, the texture. This area matches that of the */
         /* <object>, not the tile size. This also means that the Y coordinate needs consideration because raylib */
@@ -3533,83 +4171,84 @@ void DrawTMXObjectTile(const TmxMap* map, Rectangle screenRect, uint32_t rawGid,
     }
 }
 
-void DrawTMXObjectGroup(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint) {
-    if (map == NULL || layer.type != LAYER_TYPE_OBJECT_GROUP || tint.a == 0)
+void DrawTMXObjectGroup(const TmxMap* map, Rectangle screenRect, const TmxLayer* layer, int posX, int posY,
+        Color tint) {
+    if (map == NULL || layer->type != LAYER_TYPE_OBJECT_GROUP || tint.a == 0)
         return;
 
-    TmxObjectGroup objectGroup = layer.exact.objectGroup;
-    for (int32_t i = 0; i < (int32_t)objectGroup.objectsLength; i++) {
+    const TmxObjectGroup* objectGroup = &layer->exact.objectGroup;
+    for (int32_t i = 0; i < (int32_t)objectGroup->objectsLength; i++) {
         /* Select the object to draw based on the <objectgroup>'s draw order */
-        TmxObject object;
-        if (objectGroup.drawOrder == OBJECT_GROUP_DRAW_ORDER_INDEX)
-            object = objectGroup.objects[i];
-        else /* if (objectGroup.drawOrder == OBJECT_GROUP_DRAW_ORDER_TOP_DOWN) */
-            object = objectGroup.objects[objectGroup.ySortedObjects[i]];
+        const TmxObject* object;
+        if (objectGroup->drawOrder == OBJECT_GROUP_DRAW_ORDER_INDEX)
+            object = &objectGroup->objects[i];
+        else /* if (objectGroup->drawOrder == OBJECT_GROUP_DRAW_ORDER_TOP_DOWN) */
+            object = &objectGroup->objects[objectGroup->ySortedObjects[i]];
 
-        if (object.type == OBJECT_TYPE_TILE) { /* If the object is a tile with an abitrary GID and dimensions */
+        if (object->type == OBJECT_TYPE_TILE) { /* If the object is a tile with an abitrary GID and dimensions */
             /* Note: This draw method handles occlusion culling so it doesn't need to be done here */
-            DrawTMXObjectTile(map, /* screenRect: */ screenRect, /* rawGid: */ object.gid,
-                /* posX: */ posX + (int)object.x, /* posY: */ posY + (int)object.y, /* width: */ (float)object.width,
-                /* height: */ (float)object.height, /* color: */ tint);
+            DrawTMXObjectTile(map, /* screenRect: */ screenRect, /* rawGid: */ object->gid,
+                /* posX: */ posX + (int)object->x, /* posY: */ posY + (int)object->y, /* width: */ (float)object->width,
+                /* height: */ (float)object->height, /* color: */ tint);
         } else { /* If the object is any type other than a tile */
-            Rectangle offsetAabb = object.aabb;
+            Rectangle offsetAabb = object->aabb;
             offsetAabb.x += posX;
             offsetAabb.y += posY;
             /* If the screen rectangle and the polygon's AABB are overlapping to any degree (i.e. it is visible) */
             if (CheckCollisionRecs(screenRect, offsetAabb)) {
-                switch (object.type) {
+                switch (object->type) {
                 case OBJECT_TYPE_RECTANGLE:
-                    DrawRectangle(/* posX: */ posX + (int)object.x, /* posY: */ posY + (int)object.y,
-                        /* width: */ (int)object.width, /* height: */ (int)object.height,
-                        /* color: */ objectGroup.color);
+                    DrawRectangle(/* posX: */ posX + (int)object->x, /* posY: */ posY + (int)object->y,
+                        /* width: */ (int)object->width, /* height: */ (int)object->height,
+                        /* color: */ objectGroup->color);
                 break;
                 case OBJECT_TYPE_ELLIPSE:
                 {
                     /* The width and height of the object are used here as the semi major and minor axes */
-                    float halfWidth = (float)object.width / 2.0f, halfHeight = (float)object.height / 2.0f;
-                    DrawEllipse(/* centerX: */ posX + (int)(object.x + halfWidth),
-                        /* centerY: */ posY + (int)(object.y + halfHeight), /* radiusH: */ halfWidth,
-                        /* radiusV: */ halfHeight, /* color: */ objectGroup.color);
+                    float halfWidth = (float)object->width / 2.0f, halfHeight = (float)object->height / 2.0f;
+                    DrawEllipse(/* centerX: */ posX + (int)(object->x + halfWidth),
+                        /* centerY: */ posY + (int)(object->y + halfHeight), /* radiusH: */ halfWidth,
+                        /* radiusV: */ halfHeight, /* color: */ objectGroup->color);
                 }
                 break;
                 case OBJECT_TYPE_POINT:
-                DrawCircle(/* centerX: */ (int)object.x, /* centerY: */ (int)object.y,
-                    /* radius: */ (float)map->tileWidth / 4.0f, /* color: */ objectGroup.color);
+                DrawCircle(/* centerX: */ (int)object->x, /* centerY: */ (int)object->y,
+                    /* radius: */ (float)map->tileWidth / 4.0f, /* color: */ objectGroup->color);
                 break;
                 case OBJECT_TYPE_POLYGON:
                 case OBJECT_TYPE_POLYLINE:
                     /* Copy the 'points' array to the 'drawPoints' array and apply the drawing position, an offset */
                     /* applied by the layer and/or draw call. The 'drawPoints' array was allocated at the same time */
                     /* as 'points' with the same size. This improves draw call times by reducing memory allocations. */
-                    memcpy(object.drawPoints, object.points, sizeof(Vector2) * object.pointsLength);
-                    for (uint32_t i = 0; i < object.pointsLength; i++) {
+                    memcpy(object->drawPoints, object->points, sizeof(Vector2) * object->pointsLength);
+                    for (uint32_t i = 0; i < object->pointsLength; i++) {
                         /* Polygons' and polyglines' vertices are stored with relative positions. To get the absolute */
                         /* position needed for drawing, just add the object's position and offset. */
-                        object.drawPoints[i].x += (float)object.x + (float)posX;
-                        object.drawPoints[i].y += (float)object.y + (float)posY;
+                        object->drawPoints[i].x += (float)object->x + (float)posX;
+                        object->drawPoints[i].y += (float)object->y + (float)posY;
                     }
                     /* Use the offset points to draw the poly(gon|line) */
-                    if (object.type == OBJECT_TYPE_POLYGON) {
+                    if (object->type == OBJECT_TYPE_POLYGON) {
                         /* Note: Polygons' first elements are their centroids. DrawTriangleFan() requires this. */
                         /* And, the last element in 'drawPoints' is a duplicate of the first, non-centroid point. */
-                        DrawTriangleFan(/* points: */ object.drawPoints, /* pointCount: */ object.pointsLength,
-                            /* color: */ objectGroup.color);
-                    } else /* if (object.type == OBJECT_TYPE_POLYLINE) */ {
+                        DrawTriangleFan(/* points: */ object->drawPoints, /* pointCount: */ object->pointsLength,
+                            /* color: */ objectGroup->color);
+                    } else /* if (object->type == OBJECT_TYPE_POLYLINE) */ {
                         /* Note: The last element in 'drawPoints' is a duplicate of the first point */
-                        for (uint32_t i = 1; i < object.pointsLength; i++) {
-                            DrawLineEx(/* startPos: */ object.drawPoints[i - 1], /* endPos: */ object.drawPoints[i],
-                                /* thick: */ TMX_LINE_THICKNESS, /* color: */ objectGroup.color);
+                        for (uint32_t i = 1; i < object->pointsLength; i++) {
+                            DrawLineEx(/* startPos: */ object->drawPoints[i - 1], /* endPos: */ object->drawPoints[i],
+                                /* thick: */ TMX_LINE_THICKNESS, /* color: */ objectGroup->color);
                         }
                     }
                 break;
                 case OBJECT_TYPE_TEXT:
-                    for (uint32_t i = 0; i < object.text->linesLength; i++) {
-                        Vector2 position = object.text->lines[i].position;
+                    for (uint32_t i = 0; i < object->text->linesLength; i++) {
+                        Vector2 position = object->text->lines[i].position;
                         position.x += posX;
                         position.y += posY;
-                        DrawTextEx(/* font: */ object.text->lines[i].font, /* text: */ object.text->lines[i].content,
-                            /* position: */ position, /* fontSize: */ (float)object.text->pixelSize,
-                            /* spacing: */ object.text->lines[i].spacing, /* tint: */ object.text->color);
+                        DrawTextEx(/* font: */ object->text->lines[i].font, /* text: */ object->text->lines[i].content,
+                            /* position: */ position, /* fontSize: */ (float)object->text->pixelSize,
+                            /* spacing: */ object->text->lines[i].spacing, /* tint: */ object->text->color);
                     }
                 break;
                 case OBJECT_TYPE_TILE:
@@ -3622,22 +4261,23 @@ void DrawTMXObjectGroup(const TmxMap* map, Rectangle screenRect, TmxLayer layer,
     }
 }
 
-void DrawTMXImageLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint) {
-    if (map == NULL || layer.type != LAYER_TYPE_IMAGE_LAYER || !layer.exact.imageLayer.hasImage ||
-            layer.exact.imageLayer.image.width == 0 || layer.exact.imageLayer.image.height == 0 || tint.a == 0)
+void DrawTMXImageLayer(const TmxMap* map, Rectangle screenRect, const TmxLayer* layer, int posX, int posY,
+        Color tint) {
+    if (map == NULL || layer->type != LAYER_TYPE_IMAGE_LAYER || !layer->exact.imageLayer.hasImage ||
+            layer->exact.imageLayer.image.width == 0 || layer->exact.imageLayer.image.height == 0 || tint.a == 0)
         return;
 
-    TmxImageLayer imageLayer = layer.exact.imageLayer;
+    const TmxImageLayer* imageLayer = &layer->exact.imageLayer;
     /* Determine where the image of this image layer would be drawn, assuming no repetitions */
     Rectangle imageRect;
     imageRect.x = (float)posX;
     imageRect.y = (float)posY;
-    imageRect.width = (float)imageLayer.image.width;
-    imageRect.height = (float)imageLayer.image.height;
+    imageRect.width = (float)imageLayer->image.width;
+    imageRect.height = (float)imageLayer->image.height;
 
-    if (!imageLayer.repeatX && !imageLayer.repeatY && CheckCollisionRecs(screenRect, imageRect)) /* If visible */
-        DrawTexture(/* texture: */ imageLayer.image.texture, /* posX: */ posX, /* posY: */ posY, /* tint: */ tint);
-    else if (imageLayer.repeatX || imageLayer.repeatY) { /* If the image might be drawn across a whole axis, or both */
+    if (!imageLayer->repeatX && !imageLayer->repeatY && CheckCollisionRecs(screenRect, imageRect)) /* If visible */
+        DrawTexture(/* texture: */ imageLayer->image.texture, /* posX: */ posX, /* posY: */ posY, /* tint: */ tint);
+    else if (imageLayer->repeatX || imageLayer->repeatY) { /* If the image might be drawn across a whole axis or both */
         /* Use integer division to determine the X and Y positions at which a the image would appear if it were */
         /* repeated across the whole axis (i.e. if "Repeat X" and/or "Repeat Y" are enabled) */
         int coefficientX = (int)(screenRect.x - imageRect.x) / (int)imageRect.width;
@@ -3645,50 +4285,50 @@ void DrawTMXImageLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer,
         float x0 = imageRect.x + (imageRect.width * (float)coefficientX); /* Initial X position */
         float y0 = imageRect.y + (imageRect.height * (float)coefficientY); /* Initial Y position */
 
-        if (imageLayer.repeatX) /* If repeating along the X axis */
+        if (imageLayer->repeatX) /* If repeating along the X axis */
             imageRect.x = x0; /* Move the image's representative rectangle to that X */
-        if (imageLayer.repeatY)
+        if (imageLayer->repeatY)
             imageRect.y = y0;
         if (CheckCollisionRecs(screenRect, imageRect)) { /* If the repeating image would be visible in the screen */
             /* Take a step back on each axis that the image repeats on. This ensures we don't leave any empty space */
             /* along the left and/or top edge of the screen. */
-            if (imageLayer.repeatX)
+            if (imageLayer->repeatX)
                 x0 -= imageRect.width;
-            if (imageLayer.repeatY)
+            if (imageLayer->repeatY)
                 y0 -= imageRect.height;
 
             /* Create some unchanging objects that the draw function will need */
             Rectangle sourceRect; /* Region within the texture to be drawn. We'll use the whole texture. */
             sourceRect.x = 0.0f;
             sourceRect.y = 0.0f;
-            sourceRect.width = (float)imageLayer.image.width;
-            sourceRect.height = (float)imageLayer.image.height;
+            sourceRect.width = (float)imageLayer->image.width;
+            sourceRect.height = (float)imageLayer->image.height;
             Vector2 origin; /* Reference point used for rotations. We're not rotating so we'll just use all zeroes. */
             origin.x = 0.0f;
             origin.y = 0.0f;
 
-            if (imageLayer.repeatX && imageLayer.repeatY) { /* If repeating on both axes */
+            if (imageLayer->repeatX && imageLayer->repeatY) { /* If repeating on both axes */
                 /* Loop over both the X and Y axes to draw an array of repeated images */
                 for (float x = x0; x <= screenRect.x + screenRect.width; x += imageRect.width) {
                     for (float y = y0; y <= screenRect.y + screenRect.height; y += imageRect.height) {
                         imageRect.x = x;
                         imageRect.y = y;
-                        DrawTexturePro(/* texture: */ imageLayer.image.texture, /* source: */ sourceRect,
+                        DrawTexturePro(/* texture: */ imageLayer->image.texture, /* source: */ sourceRect,
                             /* dest: */ imageRect, /* origin: */ origin, /* rotation: */ 0.0f, /* tint: */ tint);
                     }
                 }
-            } else if (imageLayer.repeatX) { /* If repeating on just the X axis */
+            } else if (imageLayer->repeatX) { /* If repeating on just the X axis */
                 /* Loop over just the X axis to draw a horizontal line of repeated images */
                 for (float x = x0; x <= screenRect.x + screenRect.width; x += imageRect.width) {
                     imageRect.x = x;
-                    DrawTexturePro(/* texture: */ imageLayer.image.texture, /* source: */ sourceRect,
+                    DrawTexturePro(/* texture: */ imageLayer->image.texture, /* source: */ sourceRect,
                         /* dest: */ imageRect, /* origin: */ origin, /* rotation: */ 0.0f, /* tint: */ tint);
                 }
-            } else if (imageLayer.repeatY) { /* If repeating on just the Y axis */
+            } else if (imageLayer->repeatY) { /* If repeating on just the Y axis */
                 /* Loop over just the Y axis to draw a vertical line of repeated images */
                 for (float y = y0; y <= screenRect.y + screenRect.height; y += imageRect.height) {
                     imageRect.y = y;
-                    DrawTexturePro(/* texture: */ imageLayer.image.texture, /* source: */ sourceRect,
+                    DrawTexturePro(/* texture: */ imageLayer->image.texture, /* source: */ sourceRect,
                         /* dest: */ imageRect, /* origin: */ origin, /* rotation: */ 0.0f, /* tint: */ tint);
                 }
             }
@@ -3953,15 +4593,45 @@ bool CheckCollisionTMXTileLayerObject(const TmxMap* map, const TmxLayer* layers,
  * @return True if an object in the object group collides with the given object, or false if there is no collision.
  */
 bool CheckCollisionTMXObjectGroupObject(TmxObjectGroup group, TmxObject object, TmxObject* outputObject) {
-    for (size_t i = 0; i < group.objectsLength; i++) {
-        if (CheckCollisionTMXObjects(group.objects[i], object)) {
-            if (outputObject != NULL)
-                *outputObject = group.objects[i];
-            return true;
+    if (group.objectsLength > 0 && group.boxMinX == NULL) { /* If the group wasn't bucketed, i.e. wasn't loaded */
+        for (size_t i = 0; i < group.objectsLength; i++) {
+            if (CheckCollisionTMXObjects(group.objects[i], object)) {
+                if (outputObject != NULL)
+                    *outputObject = group.objects[i];
+                return true;
+            }
         }
+        return false;
     }
 
-    return false;
+    /* The first object, in the order of 'objects,' that collides is the one reported. Boxes are checked in batches */
+    /* and the other objects one at a time, both in ascending order, so each stops at its first collision and the */
+    /* other objects stop early at any box that collided before them. */
+    bool isObjectBox = object.type == OBJECT_TYPE_RECTANGLE || object.type == OBJECT_TYPE_ELLIPSE ||
+        object.type == OBJECT_TYPE_TEXT || object.type == OBJECT_TYPE_TILE;
+    uint32_t collided = UINT32_MAX; /* Index in 'objects' of the first object found to collide */
+    for (uint32_t first = 0; first < group.boxesLength && collided == UINT32_MAX; first += RAYTMX_BOX_BATCH) {
+        for (uint64_t hits = CheckCollisionTMXBoxesRec(&group, first, object.aabb); hits != 0; hits &= hits - 1) {
+            uint32_t index = group.boxObjects[first + LowestSetBit(hits)];
+            /* Two boxes whose AABBs collide collide, other shapes need the full check */
+            if (isObjectBox || CheckCollisionTMXObjects(group.objects[index], object)) {
+                collided = index;
+                break;
+            }
+        }
+    }
+    for (uint32_t i = 0; i < group.otherObjectsLength && group.otherObjects[i] < collided; i++) {
+        if (CheckCollisionTMXObjects(group.objects[group.otherObjects[i]], object)) {
+            collided = group.otherObjects[i];
+            break;
+        }
+    }
+
+    if (collided == UINT32_MAX)
+        return false;
+    if (outputObject != NULL)
+        *outputObject = group.objects[collided];
+    return true;
 }
 
 void TraceLogTMXTilesets(int logLevel, TmxOrientation orientation, TmxTileset* tilesets, uint32_t tilesetsLength,
@@ -4318,94 +4988,180 @@ void TraceLogTMXObject(int logLevel, TmxObject object, int numSpaces) {
 }
 
 TmxProperty* AddProperty(RaytmxState* raytmxState) {
-    RaytmxPropertyNode* node = (RaytmxPropertyNode*)MemAllocZero(sizeof(RaytmxPropertyNode));
-
-    if (raytmxState->propertiesRoot == NULL)
-        raytmxState->propertiesRoot = node;
-    else
-        raytmxState->propertiesTail->next = node;
-    raytmxState->propertiesTail = node;
-    raytmxState->propertiesLength += 1;
-
-    return &node->property;
+    return (TmxProperty*)BufferAppend(raytmxState->scratch, &raytmxState->properties, 1, sizeof(TmxProperty));
 }
 
 void AddTileLayerTile(RaytmxState* raytmxState, uint32_t gid) {
-    RaytmxTileLayerTileNode* node = (RaytmxTileLayerTileNode*)MemAllocZero(sizeof(RaytmxTileLayerTileNode));
-    node->gid = gid;
-
-    if (raytmxState->layerTilesRoot == NULL)
-        raytmxState->layerTilesRoot = node;
-    else
-        raytmxState->layerTilesTail->next = node;
-    raytmxState->layerTilesTail = node;
-    raytmxState->layerTilesLength += 1;
+    uint32_t* tile = (uint32_t*)BufferAppend(raytmxState->scratch, &raytmxState->layerTiles, 1, sizeof(uint32_t));
+    *tile = gid;
 }
 
-TmxTileset* AddTileset(RaytmxState* raytmxState) {
-    RaytmxTilesetNode* node = (RaytmxTilesetNode*)MemAllocZero(sizeof(RaytmxTilesetNode));
+void AddTileLayerTiles(RaytmxState* raytmxState, const unsigned char* gids, uint32_t count) {
+    if (count == 0)
+        return;
 
-    if (raytmxState->tilesetsRoot == NULL)
-        raytmxState->tilesetsRoot = node;
-    else
-        raytmxState->tilesetsTail->next = node;
-    raytmxState->tilesetsTail = node;
-    raytmxState->tilesetsLength += 1;
+    /* The GIDs are unsigned, 32-bit integers that may not be aligned within the decoded data so they're copied as */
+    /* bytes, in one go */
+    void* tiles = BufferAppend(raytmxState->scratch, &raytmxState->layerTiles, count, sizeof(uint32_t));
+    memcpy(tiles, gids, sizeof(uint32_t) * count);
+}
 
-    return &node->tileset;
+TmxChunk* AddChunk(RaytmxState* raytmxState) {
+    return (TmxChunk*)BufferAppend(raytmxState->scratch, &raytmxState->layerChunks, 1, sizeof(TmxChunk));
 }
 
-TmxTilesetTile* AddTilesetTile(RaytmxState* raytmxState) {
-    RaytmxTilesetTileNode* node = (RaytmxTilesetTileNode*)MemAllocZero(sizeof(RaytmxTilesetTileNode));
+uint32_t* DecodeTileData(const char* content, const char* encoding, const char* compression, const char* layerName,
+        uint32_t* gidsLength) {
+    /* Returns the decoded GIDs in an array allocated with MemAlloc(), to be released with MemFree(), or NULL if */
+    /* there were none or they couldn't be decoded */
+    *gidsLength = 0;
+    if (content == NULL || encoding == NULL)
+        return NULL;
 
-    if (raytmxState->tilesetTilesRoot == NULL)
-        raytmxState->tilesetTilesRoot = node;
-    else
-        raytmxState->tilesetTilesTail->next = node;
-    raytmxState->tilesetTilesTail = node;
-    raytmxState->tilesetTilesLength += 1;
+    uint32_t* gids = NULL;
+    if (strcmp(encoding, "base64") == 0) {
+        /* The layer's data is a series of unsigned, 32-bit integers encoded as a Base64 string. But, XML considers */
+        /* everything between <data> and </data> to be content meaning there is probably some whitespace on both */
+        /* ends of the content we need to ignore. So, find the actual start and stop: */
+        const char *encodedStart = content, *encodedEnd;
+        while (isspace(*encodedStart))
+            encodedStart++;
+        if (*encodedStart == '\0')
+            return NULL;
+        encodedEnd = encodedStart + strlen(encodedStart) - 1;
+        while (encodedEnd > encodedStart && isspace(*encodedEnd))
+            encodedEnd--;
+
+        /* With the string of encoded Base64 data trimmed, decode it */
+        int decodedLength;
+        unsigned char* decoded = DecodeDataBase64((const unsigned char*)encodedStart, &decodedLength);
+        if (decoded == NULL) {
+            TraceLog(LOG_ERROR, "RAYTMX: Unable to decode Base64 data for layer \"%s\"", layerName);
+            return NULL;
+        }
+
+        const unsigned char* bytes = NULL; /* Uncompressed bytes where every four bytes is a single GID */
+        int bytesLength = 0;
+        unsigned char* decompressed = NULL;
+        if (compression == NULL) { /* If the Base64-encoded data is uncompressed */
+            bytes = decoded;
+            bytesLength = decodedLength;
+        } else if (strcmp(compression, "gzip") == 0 || strcmp(compression, "zlib") == 0) {
+            unsigned char* postHeaderDecoded = NULL;
+            if (strcmp(compression, "gzip") == 0) {
+                /* The first two bytes of a GZIP header are expected to be a magic number, 0x1F8B, identifying the */
+                /* format and the third is expected to indicate the compression method where 0x08 is DEFLATE. */
+                /* If these values are found, decompression can continue */
+                if (decodedLength > 10 && decoded[0] == 0x1F && decoded[1] == 0x8B && decoded[2] == 0x08) {
+                    /* Skip past the GZIP header. The header is typically ten bytes. The bytes not checked are */
+                    /* unimportant things like a timestamp and OS ID. Additional optional headers are possible but */
+                    /* not used by Tiled so they are assumed to be missing. */
+                    postHeaderDecoded = decoded + 10;
+                } else { /* If the GZIP header doesn't match a decompressable one */
+                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses GZIP compression but the stream's header doesn't "
+                        "indicate DEFLATE compression", layerName);
+                }
+            } else /* if (strcmp(compression, "zlib") == 0) */ {
+                /* The first byte of a ZLIB header is expected to be 0x78 where the 8 indicates the DEFLATE */
+                /* compression method and the 7 is "compression info" that indicates a 32K LZ77 window size and, in */
+                /* practice, cannot be anything else. */
+                /* If these values are found, decompression can continue */
+                if (decodedLength > 2 && decoded[0] == 0x78) {
+                    /* Skip past the ZLIB header. The header is two bytes. */
+                    postHeaderDecoded = decoded + 2;
+                } else { /* If the ZLIB header doesn't match a decompressable one */
+                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses ZLIB compression but the stream's header doesn't "
+                        "indicate DEFLATE compression", layerName);
+                }
+            }
+
+            if (postHeaderDecoded != NULL) {
+                /* "zlib" and "gzip" both use the DEFLATE algorithm and raylib provides a decompression function */
+                /* when it's built with SUPPORT_COMPRESSION_API (default) */
+                decompressed = DecompressData(postHeaderDecoded, decodedLength - (int)(postHeaderDecoded - decoded),
+                    &bytesLength);
+                if (decompressed != NULL && bytesLength > 0)
+                    bytes = decompressed;
+                else { /* raylib wasn't built with compression or allocation failed */
+                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" compressed with \"%s\" cannot be parsed because "
+                        "DEFLATE decompression failed - either raylib was not built with SUPPORT_COMPRESSION_API or "
+                        "memory allocation failed", layerName, compression);
+                }
+            }
+        } else {
+            TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" cannot be parsed because the compression method \"%s\" is "
+                "unsupported", layerName, compression);
+        }
+
+        if (bytes != NULL && bytesLength >= 4) {
+            /* N bytes with every four bytes being a single GID result in N / 4 tiles. The GIDs may not be aligned */
+            /* within the decoded data so they're copied as bytes, in one go. */
+            *gidsLength = (uint32_t)bytesLength / 4;
+            gids = (uint32_t*)MemAlloc(sizeof(uint32_t) * *gidsLength);
+            memcpy(gids, bytes, sizeof(uint32_t) * *gidsLength);
+        }
+        if (decompressed != NULL)
+            MemFree(decompressed); /* Free the memory allocated by DecompressData() */
+        MemFree(decoded); /* Free the memory allocated by DecodeDataBase64() */
+    } /* strcmp(encoding, "base64") == 0 */
+    else if (strcmp(encoding, "csv") == 0) {
+        /* The Comma-Separated Value (CSV) list herein is a series of Global IDs (GIDs) of tiles in the form */
+        /* "31,32,33" where 31, 32, and 33 are GIDs. Counting the commas gives the most GIDs there can be. */
+        uint32_t capacity = 1;
+        for (const char* iterator = content; *iterator != '\0'; iterator++) {
+            if (*iterator == ',')
+                capacity += 1;
+        }
+        gids = (uint32_t*)MemAlloc(sizeof(uint32_t) * capacity);
+        const char* iterator = content;
+        while (*gidsLength < capacity) {
+            while (isspace(*iterator) || *iterator == ',') /* Skip the separators and any surrounding whitespace */
+                iterator++;
+            if (*iterator == '\0') /* If the end of the string was reached */
+                break;
+            char* valueEnd;
+            /* Read the value as an unsigned integer GID. GIDs with flip flags don't fit in a signed integer. */
+            gids[*gidsLength] = (uint32_t)strtoul(iterator, &valueEnd, 10);
+            if (valueEnd == iterator) /* If the character isn't part of a number */
+                break;
+            *gidsLength += 1;
+            iterator = valueEnd;
+        }
+        if (*gidsLength == 0) {
+            MemFree(gids);
+            gids = NULL;
+        }
+    } /* strcmp(encoding, "csv") == 0 */
 
-    return &node->tile;
+    return gids;
 }
 
-TmxAnimationFrame* AddAnimationFrame(RaytmxState* raytmxState) {
-    RaytmxAnimationFrameNode* node = (RaytmxAnimationFrameNode*)MemAllocZero(sizeof(RaytmxAnimationFrameNode));
+TmxTileset* AddTileset(RaytmxState* raytmxState) {
+    return (TmxTileset*)BufferAppend(raytmxState->scratch, &raytmxState->tilesets, 1, sizeof(TmxTileset));
+}
 
-    if (raytmxState->animationFramesRoot == NULL)
-        raytmxState->animationFramesRoot = node;
-    else
-        raytmxState->animationFramesTail->next = node;
-    raytmxState->animationFramesTail = node;
-    raytmxState->animationFramesLength += 1;
+TmxTilesetTile* AddTilesetTile(RaytmxState* raytmxState) {
+    return (TmxTilesetTile*)BufferAppend(raytmxState->scratch, &raytmxState->tilesetTiles, 1,
+        sizeof(TmxTilesetTile));
+}
 
-    return &node->frame;
+TmxAnimationFrame* AddAnimationFrame(RaytmxState* raytmxState) {
+    return (TmxAnimationFrame*)BufferAppend(raytmxState->scratch, &raytmxState->animationFrames, 1,
+        sizeof(TmxAnimationFrame));
 }
 
 TmxLayer* AddGenericLayer(RaytmxState* raytmxState, bool isGroup) {
-    RaytmxLayerNode* node = (RaytmxLayerNode*)MemAllocZero(sizeof(RaytmxLayerNode));
+    /* If the layer is being appended to a <group>, it's added to the group's children. Otherwise, there is no */
+    /* <group> to append to, meaning the layer belongs to the top-level <map>. */
+    RaytmxBuffer* layers = raytmxState->groupNode != NULL ? &raytmxState->groupNode->children : &raytmxState->layers;
+    RaytmxLayerNode* node = (RaytmxLayerNode*)BufferAppend(raytmxState->scratch, layers, 1, sizeof(RaytmxLayerNode));
+    node->parent = raytmxState->groupNode;
     /* There are some non-zero default values for several layer attributes: */
     node->layer.opacity = 1.0;
     node->layer.visible = true;
     node->layer.parallaxX = 1.0;
     node->layer.parallaxY = 1.0;
 
-    if (raytmxState->groupNode != NULL) { /* If the layer is being appended to a <group> */
-        node->parent = raytmxState->groupNode;
-        if (raytmxState->groupNode->childrenRoot == NULL) /* If the layer is the first in the group */
-            raytmxState->groupNode->childrenRoot = node;
-        else
-            raytmxState->groupNode->childrenTail->next = node;
-        raytmxState->groupNode->childrenTail = node;
-        raytmxState->groupNode->childrenLength += 1;
-    } else { /* If there is no <group> to append to, meaning the layer belongs to the top-level <map> */
-        if (raytmxState->layersRoot == NULL) /* If the layer is the first in the map */
-            raytmxState->layersRoot = node;
-        else
-            raytmxState->layersTail->next = node;
-        raytmxState->layersTail = node;
-        raytmxState->layersLength += 1;
-    }
-
     if (isGroup)
         raytmxState->groupNode = node;
 
@@ -4413,63 +5169,130 @@ TmxLayer* AddGenericLayer(RaytmxState* raytmxState, bool isGroup) {
 }
 
 TmxObject* AddObject(RaytmxState* raytmxState) {
-    RaytmxObjectNode* node = (RaytmxObjectNode*)MemAllocZero(sizeof(RaytmxObjectNode));
+    TmxObject* object = (TmxObject*)BufferAppend(raytmxState->scratch, &raytmxState->objects, 1, sizeof(TmxObject));
     /* <object> elements have one non-zero default value: */
-    node->object.visible = true;
+    object->visible = true;
 
-    if (raytmxState->objectsRoot == NULL)
-        raytmxState->objectsRoot = node;
-    else
-        raytmxState->objectsTail->next = node;
-    raytmxState->objectsTail = node;
-    raytmxState->objectsLength += 1;
-
-    return &node->object;
+    return object;
 }
 
-void AppendLayerTo(TmxMap* map, RaytmxLayerNode* groupNode, RaytmxLayerNode* layersRoot, uint32_t layersLength) {
-    if (map == NULL || layersRoot == NULL || layersLength == 0)
+void AppendLayerTo(TmxMap* map, TmxLayer* groupLayer, const RaytmxBuffer* layerNodes) {
+    if (map == NULL || layerNodes == NULL || layerNodes->length == 0)
         return;
 
-    TmxLayer* groupLayer = NULL;
-    if (groupNode != NULL)
-        groupLayer = &(groupNode->layer);
-
     /* Allocate the array and zerioze every index as initialization */
-    TmxLayer* layers = (TmxLayer*)MemAllocZero(sizeof(TmxLayer) * layersLength);
+    TmxLayer* layers = (TmxLayer*)ArenaAllocZero(map->arena, sizeof(TmxLayer) * layerNodes->length);
     /* Copy the TmxLayers into the array */
-    RaytmxLayerNode* layersIterator = layersRoot;
-    for (uint32_t i = 0; layersIterator != NULL; i++) {
-        if (layersIterator->childrenRoot != NULL)
-            AppendLayerTo(map, layersIterator, layersIterator->childrenRoot, layersIterator->childrenLength);
-        layers[i] = layersIterator->layer;
-        layersIterator = layersIterator->next;
+    RaytmxLayerNode* nodes = (RaytmxLayerNode*)layerNodes->data;
+    for (uint32_t i = 0; i < layerNodes->length; i++) {
+        layers[i] = nodes[i].layer;
+        if (nodes[i].children.length > 0)
+            AppendLayerTo(map, &layers[i], &nodes[i].children);
     }
 
     if (groupLayer != NULL) { /* If the list of layers is being appended to a group */
         groupLayer->layers = layers;
-        groupLayer->layersLength = layersLength;
+        groupLayer->layersLength = layerNodes->length;
     } else { /* If the list of layers is being appended to the top-level map */
         map->layers = layers;
-        map->layersLength = layersLength;
+        map->layersLength = layerNodes->length;
+    }
+}
+
+int CompareObjectSortingEntries(const void* a, const void* b) {
+    const RaytmxObjectSortingEntry *entryA = (const RaytmxObjectSortingEntry*)a,
+        *entryB = (const RaytmxObjectSortingEntry*)b;
+    if (entryA->y != entryB->y)
+        return entryA->y < entryB->y ? -1 : +1;
+    /* Among objects with equal y-coordinates, later objects come first. This is the order the sorted insertion */
+    /* this replaced produced and qsort() isn't stable so the order must be explicit to be deterministic. */
+    return entryA->index > entryB->index ? -1 : (entryA->index < entryB->index ? +1 : 0);
+}
+
+/**
+ * Sort an object group's objects into boxes, stored for CheckCollisionTMXBoxesRec(), and other objects.
+ *
+ * @param arena The arena the group's other arrays belong to.
+ * @param group An object group whose 'objects' have been set.
+ */
+void BucketObjectGroup(RaytmxArena* arena, TmxObjectGroup* group) {
+    uint32_t boxesLength = 0;
+    for (uint32_t i = 0; i < group->objectsLength; i++) {
+        TmxObjectType type = group->objects[i].type;
+        if (type == OBJECT_TYPE_RECTANGLE || type == OBJECT_TYPE_ELLIPSE || type == OBJECT_TYPE_TEXT ||
+                type == OBJECT_TYPE_TILE)
+            boxesLength++;
+    }
+    uint32_t paddedLength = (boxesLength + RAYTMX_BOX_BATCH - 1) / RAYTMX_BOX_BATCH * RAYTMX_BOX_BATCH;
+    if (paddedLength == 0)
+        paddedLength = RAYTMX_BOX_BATCH; /* So the arrays exist, marking the group as bucketed */
+
+    group->boxMinX = (float*)ArenaAllocZero(arena, sizeof(float) * paddedLength);
+    group->boxMinY = (float*)ArenaAllocZero(arena, sizeof(float) * paddedLength);
+    group->boxMaxX = (float*)ArenaAllocZero(arena, sizeof(float) * paddedLength);
+    group->boxMaxY = (float*)ArenaAllocZero(arena, sizeof(float) * paddedLength);
+    group->boxObjects = (uint32_t*)ArenaAllocZero(arena, sizeof(uint32_t) * paddedLength);
+    group->otherObjects = (uint32_t*)ArenaAllocZero(arena, sizeof(uint32_t) * (group->objectsLength - boxesLength + 1));
+    group->boxesLength = 0;
+    group->otherObjectsLength = 0;
+    for (uint32_t i = 0; i < group->objectsLength; i++) {
+        TmxObjectType type = group->objects[i].type;
+        if (type == OBJECT_TYPE_RECTANGLE || type == OBJECT_TYPE_ELLIPSE || type == OBJECT_TYPE_TEXT ||
+                type == OBJECT_TYPE_TILE) {
+            Rectangle aabb = group->objects[i].aabb;
+            uint32_t box = group->boxesLength++;
+            group->boxMinX[box] = aabb.x;
+            group->boxMinY[box] = aabb.y;
+            group->boxMaxX[box] = aabb.x + aabb.width;
+            group->boxMaxY[box] = aabb.y + aabb.height;
+            group->boxObjects[box] = i;
+        } else
+            group->otherObjects[group->otherObjectsLength++] = i;
+    }
+    /* Padding boxes are inside out, so every comparison against them fails */
+    for (uint32_t box = boxesLength; box < paddedLength; box++) {
+        group->boxMinX[box] = group->boxMinY[box] = INFINITY;
+        group->boxMaxX[box] = group->boxMaxY[box] = -INFINITY;
     }
 }
 
+/**
+ * Find the lowest set bit.
+ *
+ * @param bits A non-zero value.
+ * @return The index of the lowest bit set in the value, 0 for the least significant.
+ */
+uint32_t LowestSetBit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctzll(bits);
+#else
+    uint32_t index = 0;
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
 RaytmxCachedTextureNode* LoadCachedTexture(RaytmxState* raytmxState, const char* fileName) {
     if (raytmxState == NULL || fileName == NULL)
         return NULL;
 
+    /* The cache is shared with any TSX or TX documents the map references, and those may be in other directories, */
+    /* so textures are identified by their full paths rather than the paths relative to their documents */
+    char* fullPath = JoinPath(raytmxState->documentDirectory, fileName);
+
     /* First try to find an already-loaded texture identified by the file name */
     RaytmxCachedTextureNode* cachedTextureNode = raytmxState->texturesRoot;
     while (cachedTextureNode != NULL) {
         /* If the file name associated with the node matches the given file name */
-        if (strcmp(cachedTextureNode->fileName, fileName) == 0)
+        if (strcmp(cachedTextureNode->fileName, fullPath) == 0)
             return cachedTextureNode;
         cachedTextureNode = cachedTextureNode->next;
     }
 
     /* Try to load the texture */
-    char* fullPath = JoinPath(raytmxState->documentDirectory, fileName);
     Texture2D texture = LoadTexture(fullPath);
     if (texture.id == 0) { /* If loading the texture failed */
         TraceLog(LOG_ERROR, "RAYTMX: Unable to load texture \"%s\"", fullPath);
@@ -4477,10 +5300,11 @@ RaytmxCachedTextureNode* LoadCachedTexture(RaytmxState* raytmxState, const char*
     }
 
     /* Create a new node in the list of known textures */
-    cachedTextureNode = (RaytmxCachedTextureNode*)MemAllocZero(sizeof(RaytmxCachedTextureNode));
-    cachedTextureNode->fileName = (char*)MemAllocZero((unsigned int)strlen(fileName) + 1);
-    StringCopy(cachedTextureNode->fileName, fileName);
+    cachedTextureNode = (RaytmxCachedTextureNode*)ArenaAllocZero(raytmxState->scratch,
+        sizeof(RaytmxCachedTextureNode));
+    cachedTextureNode->fileName = ArenaStringCopy(raytmxState->scratch, fullPath);
     cachedTextureNode->texture = texture;
+    raytmxState->texturesLength += 1;
 
     /* Add to the cache */
     if (raytmxState->texturesRoot == NULL)
@@ -4495,6 +5319,20 @@ RaytmxCachedTextureNode* LoadCachedTexture(RaytmxState* raytmxState, const char*
     return cachedTextureNode;
 }
 
+void CollectCachedTextures(const RaytmxState* raytmxState, TmxMap* map) {
+    if (raytmxState->texturesLength == 0)
+        return;
+
+    /* The cache holds every texture loaded for the map, each once, making it the list of textures to unload later */
+    map->textures = (Texture2D*)ArenaAllocZero(map->arena, sizeof(Texture2D) * raytmxState->texturesLength);
+    RaytmxCachedTextureNode* cachedTextureIterator = raytmxState->texturesRoot;
+    for (uint32_t i = 0; cachedTextureIterator != NULL; i++) {
+        map->textures[i] = cachedTextureIterator->texture;
+        cachedTextureIterator = cachedTextureIterator->next;
+    }
+    map->texturesLength = raytmxState->texturesLength;
+}
+
 RaytmxCachedTemplateNode* LoadCachedTemplate(RaytmxState* raytmxState, const char* fileName) {
     if (raytmxState == NULL || fileName == NULL)
         return NULL;
@@ -4510,39 +5348,44 @@ RaytmxCachedTemplateNode* LoadCachedTemplate(RaytmxState* raytmxState, const cha
 
     /* Load the template from the external TX file */
     char* fullPath = JoinPath(raytmxState->documentDirectory, fileName);
-    RaytmxObjectTemplate objectTemplate = LoadTX(fullPath);
+    RaytmxObjectTemplate objectTemplate = LoadTX(raytmxState, fullPath);
     if (!objectTemplate.isSuccess) { /* If loading the template failed */
         TraceLog(LOG_ERROR, "RAYTMX: Unable to load template \"%s\"", fullPath);
         return NULL;
     }
 
     /* Create a new node in the list of known templates */
-    cachedTemplateNode = (RaytmxCachedTemplateNode*)MemAllocZero(sizeof(RaytmxCachedTemplateNode));
-    cachedTemplateNode->fileName = (char*)MemAllocZero((unsigned int)strlen(fileName) + 1);
-    StringCopy(cachedTemplateNode->fileName, fileName);
+    cachedTemplateNode = (RaytmxCachedTemplateNode*)ArenaAllocZero(raytmxState->scratch,
+        sizeof(RaytmxCachedTemplateNode));
+    cachedTemplateNode->fileName = ArenaStringCopy(raytmxState->scratch, fileName);
     cachedTemplateNode->objectTemplate = objectTemplate;
 
     if (objectTemplate.hasTileset) { /* If the template contains a tileset in addition to an object */
         /* In cases where the template's object references a tile (i.e. its 'gid' attribute is set), the template */
         /* will have at most one tileset. Search the state object's list of tilesets and add this one if it's new. */
-        RaytmxTilesetNode* tilesetsIterator = raytmxState->tilesetsRoot;
+        TmxTileset* tilesets = (TmxTileset*)raytmxState->tilesets.data;
         bool isNew = true;
-        while (tilesetsIterator != NULL) {
+        for (uint32_t i = 0; i < raytmxState->tilesets.length; i++) {
             /* If the existing tileset has a name, the template's tileset has a name, and they match OR if the */
             /* existing tileset has a source, template's tileset has a source, and they match */
             /* TODO: The comparison of sources without respect to directory should be reviewed as it could result in */
             /* false negatives and duplicate tileset instances */
-            if ((tilesetsIterator->tileset.name != NULL && objectTemplate.tileset.name != NULL &&
-                    strcmp(tilesetsIterator->tileset.name, objectTemplate.tileset.name) == 0) ||
-                    (tilesetsIterator->tileset.source != NULL && objectTemplate.tileset.source != NULL &&
-                    strcmp(tilesetsIterator->tileset.source, objectTemplate.tileset.source) == 0)) {
+            if ((tilesets[i].name != NULL && objectTemplate.tileset.name != NULL &&
+                    strcmp(tilesets[i].name, objectTemplate.tileset.name) == 0) ||
+                    (tilesets[i].source != NULL && objectTemplate.tileset.source != NULL &&
+                    strcmp(tilesets[i].source, objectTemplate.tileset.source) == 0)) {
                 isNew = false;
                 break;
             }
         }
         if (isNew) {
+            /* Adding a tileset may move the buffer of tilesets. If a <tileset> is open (e.g. this template is used */
+            /* by an object within a <tile>'s collision information), its pointer must follow. */
+            ptrdiff_t openTilesetIndex = raytmxState->tileset != NULL ? raytmxState->tileset - tilesets : -1;
             TmxTileset* tileset = AddTileset(raytmxState);
             *tileset = objectTemplate.tileset;
+            if (openTilesetIndex >= 0)
+                raytmxState->tileset = (TmxTileset*)raytmxState->tilesets.data + openTilesetIndex;
         }
     }
 
@@ -4602,12 +5445,116 @@ uint32_t GetGid(uint32_t rawGid, bool* isFlippedHorizontally, bool* isFlippedVer
     return rawGid & ~(FLIP_FLAG_HORIZONTAL | FLIP_FLAG_VERTICAL | FLIP_FLAG_DIAGONAL | FLIP_FLAG_ROTATE_120);
 }
 
-void* MemAllocZero(unsigned int size) {
-    void* buffer = MemAlloc(size); /* Reserve 'size' bytes of memory */
+RaytmxArena* CreateArena(size_t blockSize) {
+    RaytmxArena* arena = (RaytmxArena*)MemAlloc((unsigned int)sizeof(RaytmxArena));
+    arena->blocks = NULL; /* The first block is allocated along with the first allocation */
+    arena->blockSize = blockSize;
+    return arena;
+}
+
+void DestroyArena(RaytmxArena* arena) {
+    if (arena == NULL)
+        return;
+
+    /* There are only a handful of blocks no matter how many allocations were made from them */
+    RaytmxArenaBlock *blockIterator = arena->blocks, *blockTemp;
+    while (blockIterator != NULL) {
+        blockTemp = blockIterator;
+        blockIterator = blockIterator->next;
+        MemFree(blockTemp);
+    }
+    MemFree(arena);
+}
+
+void* ArenaAllocZero(RaytmxArena* arena, size_t size) {
+    /* The block header is padded so the memory following it, and thus every allocation, is aligned */
+    const size_t headerSize = (sizeof(RaytmxArenaBlock) + RAYTMX_ARENA_ALIGNMENT - 1) &
+        ~(size_t)(RAYTMX_ARENA_ALIGNMENT - 1);
+    size = (size + RAYTMX_ARENA_ALIGNMENT - 1) & ~(size_t)(RAYTMX_ARENA_ALIGNMENT - 1);
+
+    RaytmxArenaBlock* block = arena->blocks;
+    if (block == NULL || block->capacity - block->used < size) { /* If the current block can't fit the allocation */
+        if (size > arena->blockSize / 2 && block != NULL) {
+            /* Large allocations, like a big layer's tiles, get a block of their own. It's placed behind the current */
+            /* block so the current block's remaining space isn't wasted. */
+            RaytmxArenaBlock* oversized = (RaytmxArenaBlock*)MemAlloc((unsigned int)(headerSize + size));
+            oversized->capacity = size;
+            oversized->used = size;
+            oversized->next = block->next;
+            block->next = oversized;
+            void* buffer = (char*)oversized + headerSize;
+            memset(buffer, 0, size);
+            return buffer;
+        }
+
+        size_t capacity = arena->blockSize > size ? arena->blockSize : size;
+        block = (RaytmxArenaBlock*)MemAlloc((unsigned int)(headerSize + capacity));
+        block->capacity = capacity;
+        block->used = 0;
+        block->next = arena->blocks;
+        arena->blocks = block;
+        arena->blockSize *= 2; /* Grow geometrically so even huge maps need only a few blocks */
+    }
+
+    void* buffer = (char*)block + headerSize + block->used; /* Bump */
+    block->used += size;
     memset(buffer, 0, size); /* Initialize any values to zero, NULL, false, or an equivalent enum value */
     return buffer;
 }
 
+char* ArenaStringCopy(RaytmxArena* arena, const char* source) {
+    char* destination = (char*)ArenaAllocZero(arena, strlen(source) + 1); /* + 1 for the terminator */
+    StringCopy(destination, source);
+    return destination;
+}
+
+void* ArenaResize(RaytmxArena* arena, void* buffer, size_t size, size_t newSize) {
+    const size_t alignmentMask = RAYTMX_ARENA_ALIGNMENT - 1;
+    const size_t headerSize = (sizeof(RaytmxArenaBlock) + alignmentMask) & ~alignmentMask;
+    size_t alignedSize = (size + alignmentMask) & ~alignmentMask;
+    size_t alignedNewSize = (newSize + alignmentMask) & ~alignmentMask;
+
+    /* If the buffer was the most recent allocation from the current block and the block has room, the buffer can */
+    /* simply be extended. This is the common case for a buffer being filled without interruption, like the GIDs of */
+    /* a tile layer. */
+    RaytmxArenaBlock* block = arena->blocks;
+    if (buffer != NULL && block != NULL && (char*)buffer + alignedSize == (char*)block + headerSize + block->used &&
+            block->capacity - block->used >= alignedNewSize - alignedSize) {
+        block->used += alignedNewSize - alignedSize;
+        memset((char*)buffer + size, 0, newSize - size);
+        return buffer;
+    }
+
+    /* Otherwise, move the contents to a new allocation. The old one is left to the arena. */
+    void* newBuffer = ArenaAllocZero(arena, newSize);
+    if (buffer != NULL)
+        memcpy(newBuffer, buffer, size);
+    return newBuffer;
+}
+
+void* BufferAppend(RaytmxArena* arena, RaytmxBuffer* buffer, uint32_t count, size_t elementSize) {
+    if (buffer->length + count > buffer->capacity) { /* If the buffer must grow to fit the new elements */
+        /* Double the capacity, starting from a modest number of elements, so appending is amortized O(1) */
+        uint32_t capacity = buffer->capacity > 0 ? buffer->capacity * 2 : 16;
+        if (capacity < buffer->length + count)
+            capacity = buffer->length + count;
+        buffer->data = ArenaResize(arena, buffer->data, elementSize * buffer->capacity, elementSize * capacity);
+        buffer->capacity = capacity;
+    }
+
+    void* elements = (char*)buffer->data + (elementSize * buffer->length);
+    memset(elements, 0, elementSize * count); /* The space may have been used before the buffer's length was reset */
+    buffer->length += count;
+    return elements;
+}
+
+void* BufferCopy(RaytmxArena* arena, const RaytmxBuffer* buffer, size_t elementSize) {
+    void* array = ArenaAllocZero(arena, elementSize * buffer->length);
+    if (buffer->length > 0)
+        memcpy(array, buffer->data, elementSize * buffer->length);
+    return array;
+}
+
 /* "Get directory for a given filePath" */
 /* raylib's GetDirectoryPath() doesn't work as described so this is used in its place */
 char* GetDirectoryPath2(const char* filePath) {
@@ -4635,6 +5582,141 @@ char* GetDirectoryPath2(const char* filePath) {
     return directoryPath;
 }
 
+/**
+ * Helper function that parses one object of a .world file's "maps" array.
+ *
+ * @param cursor Position of the object's opening brace.
+ * @param arena Arena from which the map's file name is allocated.
+ * @param documentDirectory Directory of the .world file, which the map's file name is relative to.
+ * @param worldMap Output parameter populated with the map's file name and placement.
+ * @return Position following the object's closing brace, or NULL if the object is malformed.
+ */
+const char* ParseWorldMap(const char* cursor, RaytmxArena* arena, const char* documentDirectory,
+        TmxWorldMap* worldMap) {
+    char key[32], value[260];
+    cursor = SkipJsonWhitespace(cursor + 1); /* + 1 to skip the '{' */
+    while (*cursor == '"') {
+        cursor = ParseJsonString(cursor, key, sizeof(key));
+        if (cursor == NULL || *(cursor = SkipJsonWhitespace(cursor)) != ':')
+            return NULL;
+        cursor = SkipJsonWhitespace(cursor + 1);
+
+        if (strcmp(key, "fileName") == 0) {
+            if (*cursor != '"' || (cursor = ParseJsonString(cursor, value, sizeof(value))) == NULL)
+                return NULL;
+            worldMap->fileName = ArenaStringCopy(arena, JoinPath(documentDirectory, value));
+        } else if (strcmp(key, "x") == 0 || strcmp(key, "y") == 0 || strcmp(key, "width") == 0 ||
+                strcmp(key, "height") == 0) {
+            char* end;
+            double number = strtod(cursor, &end);
+            if (end == cursor)
+                return NULL;
+            cursor = end;
+            switch (key[0]) {
+            case 'x': worldMap->x = (int32_t)number; break;
+            case 'y': worldMap->y = (int32_t)number; break;
+            case 'w': worldMap->width = number > 0.0 ? (uint32_t)number : 0; break;
+            default: worldMap->height = number > 0.0 ? (uint32_t)number : 0; break;
+            }
+        } else if ((cursor = SkipJsonValue(cursor)) == NULL)
+            return NULL;
+
+        cursor = SkipJsonWhitespace(cursor);
+        if (*cursor == ',')
+            cursor = SkipJsonWhitespace(cursor + 1);
+    }
+
+    if (*cursor != '}' || worldMap->fileName == NULL)
+        return NULL;
+    return cursor + 1;
+}
+
+/**
+ * Helper function for checking for collisions between a rectangle and the objects of every object group in the given
+ * layers, including those within group layers.
+ *
+ * @param layers An array of layers whose object groups are to be checked for collisions.
+ * @param layersLength Length of the given array of layers.
+ * @param rec The rectangle to be checked for collisions.
+ * @param outputObject Output parameter assigned with the object the rectangle collided with, if any.
+ * @return True if a collision is found, or false otherwise.
+ */
+bool CheckCollisionWorldObjectGroupsRec(const TmxLayer* layers, uint32_t layersLength, Rectangle rec,
+        TmxObject* outputObject) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        const TmxLayer* layer = &layers[i];
+        if (layer->type == LAYER_TYPE_OBJECT_GROUP) {
+            TmxObjectGroup group = layer->exact.objectGroup;
+            if (CheckCollisionTMXObjectGroupRec(group, rec, outputObject))
+                return true;
+        } else if (layer->type == LAYER_TYPE_GROUP &&
+                CheckCollisionWorldObjectGroupsRec(layer->layers, layer->layersLength, rec, outputObject))
+            return true;
+    }
+
+    return false;
+}
+
+const char* SkipJsonWhitespace(const char* cursor) {
+    while (isspace((unsigned char)*cursor))
+        cursor += 1;
+    return cursor;
+}
+
+/* Copy a JSON string, starting at its opening quote, into the output and return the position after its closing */
+/* quote. Strings too long for the output are truncated. Only the escapes file names are likely to use are decoded. */
+const char* ParseJsonString(const char* cursor, char* output, size_t outputLength) {
+    size_t length = 0;
+    cursor += 1; /* Skip the opening '"' */
+    while (*cursor != '"') {
+        char c = *cursor;
+        if (c == '\0')
+            return NULL; /* Unterminated string */
+        if (c == '\\') {
+            cursor += 1;
+            switch (*cursor) {
+            case '\0': return NULL;
+            case 'n': c = '\n'; break;
+            case 't': c = '\t'; break;
+            default: c = *cursor; break; /* '"', '\\', '/', and anything unsupported are copied as they are */
+            }
+        }
+        if (length + 1 < outputLength)
+            output[length++] = c;
+        cursor += 1;
+    }
+    output[length] = '\0';
+    return cursor + 1; /* + 1 to skip the closing '"' */
+}
+
+/* Skip a JSON value of any type, including nested objects and arrays, and return the position after it */
+const char* SkipJsonValue(const char* cursor) {
+    char discard[1];
+    uint32_t depth = 0;
+    do {
+        switch (*cursor) {
+        case '\0': return NULL;
+        case '"':
+            if ((cursor = ParseJsonString(cursor, discard, sizeof(discard))) == NULL)
+                return NULL;
+            continue;
+        case '{': case '[': depth += 1; break;
+        case '}': case ']':
+            if (depth == 0)
+                return cursor; /* The end of the value's container, not the value */
+            depth -= 1;
+            break;
+        case ',':
+            if (depth == 0)
+                return cursor;
+            break;
+        default: break;
+        }
+        cursor += 1;
+    } while (depth > 0 || (*cursor != ',' && *cursor != '}' && *cursor != ']'));
+    return cursor;
+}
+
 char* JoinPath(const char* prefix, const char* suffix) {
     static char joinedPath[260]; /* Max path length on Windows, the bottleneck, is 260 characters */
     memset(joinedPath, '\0', 260);
@@ -1,15 +1,53 @@
 #include "raylib.h"
 #include "raymath.h"
-#include "CollisionSystem.h"
-#include "Samurai.h"
-#include "Demon.h"
+#include "InputRecorder.h"
+#include "ResolutionGovernor.h"
+#include "ParticleSystem.h"
+#include "Tracer.h"
+#include "FlightRecorder.h"
+#include "AIScheduler.h"
+#include "SpatialHash.h"
+#include "WorldSnapshot.h"
+#include "JobSystem.h"
 #include <iostream>
 #include <vector>
 #include <stdlib.h> // For exit()
+#include <string.h> // For strcmp()
+#include <time.h> // For time()
 #include <unistd.h> // For getcwd()
 #include <limits.h> // For PATH_MAX
 #include <cstdio>
+
+// The characters and the start screen read raylib's input directly. Route those reads through the input layer
+// so a replay feeds them recorded input too.
+#define IsKeyDown inputIsKeyDown
+#define IsKeyUp inputIsKeyUp
+#define IsKeyPressed inputIsKeyPressed
+#define IsKeyReleased inputIsKeyReleased
+#define IsMouseButtonDown inputIsMouseButtonDown
+#define IsMouseButtonUp inputIsMouseButtonUp
+#define IsMouseButtonPressed inputIsMouseButtonPressed
+#define IsMouseButtonReleased inputIsMouseButtonReleased
+#define GetMousePosition inputGetMousePosition
+#define GetMouseX inputGetMouseX
+#define GetMouseY inputGetMouseY
+#define GetFrameTime inputGetFrameTime
+#include "CollisionSystem.h"
+#include "Samurai.h"
+#include "Demon.h"
 #include "StartScreen.h"
+#undef IsKeyDown
+#undef IsKeyUp
+#undef IsKeyPressed
+#undef IsKeyReleased
+#undef IsMouseButtonDown
+#undef IsMouseButtonUp
+#undef IsMouseButtonPressed
+#undef IsMouseButtonReleased
+#undef GetMousePosition
+#undef GetMouseX
+#undef GetMouseY
+#undef GetFrameTime
 
 #include <functional>
 
@@ -19,11 +57,33 @@
 
 // Define RAYTMX_IMPLEMENTATION to include the implementation of the library
 #define RAYTMX_IMPLEMENTATION
+// Put raytmx's loading, parsing, drawing and collision functions on the trace timeline too
+#define RAYTMX_TRACE_BEGIN(name) TRACE_BEGIN(name)
+#define RAYTMX_TRACE_END() TRACE_END()
 #include "raytmx.h"
+#include "MemoryStats.h"
+#include "TransitionBenchmark.h"
+#include "NavGrid.h"
+#include "HudLayer.h"
+#include "IdleMode.h"
+#include "StateHistory.h"
+#include "CharacterSnapshot.h"
 
 // Define the global variable for collision box visibility
 bool showCollisionBoxes = false;
 
+// Turned off by --replay-fast so a recorded session runs as fast as the simulation allows
+bool renderingEnabled = true;
+
+// Set by --gpu-tiles to draw tile layers with raytmx's shader instead of one quad per tile
+bool gpuTiles = false;
+
+// --particle-stress keeps this many particles alive around the camera to measure the particle system
+const int PARTICLE_STRESS_COUNT = 100000;
+const int PARTICLE_JOB_GRAIN = 8192;    // Particles per job, enough to outweigh the cost of handing one out
+bool particleStress = false;
+double particleUpdateTime = 0.0;
+
 // Global audio variables
 Music backgroundMusic = { 0 };
 Music menuMusic = { 0 };
@@ -45,12 +105,27 @@ std::vector<std::string> randomDialogues = {
     "You must seek the next portal, brave samurai."
 };
 
+// The game's own random numbers, e.g. which dialogue line is shown. raylib's RNG state can't be read, so snapshots
+// couldn't keep it without reseeding raylib every time one is taken. This one's state is a plain number that they
+// store without disturbing the sequence. Seeded from raylib's RNG once at startup, so it follows a replay's seed.
+uint32_t gameRandomState = 0x2545F491u;
+
+// xorshift32, in [min, max] like GetRandomValue()
+int gameRandomValue(int min, int max) {
+    uint32_t x = gameRandomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    gameRandomState = x;
+    return min + (int)(x % (uint32_t)(max - min + 1));
+}
+
 void triggerRoom3Dialogue() {
     // Set dialogue state
     showDialogue = true;
     
     // Select a random dialogue message
-    dialogueText = randomDialogues[GetRandomValue(0, randomDialogues.size() - 1)];
+    dialogueText = randomDialogues[gameRandomValue(0, randomDialogues.size() - 1)];
     
     // Reset timer to start counting up
     dialogueTimer = 0.0f;
@@ -64,6 +139,15 @@ Camera2D camera = { 0 };
 
 TmxMap* map = NULL;
 
+// Room2, Room3 and Room4 are one corridor: CryptRooms.world puts them side by side, left to right, and while the
+// samurai is in any of them they're streamed in and out around the camera, drawn and collided with together. map is
+// then the room the samurai is in, and everything is positioned relative to it as before. Walking into the next room
+// shifts those positions over by the distance between the two rooms.
+const char* ROOMS_WORLD = "maps/CryptRooms.world";
+const float ROOM_EDGE_MARGIN = 16.0f;   // How far past the border the samurai goes before being in the next room
+TmxWorld* rooms = NULL;
+int currentRoom = -1;                   // The samurai's room in rooms->maps, -1 outside the corridor
+
 enum GameState {START_SCREEN, MAIN_GAME, EXIT};
 bool isPaused = false;
 bool isComplete = false;
@@ -104,6 +188,13 @@ void handleAttackCollision(CollisionBox* attackBox, CollisionBox* hurtBox, int&
 
 // Custom exit function that bypasses normal cleanup
 void safeExit() {
+    // Flush any input recording and trace before bypassing normal cleanup
+    inputShutdown();
+    traceWriteNext();
+    lowResShutdown();
+    hudShutdown();
+    idleReleaseWorld();
+
     // Unload audio resources
     if (backgroundMusic.ctxData != NULL) {
         StopMusicStream(backgroundMusic);
@@ -123,6 +214,35 @@ void safeExit() {
     _Exit(0); // Use _Exit instead of exit to bypass any atexit handlers
 }
 
+// Dim the screen and draw the pause menu over it, and handle its exit button
+void drawPauseScreen() {
+    DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(BLACK, 0.5f));
+
+    // Define the exit button area
+    Rectangle exitButton = { static_cast<float>(GetScreenWidth()) / 2 - 75, 
+        static_cast<float>(GetScreenHeight()) / 2 + 60, 
+        150.0f, 40.0f };
+
+    // The panel's text and button are cached, only the dimming above is drawn every frame
+    Rectangle pauseBounds = { static_cast<float>(GetScreenWidth()/2 - 120),
+                              static_cast<float>(GetScreenHeight()/2 - 20), 240.0f, 130.0f };
+    if (hudBeginWidget(HUD_PAUSE, pauseBounds, 0)) {
+        DrawText("PAUSED", GetScreenWidth()/2 - 50, GetScreenHeight()/2 - 10, 30, WHITE);
+        DrawText("Press 'P' to resume", GetScreenWidth()/2 - 100, GetScreenHeight()/2 + 30, 20, WHITE);
+
+        // Draw the exit button
+        DrawRectangleRec(exitButton, DARKGRAY);
+        DrawText("Exit", GetScreenWidth()/2 - 20, GetScreenHeight()/2 + 70, 20, WHITE);
+        hudEndWidget();
+    }
+    hudDrawWidget(HUD_PAUSE);
+
+    // Check if the exit button is clicked
+    if (CheckCollisionPointRec(inputGetMousePosition(), exitButton) && inputIsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+        safeExit();
+    }
+}
+
 // Function to draw collision boxes for debugging
 void drawCollisionBox(const CollisionBox& box) {
     if (!box.active) return;
@@ -168,8 +288,94 @@ bool fileExists(const char* fileName) {
     return false;
 }
 
+// Load a map, and with --gpu-tiles have its tile layers drawn in one shader pass when the GPU supports it.
+// Returns nullptr when loading fails.
+TmxMap* loadMap(const char* fileName) {
+    TmxMap* loaded = LoadTMX(fileName);
+    if (loaded && gpuTiles) {
+        EnableGpuRenderingTMX(loaded);
+    }
+    return loaded;
+}
+
+// The corridor room with the given file name, e.g. "Room3.tmx", or -1. The corridor's layout is read the first time.
+int findRoom(const char* fileName) {
+    if (!rooms) {
+        rooms = LoadWorldTMX(ROOMS_WORLD);
+        if (!rooms) {
+            return -1;
+        }
+        rooms->useGpuRendering = gpuTiles;
+    }
+    for (uint32_t i = 0; i < rooms->mapsLength; i++) {
+        if (strcmp(GetFileName(rooms->maps[i].fileName), fileName) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+// Make a corridor room the samurai's. It's loaded now if it hasn't been streamed in already, the rooms next to it
+// follow as the camera gets near them. Returns nullptr when loading fails.
+TmxMap* enterRoom(int room) {
+    TmxWorldMap& worldMap = rooms->maps[room];
+    if (!worldMap.map) {
+        // Only the middle of the room is in view, so nothing else is loaded
+        UpdateWorldTMX(rooms, Rectangle{ worldMap.x + worldMap.width / 2.0f, worldMap.y + worldMap.height / 2.0f,
+                                         1.0f, 1.0f });
+    }
+    currentRoom = worldMap.map ? room : -1;
+    return worldMap.map;
+}
+
+TmxMap* enterRoom(const char* fileName) {
+    int room = findRoom(fileName);
+    if (room < 0) {
+        printf("%s isn't in %s\n", fileName, ROOMS_WORLD);
+        return nullptr;
+    }
+    return enterRoom(room);
+}
+
+// Where the samurai's room is in the corridor, zero outside it
+Vector2 roomOrigin() {
+    if (currentRoom < 0) {
+        return Vector2{ 0, 0 };
+    }
+    return Vector2{ (float)rooms->maps[currentRoom].x, (float)rooms->maps[currentRoom].y };
+}
+
+// The area the camera stays in: the map, or all of the corridor, relative to the samurai's room
+Rectangle levelBounds() {
+    if (currentRoom < 0) {
+        return Rectangle{ 0, 0, (float)(map->width * map->tileWidth), (float)(map->height * map->tileHeight) };
+    }
+    Vector2 origin = roomOrigin();
+    float left = INFINITY, top = INFINITY, right = -INFINITY, bottom = -INFINITY;
+    for (uint32_t i = 0; i < rooms->mapsLength; i++) {
+        const TmxWorldMap& worldMap = rooms->maps[i];
+        left = fminf(left, (float)worldMap.x - origin.x);
+        top = fminf(top, (float)worldMap.y - origin.y);
+        right = fmaxf(right, (float)worldMap.x + worldMap.width - origin.x);
+        bottom = fmaxf(bottom, (float)worldMap.y + worldMap.height - origin.y);
+    }
+    return Rectangle{ left, top, right - left, bottom - top };
+}
+
+// Let go of the current map, or of every corridor room that's loaded when the samurai is leaving the corridor
+void releaseMap() {
+    if (currentRoom >= 0) {
+        UnloadWorldMapsTMX(rooms);
+        currentRoom = -1;
+    } else if (map) {
+        UnloadTMX(map);
+    }
+    map = NULL;
+}
+
 void loadLevel() {
-    map = LoadTMX("maps/LevelDesign.tmx");
+    TRACE_SCOPE("loadLevel");
+    map = loadMap("maps/LevelDesign.tmx");
     if (!map) {
         printf("Failed to Load TMX File.\n");
         exit (1);
@@ -184,6 +390,7 @@ void loadLevel() {
         // Check if the image source is valid (not empty)
         if (tileset->image.source[0] != '\0') {  // Using image.source to check validity
             Texture2D tilesetTexture = LoadTexture("maps/16 x16 Purple Dungeon Sprite Sheet.png");
+            memTrackTexture(MEM_VRAM_TEXTURES, tilesetTexture); // Never unloaded, so it's counted for good
             if (tilesetTexture.id == 0) {
                 std::cout << "Error loading tileset image" << std::endl;
             }
@@ -192,12 +399,62 @@ void loadLevel() {
 }
 
 void renderLevel() {
-    if (map) {
-        DrawTMX(map, &camera, 0, 0, WHITE);
+    TRACE_SCOPE("renderLevel");
+    // The camera the world is being drawn with and the part of the low-res target it's drawn into, so the maps are
+    // culled against what's actually visible whatever the governor's scale
+    Camera2D view = lowResWorldCamera(camera);
+    if (lowResRenderer.enabled) {
+        SetViewportTMX(lowResWidth(), lowResHeight());
+    }
+    if (currentRoom >= 0) {
+        // The corridor is drawn where the world puts its rooms, moved back so the samurai's room is at the origin
+        Vector2 origin = roomOrigin();
+        Camera2D worldCamera = view;
+        worldCamera.target = Vector2Add(view.target, origin);
+        rlPushMatrix();
+        rlTranslatef(-origin.x, -origin.y, 0.0f);
+        DrawWorldTMX(rooms, &worldCamera, WHITE);
+        rlPopMatrix();
+    } else if (map) {
+        DrawTMX(map, &view, 0, 0, WHITE);
+    }
+    SetViewportTMX(0, 0);
+}
+
+// Stand the player on the object they've run into
+void landOnObject(Samurai& player, const TmxObject& col) {
+    TraceLog(LOG_DEBUG, "We've made contact!");
+
+    Vector2 newVel = player.getVelocity();
+    newVel.y = 0;
+    player.setVelocity(newVel);
+
+    Rectangle newRect = player.getRect();
+    newRect.y = (col.aabb.y - newRect.height);
+    player.setRect(newRect);
+
+    if (player.isJumping()) {
+        player.land();
+        // Dust kicked up from under the player's feet
+        particlesEmit(DUST_EMITTER, Vector2{ newRect.x + newRect.width / 2, newRect.y + newRect.height }, 12);
     }
 }
 
 void checkTileCollisions(TmxMap* map, Samurai& player) {
+    TRACE_SCOPE("checkTileCollisions");
+    if (currentRoom >= 0) {
+        // Near a border the floor can be the next room's, so every corridor room that's loaded is checked
+        Vector2 origin = roomOrigin();
+        Rectangle rect = player.getRect();
+        rect.x += origin.x;
+        rect.y += origin.y;
+        TmxObject col;
+        if (CheckCollisionWorldTMXRec(rooms, rect, &col)) {
+            col.aabb.y -= origin.y;
+            landOnObject(player, col);
+        }
+        return;
+    }
     for (unsigned int i = 0; i < map->layersLength; i++) {
       TraceLog(LOG_DEBUG, "current layer is %d: %s", i, map->layers[i].name);
       if (strcmp(map->layers[i].name, "Object Layer 1") == 0 && map->layers[i].type == LAYER_TYPE_OBJECT_GROUP) 
@@ -205,26 +462,22 @@ void checkTileCollisions(TmxMap* map, Samurai& player) {
           TmxObject col;
           if (CheckCollisionTMXObjectGroupRec(map->layers[i].exact.objectGroup, player.getRect(), &col))
           {
-            TraceLog(LOG_DEBUG, "We've made contact!");
-            
-            Vector2 newVel = player.getVelocity();
-            newVel.y = 0;
-            player.setVelocity(newVel);
-
-            Rectangle newRect = player.getRect();
-            newRect.y = (col.aabb.y - newRect.height);
-            player.setRect(newRect);
-
-            if (player.isJumping()) {
-                player.land();
-            }
+            landOnObject(player, col);
           }
       }
     }
     return;
 } 
 
-int main() 
+// Print how long a replay took compared to the session it was recorded from
+void printReplaySummary(double startTime) {
+    double elapsed = GetTime() - startTime;
+    printf("Replay finished: %ld ticks in %.2fs (%.0f ticks/s), recorded session was %.2fs (%.1fx real time)\n",
+           inputState.ticks, elapsed, elapsed > 0.0 ? inputState.ticks / elapsed : 0.0, inputState.inputTime,
+           elapsed > 0.0 ? inputState.inputTime / elapsed : 0.0);
+}
+
+int main(int argc, char* argv[]) 
 {
     // Print current working directory
     char cwd[PATH_MAX];
@@ -249,6 +502,7 @@ int main()
     
     // Loading the Background.
     Texture2D background = LoadTexture("maps/Dungeon_brick_wall_purple.png.png");
+    memTrackTexture(MEM_VRAM_TEXTURES, background);
 
     // Background Scale Factors.
     float scalebgx = (float)screenWidth / (float)background.width;
@@ -269,11 +523,71 @@ int main()
     // Initialize audio device before loading music
     InitAudioDevice();
 
-    // Load Music.
+    // Load Music. Longer buffers than raylib's default let the menus run at a low frame rate without the music
+    // running dry, see IdleMode.h.
+    SetAudioStreamBufferSizeDefault(IDLE_MUSIC_BUFFER_FRAMES);
     backgroundMusic = LoadMusicStream("music/03. Hunter's Dream.mp3");
     menuMusic = LoadMusicStream("music/Soul Of Cinder.mp3");
+    memTrackMusic(backgroundMusic, IDLE_MUSIC_BUFFER_FRAMES);
+    memTrackMusic(menuMusic, IDLE_MUSIC_BUFFER_FRAMES);
+    memTrackBytes(MEM_HEAP_POOLS, sizeof(particles) + sizeof(flightRecorder));
     
     SetTargetFPS(60);
+
+    // Input recording and replay:
+    //   --record <file>       record this session's input
+    //   --replay <file>       play a recording back at normal speed
+    //   --replay-fast <file>  play a recording back with rendering disabled and no frame cap
+    // Rendering:
+    //   --low-res             draw the world at a third of the window's resolution (640x360) and scale it up
+    //   --dynamic-res         lower the world's resolution, down to a third, when frames take longer than 1/60 s
+    //   --gpu-tiles           draw each tile layer in one shader pass (needs OpenGL 3.3)
+    //   --particle-stress     keep 100k particles alive around the camera
+    // Diagnostics:
+    //   --hitch-ms <ms>       frame time above which the flight recorder writes a hitch report (default 50)
+    //   --jobs <n>            worker threads for the job system (default one per core besides the main thread's,
+    //                         0 runs every job on the main thread)
+    //   --benchmark-transitions <n>
+    //                         walk through every portal n times, write transition-benchmark.json and quit
+    int jobWorkers = -1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--particle-stress") == 0) {
+            particleStress = true;
+        } else if (strcmp(argv[i], "--low-res") == 0) {
+            lowResInit(screenWidth, screenHeight, 3.0f);
+        } else if (strcmp(argv[i], "--dynamic-res") == 0) {
+            governorInit(screenWidth, screenHeight, 1.0f / 60.0f, 1.0f, 3.0f);
+        } else if (strcmp(argv[i], "--gpu-tiles") == 0) {
+            gpuTiles = true;
+        } else if (i + 1 >= argc) {
+            break;
+        } else if (strcmp(argv[i], "--hitch-ms") == 0) {
+            flightRecorder.thresholdMs = (float)atof(argv[i + 1]);
+        } else if (strcmp(argv[i], "--jobs") == 0) {
+            jobWorkers = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--benchmark-transitions") == 0 && benchmarkStart(atoi(argv[i + 1]))) {
+            SetTargetFPS(0);    // Measure the work, not the frame cap
+        } else if (strcmp(argv[i], "--record") == 0) {
+            inputStartRecording(argv[i + 1], (unsigned int)time(NULL));
+        } else if (strcmp(argv[i], "--replay") == 0) {
+            inputStartReplay(argv[i + 1]);
+        } else if (strcmp(argv[i], "--replay-fast") == 0 && inputStartReplay(argv[i + 1])) {
+            renderingEnabled = false;
+            SetTargetFPS(0);
+        }
+    }
+    if (lowResRenderer.target.id != 0) {
+        // The color texture plus the 24-bit depth renderbuffer raylib attaches, which is padded to four bytes
+        const Texture2D& target = lowResRenderer.target.texture;
+        memTrackTexture(MEM_VRAM_RENDER_TARGETS, target);
+        memTrackBytes(MEM_VRAM_RENDER_TARGETS, (long long)target.width * target.height * 4);
+    }
+    gameRandomState = (uint32_t)GetRandomValue(1, INT_MAX);
+    jobsInit(jobWorkers);
+
+    // The frame rate only drops on menus when someone is playing, not for replays and benchmarks
+    idleInit(60, renderingEnabled && !inputIsReplaying() && !transitionBenchmark.enabled);
+    double replayStartTime = GetTime();
     
     // Initialize camera
     camera.target = (Vector2){ 100, 0 };
@@ -292,7 +606,7 @@ int main()
     samurai.setDashSoundVolume(0.8f * masterVolume);
 
     StartScreen startScreen;
-    GameState gameState = START_SCREEN;
+    GameState gameState = transitionBenchmark.enabled ? MAIN_GAME : START_SCREEN;
 
     loadLevel();
 
@@ -318,9 +632,200 @@ int main()
     
     // Create a demon for Room2
     Demon* demon = nullptr;
+    int demonEntity = -1;   // The demon's ID in the spatial hash
+    DemonSnapshot demonSpawnState = {};  // The demon as it was when it spawned
+    // The demon lives in Room2, which is part of the corridor, so it's around wherever the samurai is in the corridor
+    // and not only in Room2. Its position is kept relative to the samurai's room like everything else, and whether
+    // it's near enough to update is up to the spatial hash.
+    auto demonAround = [&]() { return demon != nullptr && currentRoom >= 0; };
+    bool pausedFrameDrawn = false;  // The world has been drawn and captured since the game was paused
+    JobGraph tickJobs;              // Rebuilt every tick
+
+    // Checkpoint to respawn at, as a binary snapshot of the world and the characters
+    std::vector<uint8_t> checkpoint;
+    bool* portalFlags[] = { &mapSwitchedToRoom2, &mapSwitchedToRoom3, &mapSwitchedToRoom4, &mapSwitchedToMainLevel2,
+                            &mapSwitchedToRoom5, &mapSwitchedToRoom6, &mapSwitchedToRoom7, &mapSwitchedToRoom8 };
+    const int portalFlagCount = sizeof(portalFlags) / sizeof(portalFlags[0]);
+
+    // The world's state as a snapshot: what the game keeps itself, and the characters' state (CharacterSnapshot.h)
+    auto writeWorld = [&](SnapshotWriter& writer) {
+        writer.putString(map ? map->fileName : "");
+        writer.put(snapshotPackFlags(portalFlags, portalFlagCount));
+        writer.put(isComplete);
+        writer.put(showDialogue);
+        writer.putString(dialogueText);
+        writer.put(dialogueTimer);
+        writer.put(camera.target);
+        writer.put(gameRandomState);
+        writer.put(particleRandomState);
+        snapshotPut(writer, snapshotCapture(samurai));
+        writer.put(demon != nullptr);
+        if (demon != nullptr) {
+            snapshotPut(writer, snapshotCapture(*demon));
+        }
+        writer.finish();
+    };
+
+    // Put the world back as a snapshot describes it. The map is only loaded if the snapshot is from another one.
+    // Nothing changes unless the whole snapshot can be read.
+    auto readWorld = [&](const std::vector<uint8_t>& snapshot) -> bool {
+        SnapshotReader reader(snapshot);
+        std::string mapName = reader.getString();
+        uint32_t flags = reader.get<uint32_t>();
+        bool complete = reader.get<bool>();
+        bool dialogue = reader.get<bool>();
+        std::string text = reader.getString();
+        float timer = reader.get<float>();
+        Vector2 target = reader.get<Vector2>();
+        uint32_t gameSeed = reader.get<uint32_t>();
+        uint32_t particleSeed = reader.get<uint32_t>();
+        SamuraiSnapshot samuraiState;
+        snapshotGet(reader, samuraiState);
+        bool hasDemon = reader.get<bool>();
+        // A snapshot from before the demon spawned puts it back as it spawned, so it's there as new when Room2 is
+        // entered again. Spawned demons are never deleted.
+        DemonSnapshot demonState = demonSpawnState;
+        if (hasDemon) {
+            snapshotGet(reader, demonState);
+        }
+        // Everything is read before anything changes, so a snapshot that's cut short leaves the world as it was
+        if (!reader.ok) {
+            printf("Snapshot can't be read\n");
+            return false;
+        }
+
+        if (!map || strcmp(map->fileName, mapName.c_str()) != 0) {
+            // Moving within the corridor keeps its rooms that are loaded
+            int room = findRoom(mapName.c_str());
+            if (room < 0 || currentRoom < 0) {
+                releaseMap();
+            }
+            map = (room >= 0) ? enterRoom(room) : loadMap(TextFormat("maps/%s", mapName.c_str()));
+            if (!map) {
+                std::cerr << "Failed to load " << mapName << "!" << std::endl;
+            }
+        }
+
+        snapshotUnpackFlags(flags, portalFlags, portalFlagCount);
+        isComplete = complete;
+        gameover = false;
+        showDialogue = dialogue;
+        dialogueText = text;
+        dialogueTimer = timer;
+        camera.target = target;
+        gameRandomState = gameSeed;
+        particleRandomState = particleSeed;
+        particlesClear();
+
+        snapshotApply(samurai, samuraiState);
+        if (demon != nullptr) {
+            snapshotApply(*demon, demonState);
+            spatialMove(demonEntity, demon->rect);
+        }
+        return true;
+    };
+
+    auto saveCheckpoint = [&]() {
+        double start = GetTime();
+        SnapshotWriter writer(checkpoint);
+        writeWorld(writer);
+        printf("Checkpoint saved: %zu bytes in %.0f us\n", checkpoint.size(), (GetTime() - start) * 1000000.0);
+    };
+
+    auto restoreCheckpoint = [&]() -> bool {
+        if (checkpoint.empty() || isTransitioning) {
+            return false;
+        }
+        double start = GetTime();
+        if (!readWorld(checkpoint)) {
+            return false;
+        }
+
+        // The history goes on from here
+        historyDiscardAfter(-1);
+        printf("Checkpoint restored in %.0f us\n", (GetTime() - start) * 1000000.0);
+        return true;
+    };
+
+    // In the corridor, make the room the samurai has walked into theirs. It's already streamed in by then, since the
+    // camera is looking into it. Everything placed relative to the old room is moved to be relative to the new one,
+    // before this tick's update, so the rest of the tick doesn't see a difference.
+    bool* roomFlags[] = { &mapSwitchedToRoom2, &mapSwitchedToRoom3, &mapSwitchedToRoom4 };  // CryptRooms.world's order
+    auto walkBetweenRooms = [&]() {
+        if (currentRoom < 0 || isTransitioning || isPaused) {
+            return;
+        }
+        Rectangle rect = samurai.getRect();
+        Vector2 origin = roomOrigin();
+        float x = origin.x + rect.x + rect.width / 2;
+        int room = currentRoom;
+        if (room + 1 < (int)rooms->mapsLength && x >= rooms->maps[room + 1].x + ROOM_EDGE_MARGIN) {
+            room++;
+        } else if (room > 0 && x < rooms->maps[room].x - ROOM_EDGE_MARGIN) {
+            room--;
+        }
+        if (room == currentRoom || rooms->maps[room].map == nullptr) {
+            return;
+        }
+
+        Vector2 shift = Vector2Subtract(origin, Vector2{ (float)rooms->maps[room].x, (float)rooms->maps[room].y });
+        *roomFlags[currentRoom] = false;
+        *roomFlags[room] = true;
+        currentRoom = room;
+        map = rooms->maps[room].map;
+
+        rect.x += shift.x;
+        rect.y += shift.y;
+        samurai.setRect(rect);
+        camera.target = Vector2Add(camera.target, shift);
+        if (demon != nullptr) {
+            demon->rect.x += shift.x;
+            demon->rect.y += shift.y;
+            spatialMove(demonEntity, demon->rect);
+        }
+        particlesTranslate(shift);
+        printf("Walked into %s\n", map->fileName);
+
+        if (mapSwitchedToRoom3 && !showDialogue) {
+            triggerRoom3Dialogue();
+        }
+        saveCheckpoint();
+    };
+
+    // Rewind history, one snapshot per tick played. Holding Backspace goes back through it a tick at a time.
+    std::vector<uint8_t> historyState;
+    historyInit();
+
+    // The start of the game is the first checkpoint
+    saveCheckpoint();
 
     // Game loop
     while (!WindowShouldClose()) {
+        // Sample (or replay) this tick's input before anything reads it
+        if (!inputBeginTick()) {
+            printReplaySummary(replayStartTime);
+            safeExit();
+        }
+
+        TRACE_SCOPE("Frame");
+        flightBeginFrame();
+
+        // Measured, not recorded, frame time: it's about this machine's performance, not the simulation. Frames
+        // slowed down on purpose on the menus don't count.
+        if (!idleLastFrameIdled()) {
+            governorUpdate(GetFrameTime());
+        }
+
+        // Write the trace recorded so far (only in builds with -DFC_TRACING)
+        if (inputIsKeyPressed(KEY_F3)) {
+            traceWriteNext();
+        }
+
+        // Toggle the memory overlay
+        if (inputIsKeyPressed(KEY_F4)) {
+            memoryStats.showOverlay = !memoryStats.showOverlay;
+        }
+
         // Update currently playing music
         UpdateMusicStream(isPlayingMenuMusic ? menuMusic : backgroundMusic);
 
@@ -348,7 +853,10 @@ int main()
                 }
 
                 BeginDrawing();
-                startScreen.Draw();  // Draw the start screen
+                if (renderingEnabled) {
+                    startScreen.Draw();  // Draw the start screen
+                }
+                idleEndFrame(true, IsMusicStreamPlaying(menuMusic));
                 EndDrawing();
                 break;
             }
@@ -359,12 +867,12 @@ int main()
                     isPlayingMenuMusic = false;
                 }
 
-                if (IsKeyPressed(KEY_P)) {
+                if (inputIsKeyPressed(KEY_P)) {
                     isPaused = !isPaused;
                 }
                 
                 // Toggle music with M key
-                if (IsKeyPressed(KEY_M)) {
+                if (inputIsKeyPressed(KEY_M)) {
                     if (IsMusicStreamPlaying(backgroundMusic)) {
                         PauseMusicStream(backgroundMusic);
                     } else {
@@ -373,13 +881,53 @@ int main()
                 }
 
                 // Toggle collision box visibility with F1 key
-                if (IsKeyPressed(KEY_F1)) {
+                if (inputIsKeyPressed(KEY_F1)) {
                     showCollisionBoxes = !showCollisionBoxes;
                     printf("Collision boxes visibility: %s\n", showCollisionBoxes ? "ON" : "OFF");
                 }
 
+                // Quick save and load, which use the same checkpoint as respawning
+                if (inputIsKeyPressed(KEY_F5) && !isTransitioning && !gameover) {
+                    saveCheckpoint();
+                }
+                if (inputIsKeyPressed(KEY_F9)) {
+                    restoreCheckpoint();
+                }
+
+                // Rewind. Each tick Backspace is held steps back to the tick before the newest one kept, and the
+                // ticks after it are forgotten, so the game carries on from there once it's released.
+                bool rewinding = inputIsKeyDown(KEY_BACKSPACE) && !isPaused && !isTransitioning && !gameover &&
+                                 !historyEmpty();
+                if (rewinding) {
+                    long tick = historyRestore(historyNewestTick() - 1, historyState);
+                    if (tick >= 0 && readWorld(historyState)) {
+                        historyDiscardAfter(tick);
+                    }
+                }
+
+                // Nothing changes while paused, so once the first paused frame has been drawn and captured, the rest
+                // just show the capture under the pause screen and skip the update. A transition keeps running
+                // until it's done.
+                bool worldPaused = isPaused && !isTransitioning;
+                if (worldPaused && pausedFrameDrawn) {
+                    BeginDrawing();
+                    ClearBackground(BLACK);
+                    idleDrawWorld();
+                    drawPauseScreen();
+                    idleEndFrame(true, IsMusicStreamPlaying(backgroundMusic));
+                    EndDrawing();
+                    break;
+                }
+                pausedFrameDrawn = worldPaused;
+
                 // Get frame time for updates
-                float deltaTime = GetFrameTime();
+                float deltaTime = inputGetFrameTime();
+
+                if (!isPaused && particleStress) {
+                    particlesEmit(DEATH_EMITTER, camera.target, PARTICLE_STRESS_COUNT - particlesCount());
+                }
+
+                walkBetweenRooms();
 
                 if (!isPaused && !isComplete) {
                     // Update samurai character
@@ -414,6 +962,32 @@ int main()
 
                 checkTileCollisions(map, samurai);
 
+                // The transition benchmark puts the samurai straight into the next portal
+                if (const BenchmarkPortal* portal = benchmarkNextPortal(isTransitioning)) {
+                    if (portal->reset) {
+                        startTransition([&]() 
+                        {
+                            mapSwitchedToMainLevel2 = false;
+                            mapSwitchedToRoom5 = false;
+                            mapSwitchedToRoom6 = false;
+                            releaseMap();
+                            map = loadMap("maps/LevelDesign.tmx");
+
+                            Rectangle newPos = samurai.getRect();
+                            newPos.x = 200;
+                            newPos.y = 1500;
+                            samurai.setRect(newPos);
+                            camera.target = { newPos.x, newPos.y };
+                        });
+                    } else {
+                        Rectangle newPos = samurai.getRect();
+                        newPos.x = portal->x;
+                        newPos.y = portal->y;
+                        samurai.setRect(newPos);
+                        samurai.setVelocity(Vector2{ 0, 0 });
+                    }
+                }
+
                 // Update camera to follow player, ensuring it stays within map boundaries
                 Rectangle samuraiRect = samurai.getRect();
                 
@@ -426,28 +1000,75 @@ int main()
                     float halfScreenWidth = screenWidth / (2.0f * camera.zoom);
                     float halfScreenHeight = screenHeight / (2.0f * camera.zoom);
     
+                    // The map, or in the corridor all of its rooms
+                    Rectangle bounds = levelBounds();
+                    float minX = bounds.x + halfScreenWidth, maxX = bounds.x + bounds.width - halfScreenWidth;
+                    float minY = bounds.y + halfScreenHeight, maxY = bounds.y + bounds.height - halfScreenHeight;
+    
                     // Clamp X and Y positions with easing towards boundaries
-                    camera.target.x = Lerp(camera.target.x, Clamp(camera.target.x, halfScreenWidth, map->width * map->tileWidth - halfScreenWidth), 0.1f);
-                    camera.target.y = Lerp(camera.target.y, Clamp(camera.target.y, halfScreenHeight, map->height * map->tileHeight - halfScreenHeight), 0.1f);
+                    camera.target.x = Lerp(camera.target.x, Clamp(camera.target.x, minX, maxX), 0.1f);
+                    camera.target.y = Lerp(camera.target.y, Clamp(camera.target.y, minY, maxY), 0.1f);
     
                     // Ensure camera doesn't go out of bounds
-                    if (camera.target.x < halfScreenWidth) camera.target.x = halfScreenWidth + 100;
-                    if (camera.target.y < halfScreenHeight) camera.target.y = halfScreenHeight;
+                    if (camera.target.x < minX) camera.target.x = minX + 100;
+                    if (camera.target.y < minY) camera.target.y = minY;
     
                     // Camera zoom controls
-                    if (camera.target.x < halfScreenWidth) camera.target.x = halfScreenWidth;
-                    if (camera.target.x > map->width * 16 - halfScreenWidth) camera.target.x = map->width * 16 - halfScreenWidth;
-                    if (camera.target.y < halfScreenHeight) camera.target.y = halfScreenHeight;
-                    if (camera.target.y > map->height * 16 - halfScreenHeight) camera.target.y = map->height * 16 - halfScreenHeight;
+                    if (camera.target.x < minX) camera.target.x = minX;
+                    if (camera.target.x > maxX) camera.target.x = maxX;
+                    if (camera.target.y < minY) camera.target.y = minY;
+                    if (camera.target.y > maxY) camera.target.y = maxY;
                 } else {
                     // Stop moving the camera when the player is dead
                     camera.target = camera.target; // Keeps the camera locked in place
                 }
                 
+                // Keep the chunks the camera can see decoded when the map is infinite, and in the corridor stream
+                // its rooms in and out around the camera
+                Rectangle cameraView = { 0, 0, screenWidth / camera.zoom, screenHeight / camera.zoom };
+                cameraView.x = camera.target.x - cameraView.width / 2;
+                cameraView.y = camera.target.y - cameraView.height / 2;
+                if (currentRoom >= 0) {
+                    Vector2 origin = roomOrigin();
+                    UpdateWorldTMX(rooms, Rectangle{ cameraView.x + origin.x, cameraView.y + origin.y,
+                                                     cameraView.width, cameraView.height });
+                } else {
+                    UpdateChunksTMX(map, cameraView);
+                }
+
+                // Work that doesn't touch raylib or the characters runs on the job system, and is all done before
+                // anything below reads it
+                jobsGraphClear(tickJobs);
+                Rectangle navTarget = samurai.getRect();
+                jobsGraphAdd(tickJobs, [&]() {
+                    // Keep the enemies' flow field pointing at the samurai, the grid is rebuilt when the map changes
+                    TRACE_SCOPE("navUpdate");
+                    navUpdate(map, "Object Layer 1", navTarget);
+                });
+                // The particles are updated after the samurai's update and collisions, so bursts emitted before this
+                // point, e.g. the stress test's or the dust from a landing, take their first step in the same tick
+                double particleStart = GetTime();
+                if (!isPaused) {
+                    int integrate = jobsGraphAdd(tickJobs, [&]() {
+                        TRACE_SCOPE("particlesIntegrate");
+                        jobsParallelFor(particlesCount(), PARTICLE_JOB_GRAIN, [&](int begin, int end) {
+                            particlesIntegrate(begin, end, deltaTime);
+                        });
+                    });
+                    int compact = jobsGraphAdd(tickJobs, [&]() {
+                        TRACE_SCOPE("particlesCompact");
+                        particlesCompact();
+                        particleUpdateTime = GetTime() - particleStart;
+                    });
+                    jobsGraphDepend(tickJobs, compact, integrate);
+                }
+                jobsRunGraph(tickJobs);
+
                 // Switching map :o
+                // Portals are ignored while a transition is running, so standing in one can't restart the fade
 
                 // Main Level to Room2
-                if (!mapSwitchedToMainLevel2 && !mapSwitchedToRoom2 && samuraiRect.x >= 920 && samuraiRect.x <= 930 && samuraiRect.y == 1502) 
+                if (!isTransitioning && !mapSwitchedToMainLevel2 && !mapSwitchedToRoom2 && samuraiRect.x >= 920 && samuraiRect.x <= 930 && samuraiRect.y == 1502) 
                 {
                     // Debug output to confirm portal detection
                     printf("Portal to Room2 detected! Player position: %.2f, %.2f\n", samuraiRect.x, samuraiRect.y);
@@ -455,12 +1076,9 @@ int main()
                     {
                         mapSwitchedToRoom2 = true;
 
-                        if (map) 
-                        {
-                            UnloadTMX(map);
-                        }
+                        releaseMap();
 
-                    map = LoadTMX("maps/Room2.tmx");
+                    map = enterRoom("Room2.tmx");
                     if (!map) 
                     {
                         std::cerr << "Failed to load Room2.tmx!" << std::endl;
@@ -478,6 +1096,9 @@ int main()
                     if (demon == nullptr) {
                         Vector2 demonPos = { 1000.0f, 2165.0f }; // Position the demon in Room2 at same ground level as samurai
                         demon = new Demon(demonPos, 50.0f, 500);
+                        memTrackBytes(MEM_HEAP_CHARACTERS, sizeof(Demon));
+                        demonEntity = spatialInsert(demon->rect);
+                        demonSpawnState = snapshotCapture(*demon);
                         std::cout << "Demon spawned in Room2" << std::endl;
                     }
                     });
@@ -485,19 +1106,16 @@ int main()
 
                 
                 // Room2 to Main Level 
-                if (!mapSwitchedToMainLevel2 && mapSwitchedToRoom2 && samuraiRect.x >= 530 && samuraiRect.x <= 540 && samuraiRect.y >= 2170 && samuraiRect.y <= 2180) 
+                if (!isTransitioning && !mapSwitchedToMainLevel2 && mapSwitchedToRoom2 && samuraiRect.x >= 530 && samuraiRect.x <= 540 && samuraiRect.y >= 2170 && samuraiRect.y <= 2180) 
                 {
                     // Debug output to confirm return portal detection
                     printf("Return portal detected! Player position: %.2f, %.2f\n", samuraiRect.x, samuraiRect.y);
                     startTransition([&]() 
                     {
                         mapSwitchedToRoom2 = false;
-                        if (map) 
-                        {
-                            UnloadTMX(map);
-                        }
+                        releaseMap();
 
-                        map = LoadTMX("maps/LevelDesign.tmx");
+                        map = loadMap("maps/LevelDesign.tmx");
                         if (!map) 
                         {
                             std::cerr << "Failed to load LevelDesign.tmx!" << std::endl;
@@ -514,7 +1132,7 @@ int main()
                 }
                 
                 // Main Level to Room 3
-                if (!mapSwitchedToMainLevel2 && !mapSwitchedToRoom3 && samuraiRect.x >= 5415 && samuraiRect.x <= 5435 && samuraiRect.y >= 877 && samuraiRect.y <= 878)
+                if (!isTransitioning && !mapSwitchedToMainLevel2 && !mapSwitchedToRoom3 && samuraiRect.x >= 5415 && samuraiRect.x <= 5435 && samuraiRect.y >= 877 && samuraiRect.y <= 878)
 
                 {
                     printf("Portal to Room3 detected! Player position: %.2f, %.2f\n", samuraiRect.x, samuraiRect.y);
@@ -523,12 +1141,9 @@ int main()
 
                         mapSwitchedToRoom3 = true; 
 
-                        if (map) 
-                        {
-                            UnloadTMX(map);
-                        }
+                        releaseMap();
 
-                        map = LoadTMX("maps/Room3.tmx"); // Load Room 3
+                        map = enterRoom("Room3.tmx"); // Load Room 3
                         if (!map) 
                         {
                             printf("Failed to load Room3.tmx\n");
@@ -547,18 +1162,15 @@ int main()
                 }
                 
                 // Room 3 to Main Level 
-                if (!mapSwitchedToMainLevel2 && mapSwitchedToRoom3 && samuraiRect.x >= 1540 && samuraiRect.x <= 1570 && samuraiRect.y >= 2173 && samuraiRect.y <= 2175) 
+                if (!isTransitioning && !mapSwitchedToMainLevel2 && mapSwitchedToRoom3 && samuraiRect.x >= 1540 && samuraiRect.x <= 1570 && samuraiRect.y >= 2173 && samuraiRect.y <= 2175) 
                 {
                     printf("Portal back to LevelDesign detected! Player position: %.2f, %.2f\n", samuraiRect.x, samuraiRect.y);
                     startTransition([&]() 
                     {
 
                         mapSwitchedToRoom3 = false;
-                        if (map) 
-                        {
-                            UnloadTMX(map);
-                        }
-                        map = LoadTMX("maps/LevelDesign.tmx"); // Load the main level
+                        releaseMap();
+                        map = loadMap("maps/LevelDesign.tmx"); // Load the main level
                         if (!map) 
                         {
                             printf("Failed to Load TMX File: LevelDesign.tmx\n");
@@ -579,18 +1191,15 @@ int main()
                 }
                 
                 // Main Level to Room 4 
-                if (!mapSwitchedToMainLevel2 && !mapSwitchedToRoom4 && samuraiRect.x >= 8300 && samuraiRect.x <= 8320 && samuraiRect.y >= 2173 && samuraiRect.y <= 2176) 
+                if (!isTransitioning && !mapSwitchedToMainLevel2 && !mapSwitchedToRoom4 && samuraiRect.x >= 8300 && samuraiRect.x <= 8320 && samuraiRect.y >= 2173 && samuraiRect.y <= 2176) 
                 {
                     startTransition([&]() 
                     {
                         mapSwitchedToRoom4 = true;
 
-                        if (map) 
-                        {
-                            UnloadTMX(map);
-                        }
+                        releaseMap();
 
-                    map = LoadTMX("maps/Room4.tmx");
+                    map = enterRoom("Room4.tmx");
                     if (!map) 
                     {
                         std::cerr << "Failed to load Room4.tmx!" << std::endl;
@@ -606,18 +1215,15 @@ int main()
                 }
                 
                 // Room 4 to Main Level
-                if (!mapSwitchedToMainLevel2 && mapSwitchedToRoom4 && samuraiRect.x >= 3050 && samuraiRect.x <= 3070 && samuraiRect.y >= 2170.00) 
+                if (!isTransitioning && !mapSwitchedToMainLevel2 && mapSwitchedToRoom4 && samuraiRect.x >= 3050 && samuraiRect.x <= 3070 && samuraiRect.y >= 2170.00) 
                 {
                     startTransition([&]() 
                     {
                         mapSwitchedToRoom4 = false;
 
-                        if (map) 
-                        {
-                            UnloadTMX(map);
-                        }
+                        releaseMap();
 
-                    map = LoadTMX("maps/LevelDesign.tmx");
+                    map = loadMap("maps/LevelDesign.tmx");
                     if (!map) 
                     {
                         std::cerr << "Failed to load LevelDesign.tmx!" << std::endl;
@@ -634,18 +1240,15 @@ int main()
                 }
 
                 // Main Level to Main Level 2
-                if (!mapSwitchedToMainLevel2 && samuraiRect.x >= 18760 && samuraiRect.x <= 18840 && samuraiRect.y >= 3660) 
+                if (!isTransitioning && !mapSwitchedToMainLevel2 && samuraiRect.x >= 18760 && samuraiRect.x <= 18840 && samuraiRect.y >= 3660) 
                 {
                     startTransition([&]() 
                     {
                         mapSwitchedToMainLevel2 = true;
 
-                        if (map) 
-                        {
-                            UnloadTMX(map);
-                        }
+                        releaseMap();
 
-                    map = LoadTMX("maps/LevelDesign2.tmx");
+                    map = loadMap("maps/LevelDesign2.tmx");
                     if (!map) 
                     {
                         std::cerr << "Failed to load LevelDesign2.tmx!" << std::endl;
@@ -660,7 +1263,7 @@ int main()
                     });  
                 }
                 
-                if (mapSwitchedToMainLevel2 && !mapSwitchedToRoom5 && 
+                if (!isTransitioning && mapSwitchedToMainLevel2 && !mapSwitchedToRoom5 && 
                     samuraiRect.x > 4400 && samuraiRect.x < 4430 && 
                     samuraiRect.y > 2760 && samuraiRect.y < 2780) 
                    {
@@ -668,13 +1271,11 @@ int main()
                     mapSwitchedToRoom5 = true;
 
                     // Unload current map
-                    if (map) {
-                     UnloadTMX(map);
-                    }
+                    releaseMap();
 
                     // Load new TMX map (e.g., Room5)
                     
-                    map = LoadTMX("maps/Lv2RoomOne.tmx");
+                    map = loadMap("maps/Lv2RoomOne.tmx");
                     if (!map) {
                         std::cerr << "Failed to load Room5.tmx!" << std::endl;
                     }
@@ -692,7 +1293,7 @@ int main()
                 }
 
                 // New portal (e.g., Room5 -> Level2)
-                if (mapSwitchedToMainLevel2 && mapSwitchedToRoom5 &&
+                if (!isTransitioning && mapSwitchedToMainLevel2 && mapSwitchedToRoom5 &&
                     samuraiRect.x > 1000 && samuraiRect.x < 1100 &&
                     samuraiRect.y > 1200 && samuraiRect.y < 1300) 
                 {
@@ -700,11 +1301,9 @@ int main()
                     startTransition([&]() {
                     mapSwitchedToRoom5 = false;
 
-                 if (map) {
-                    UnloadTMX(map);
-                }
+                    releaseMap();
 
-                    map = LoadTMX("maps/LevelDesign2.tmx");
+                    map = loadMap("maps/LevelDesign2.tmx");
 
                     Rectangle newPos = samurai.getRect();
                     newPos.x = 3820;   // back to original portal
@@ -717,7 +1316,7 @@ int main()
 
 
                 // New portal (e.g., Level2 -> Room6)
-                if (mapSwitchedToMainLevel2 && !mapSwitchedToRoom6 && 
+                if (!isTransitioning && mapSwitchedToMainLevel2 && !mapSwitchedToRoom6 && 
                     samuraiRect.x > 5600 && samuraiRect.x < 5700 && 
                     samuraiRect.y > 3300 && samuraiRect.y < 3400) 
                    {
@@ -725,13 +1324,11 @@ int main()
                     mapSwitchedToRoom6 = true;
 
                     // Unload current map
-                    if (map) {
-                     UnloadTMX(map);
-                    }
+                    releaseMap();
 
                     // Load new TMX map 
                     
-                    map = LoadTMX("maps/Lv2RoomTwo.tmx");
+                    map = loadMap("maps/Lv2RoomTwo.tmx");
                     if (!map) {
                         std::cerr << "Failed to load Lv2RoomTwo.tmx!" << std::endl;
                     }
@@ -750,7 +1347,7 @@ int main()
 
 
                // New portal (e.g., Room6 -> Level2)
-                if (mapSwitchedToMainLevel2 && mapSwitchedToRoom6 && 
+                if (!isTransitioning && mapSwitchedToMainLevel2 && mapSwitchedToRoom6 && 
                     samuraiRect.x > 1600 && samuraiRect.x < 1610 && 
                     samuraiRect.y > 3300 && samuraiRect.y < 3500) 
                    {
@@ -758,13 +1355,11 @@ int main()
                     mapSwitchedToRoom6 = false;
 
                     // Unload current map
-                    if (map) {
-                     UnloadTMX(map);
-                    }
+                    releaseMap();
 
                     // Load new TMX map 
                     
-                    map = LoadTMX("maps/LevelDesign2.tmx");
+                    map = loadMap("maps/LevelDesign2.tmx");
                     if (!map) {
                         std::cerr << "Failed to load Room5.tmx!" << std::endl;
                     }
@@ -784,7 +1379,7 @@ int main()
                                 
                                    
                 // New portal (e.g., Level2 -> Room7)
-                if (mapSwitchedToMainLevel2 && !mapSwitchedToRoom7 && 
+                if (!isTransitioning && mapSwitchedToMainLevel2 && !mapSwitchedToRoom7 && 
                     samuraiRect.x > 7500 && samuraiRect.x < 7580 && 
                     samuraiRect.y > 2900 && samuraiRect.y < 3000) 
                    {
@@ -792,13 +1387,11 @@ int main()
                     mapSwitchedToRoom5 = true;
 
                     // Unload current map
-                    if (map) {
-                     UnloadTMX(map);
-                    }
+                    releaseMap();
 
                     // Load new TMX map (e.g., Room5)
                     
-                    map = LoadTMX("maps/Lv2Room3.tmx");
+                    map = loadMap("maps/Lv2Room3.tmx");
                     if (!map) {
                         std::cerr << "Failed to load Room5.tmx!" << std::endl;
                     }
@@ -816,7 +1409,7 @@ int main()
                 }
 
                 // New portal (e.g., Level2 -> Room8)
-                if (mapSwitchedToMainLevel2 && !mapSwitchedToRoom7 && 
+                if (!isTransitioning && mapSwitchedToMainLevel2 && !mapSwitchedToRoom7 && 
                     samuraiRect.x > 9100 && samuraiRect.x < 9200 && 
                     samuraiRect.y > 2000 && samuraiRect.y < 2100) 
                    {
@@ -824,13 +1417,11 @@ int main()
                     mapSwitchedToRoom5 = true;
 
                     // Unload current map
-                    if (map) {
-                     UnloadTMX(map);
-                    }
+                    releaseMap();
 
                     // Load new TMX map (e.g., Room5)
                     
-                    map = LoadTMX("maps/Lv2Room4.tmx");
+                    map = loadMap("maps/Lv2Room4.tmx");
                     if (!map) {
                         std::cerr << "Failed to load Room5.tmx!" << std::endl;
                     }
@@ -857,67 +1448,96 @@ int main()
                 }
                 
                 // Begin drawing
+                flightEndPhase(PHASE_UPDATE);
                 BeginDrawing();
                 ClearBackground(BLACK);
                 
-                // 2D camera mode for proper drawing
-                BeginMode2D(camera);
+                // 2D camera mode for proper drawing, into the low-res target when it's enabled
+                TRACE_BEGIN("Draw world");
+                lowResBeginWorld(camera);
                 
-                // Draw Background.
-                for (int x = 0; x < tilesX; x++) {
-                    for (int y = 0; y < tilesY; y++) {
-                        float posX = x * scaledW;
-                        float posY = y * scaledH;
-                        
-                        DrawTextureEx(background, Vector2{posX + bgposX, posY + bgposY}, 0.0f, scalebg, GRAY);
+                if (renderingEnabled) {
+                    // Draw Background.
+                    for (int x = 0; x < tilesX; x++) {
+                        for (int y = 0; y < tilesY; y++) {
+                            float posX = x * scaledW;
+                            float posY = y * scaledH;
+
+                            DrawTextureEx(background, Vector2{posX + bgposX, posY + bgposY}, 0.0f, scalebg, GRAY);
+                        }
                     }
+
+                    renderLevel();
+
+                    // Draw Samurai.
+                    samurai.draw();
                 }
                 
-                renderLevel();
-                
-                // Draw Samurai.
-                samurai.draw();
-                
-                // Update and draw demon if in Room2
-                if (mapSwitchedToRoom2 && demon != nullptr) {
-                    // Update demon animation
+                // Wake the entities near the camera. Only those are simulated and drawn, the rest sleep where they are.
+                Rectangle activeArea = { cameraView.x - ACTIVATION_MARGIN, cameraView.y - ACTIVATION_MARGIN,
+                                         cameraView.width + ACTIVATION_MARGIN * 2,
+                                         cameraView.height + ACTIVATION_MARGIN * 2 };
+                spatialActivate(activeArea);
+
+                // Update and draw demon if in the corridor and awake
+                if (demonAround() && spatialIsAwake(demonEntity)) {
+                    Rectangle demonRect = demon->rect;
+                    Vector2 demonPos = { demonRect.x + demonRect.width/2, demonRect.y + demonRect.height/2 };
+                    Vector2 samuraiPos = { samuraiRect.x + samuraiRect.width/2, samuraiRect.y + samuraiRect.height/2 };
+
+                    // Decide how often the demon thinks from how close it is and whether it's on screen
+                    if (!isPaused) {
+                        aiSchedule(&demonPos, 1, samuraiPos, cameraView);
+                    }
+
+                    // Update demon animation. Timers advance every tick whatever the demon's tier.
                     demon->updateAnimation();
                     
-                    // Update demon AI behavior
-                    if (!demon->isDead && !isPaused) {
-                        // Get distance to player
-                        Rectangle demonRect = demon->rect;
-                        Vector2 demonPos = { demonRect.x + demonRect.width/2, demonRect.y + demonRect.height/2 };
-                        Vector2 samuraiPos = { samuraiRect.x + samuraiRect.width/2, samuraiRect.y + samuraiRect.height/2 };
-                        float distance = Vector2Distance(demonPos, samuraiPos);
+                    // Update demon AI behavior. Off screen, the demon waits where it is.
+                    if (!demon->isDead && !isPaused && aiTier(0) != AI_TIER_FAR) {
+                        if (aiShouldThink(0)) {
+                            // Get distance to player
+                            float distance = Vector2Distance(demonPos, samuraiPos);
                         
-                        // Chase player if within range
-                        if (distance < demon->chaseRange && distance > demon->attackRange) {
-                            demon->state = WALK_DEMON;
-                            demon->direction = (samuraiPos.x < demonPos.x) ? LEFT_DEMON : RIGHT_DEMON;
+                            // Chase player if within range
+                            if (distance < demon->chaseRange && distance > demon->attackRange) {
+                                demon->state = WALK_DEMON;
+
+                                // Follow the flow field around gaps and walls, or head straight for the player
+                                // where it has no way there
+                                NavStep step = navSample(demonRect);
+                                if (step.valid && step.dx != 0) {
+                                    demon->direction = (step.dx < 0) ? LEFT_DEMON : RIGHT_DEMON;
+                                } else {
+                                    demon->direction = (samuraiPos.x < demonPos.x) ? LEFT_DEMON : RIGHT_DEMON;
+                                }
                             
-                            // Move toward player
-                            float moveDir = (demon->direction == LEFT_DEMON) ? -1.0f : 1.0f;
-                            demon->velocity.x = moveDir * demon->moveSpeed * 100.0f;
-                        } 
-                        // Attack if close enough
-                        else if (distance <= demon->attackRange) {
-                            if (!demon->isAttacking) {
-                                demon->attack();
+                                // Move toward player
+                                float moveDir = (demon->direction == LEFT_DEMON) ? -1.0f : 1.0f;
+                                demon->velocity.x = moveDir * demon->moveSpeed * 100.0f;
+                            } 
+                            // Attack if close enough
+                            else if (distance <= demon->attackRange) {
+                                if (!demon->isAttacking) {
+                                    demon->attack();
+                                }
+                            }
+                            // Idle if too far
+                            else {
+                                demon->state = IDLE_DEMON;
+                                demon->velocity.x = 0;
                             }
                         }
-                        // Idle if too far
-                        else {
-                            demon->state = IDLE_DEMON;
-                            demon->velocity.x = 0;
-                        }
-                        
-                        // Apply velocity
+
+                        // Keep moving with the last decision between thoughts
                         demon->applyVelocity();
+                        spatialMove(demonEntity, demon->rect);
                     }
                     
                     // Draw the demon
-                    demon->draw();
+                    if (renderingEnabled) {
+                        demon->draw();
+                    }
                     
                     // Check for collision between Samurai's attack and demon
                     CollisionBox* samuraiAttack = samurai.getCollisionBox(ATTACK);
@@ -925,7 +1545,17 @@ int main()
                         for (auto& box : demon->collisionBoxes) {
                             if (box.type == HURTBOX && box.active) {
                                 if (checkCharacterCollision(*samuraiAttack, box)) {
+                                    bool wasDead = demon->isDead;
                                     demon->takeDamage(25); // Samurai deals 25 damage
+
+                                    // Sparks off the blade and blood from the demon, or a burst if that was the end of it
+                                    Vector2 hitPos = { box.rect.x + box.rect.width / 2, box.rect.y + box.rect.height / 2 };
+                                    float hitDirection = (hitPos.x < samuraiRect.x + samuraiRect.width / 2) ? -1.0f : 1.0f;
+                                    particlesEmit(SPARK_EMITTER, hitPos, 6, hitDirection);
+                                    particlesEmit(BLOOD_EMITTER, hitPos, 8, hitDirection);
+                                    if (!wasDead && demon->isDead) {
+                                        particlesEmit(DEATH_EMITTER, hitPos, 400);
+                                    }
                                     //samuraiAttack->active = false; // Prevent multiple hits
                                     break;
                                 }
@@ -939,14 +1569,20 @@ int main()
                         if (box.type == ATTACK && box.active) {
                             if (samuraiHurtbox && samuraiHurtbox->active) {
                                 if (checkCharacterCollision(box, *samuraiHurtbox)) {
+                                    Vector2 hitPos = { samuraiHurtbox->rect.x + samuraiHurtbox->rect.width / 2,
+                                                       samuraiHurtbox->rect.y + samuraiHurtbox->rect.height / 2 };
+                                    float hitDirection = (box.rect.x < hitPos.x) ? 1.0f : -1.0f;
+
                                     // Check if samurai is blocking to reduce damage
                                     if (samurai.isBlocking()) {
+                                        particlesEmit(SPARK_EMITTER, hitPos, 16, hitDirection);
                                         // Apply damage reduction when blocking (half damage)
                                         int reducedDamage = static_cast<int>(15 * samurai.getBlockDamageReduction());
                                         samurai.takeDamage(reducedDamage);
                                         std::cout << "Blocked attack! Reduced damage: " << reducedDamage << std::endl;
                                     } else {
                                         samurai.takeDamage(15); // Full damage when not blocking
+                                        particlesEmit(BLOOD_EMITTER, hitPos, 20, hitDirection);
                                     }
                                     box.active = false; // Prevent multiple hits
                                     break;
@@ -959,13 +1595,19 @@ int main()
                 std::cout << "X: " << samurai.getRect().x << std::endl;
                 std::cout << "Y: " << samurai.getRect().y << std::endl;
 
-                // End camera mode and finalize drawing
-                EndMode2D();
+                if (renderingEnabled) {
+                    particlesDraw(cameraView);
+                }
+
+                // End camera mode and finalize drawing. Everything from here on is HUD at native resolution.
+                lowResEndWorld();
+                TRACE_END();
+                flightEndPhase(PHASE_DRAW_WORLD);
                 
                 // Draw dialogue textbox after 2D mode
                 if (showDialogue) {
                     // Update dialogue timer
-                    dialogueTimer += GetFrameTime();
+                    dialogueTimer += inputGetFrameTime();
                     
                     // Create a visually appealing dialogue box with fixed screen coordinates (not affected by camera)
                     int boxWidth = 800;
@@ -973,19 +1615,25 @@ int main()
                     int boxX = GetScreenWidth() / 2 - boxWidth / 2;
                     int boxY = 100; // Position at top of screen for better visibility
 
-                    // Draw the dialogue box with a semi-transparent background and thicker border
-                    DrawRectangle(boxX, boxY, boxWidth, boxHeight, Fade(BLACK, 0.9f));
-                    DrawRectangleLines(boxX, boxY, boxWidth, boxHeight, WHITE);
-                    DrawRectangleLines(boxX+1, boxY+1, boxWidth-2, boxHeight-2, WHITE); // Double border for emphasis
-                    
-                    // Draw a title for the dialogue box
-                    DrawText("RESIDENT GNOME", boxX + boxWidth/2 - MeasureText("MYSTERIOUS VOICE", 20)/2, boxY + 15, 20, GOLD);
-                    
-                    // Draw the dialogue text centered in the box
-                    DrawText(dialogueText.c_str(), boxX + 20, boxY + 50, 24, WHITE);
+                    // The box is cached and only drawn again when the text changes
+                    Rectangle dialogueBounds = { (float)boxX, (float)boxY, (float)boxWidth, (float)boxHeight };
+                    if (hudBeginWidget(HUD_DIALOGUE, dialogueBounds, hudHash(dialogueText.c_str()))) {
+                        // Draw the dialogue box with a semi-transparent background and thicker border
+                        DrawRectangle(boxX, boxY, boxWidth, boxHeight, Fade(BLACK, 0.9f));
+                        DrawRectangleLines(boxX, boxY, boxWidth, boxHeight, WHITE);
+                        DrawRectangleLines(boxX+1, boxY+1, boxWidth-2, boxHeight-2, WHITE); // Double border for emphasis
+
+                        // Draw a title for the dialogue box
+                        DrawText("RESIDENT GNOME", boxX + boxWidth/2 - MeasureText("MYSTERIOUS VOICE", 20)/2, boxY + 15, 20, GOLD);
+
+                        // Draw the dialogue text centered in the box
+                        DrawText(dialogueText.c_str(), boxX + 20, boxY + 50, 24, WHITE);
+                        hudEndWidget();
+                    }
+                    hudDrawWidget(HUD_DIALOGUE);
 
                     // Print debug info when F2 is pressed
-                    if (IsKeyPressed(KEY_F2)) {
+                    if (inputIsKeyPressed(KEY_F2)) {
                         printf("Dialogue active: %s (Timer: %.2f/%.2f)\n", 
                                dialogueText.c_str(), dialogueTimer, dialogueDuration);
                     }
@@ -1004,34 +1652,74 @@ int main()
                 int instructionsY = screenHeight - 1050;
                 int lineHeight = 25;
 
-                DrawText("GAME CONTROLS:", 10, instructionsY, 20, WHITE);
-                DrawText("W or Up: Jump ", 10, instructionsY + lineHeight, 20, WHITE);
-                DrawText("A/D or Left/Right: Move", 10, instructionsY + lineHeight*2, 20, WHITE);
-                DrawText("Space: Attack", 10, instructionsY + lineHeight*3, 20, WHITE);
-                DrawText("Double-tap A/D: Dash", 10, instructionsY + lineHeight*4, 20, WHITE);
-                DrawText("M: Toggle music", 10, instructionsY + lineHeight*5, 20, WHITE);
-                DrawText("P: Pause", 10, instructionsY + lineHeight*6, 20, WHITE);
-                
-                if (isPaused) {
-                    DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(BLACK, 0.5f));
-                    DrawText("PAUSED", GetScreenWidth()/2 - 50, GetScreenHeight()/2 - 10, 30, WHITE);
-                    DrawText("Press 'P' to resume", GetScreenWidth()/2 - 100, GetScreenHeight()/2 + 30, 20, WHITE);
-
-                    // Define the exit button area
-                    Rectangle exitButton = { static_cast<float>(GetScreenWidth()) / 2 - 75, 
-                        static_cast<float>(GetScreenHeight()) / 2 + 60, 
-                        150.0f, 40.0f };
+                // The controls never change, so they're drawn once and cached
+                Rectangle controlsBounds = { 10.0f, (float)instructionsY, 320.0f, (float)(lineHeight*7) };
+                if (hudBeginWidget(HUD_CONTROLS, controlsBounds, 0)) {
+                    DrawText("GAME CONTROLS:", 10, instructionsY, 20, WHITE);
+                    DrawText("W or Up: Jump ", 10, instructionsY + lineHeight, 20, WHITE);
+                    DrawText("A/D or Left/Right: Move", 10, instructionsY + lineHeight*2, 20, WHITE);
+                    DrawText("Space: Attack", 10, instructionsY + lineHeight*3, 20, WHITE);
+                    DrawText("Double-tap A/D: Dash", 10, instructionsY + lineHeight*4, 20, WHITE);
+                    DrawText("M: Toggle music", 10, instructionsY + lineHeight*5, 20, WHITE);
+                    DrawText("P: Pause", 10, instructionsY + lineHeight*6, 20, WHITE);
+                    hudEndWidget();
+                }
+                hudDrawWidget(HUD_CONTROLS);
 
+                if (showCollisionBoxes || particleStress) {
+                    DrawText(TextFormat("Particles: %d (update %.2f ms)", particlesCount(), particleUpdateTime * 1000.0),
+                             10, instructionsY + lineHeight*9, 20, YELLOW);
+                }
 
-                    // Draw the exit button
-                    DrawRectangleRec(exitButton, DARKGRAY);
-                    DrawText("Exit", GetScreenWidth()/2 - 20, GetScreenHeight()/2 + 70, 20, WHITE);
+                // Dynamic resolution state, with the rest of the debug visuals
+                if (showCollisionBoxes && governor.enabled) {
+                    char governorText[192];
+                    governorDescribe(governorText, sizeof(governorText));
+                    DrawText(governorText, 10, instructionsY + lineHeight*8, 20, YELLOW);
+                }
+                if (showCollisionBoxes) {
+                    char entityText[64];
+                    spatialDescribe(entityText, sizeof(entityText));
+                    DrawText(entityText, 10, instructionsY + lineHeight*12, 20, YELLOW);
+                }
+                if (showCollisionBoxes && demonAround()) {
+                    char aiText[128];
+                    aiDescribe(aiText, sizeof(aiText));
+                    DrawText(aiText, 10, instructionsY + lineHeight*10, 20, YELLOW);
+                }
+                if (showCollisionBoxes) {
+                    char navText[128];
+                    navDescribe(navText, sizeof(navText));
+                    DrawText(navText, 10, instructionsY + lineHeight*11, 20, YELLOW);
+                }
+                if (showCollisionBoxes) {
+                    char jobsText[256];
+                    jobsDescribe(jobsText, sizeof(jobsText));
+                    DrawText(jobsText, 10, instructionsY + lineHeight*15, 20, YELLOW);
+                }
+                if (showCollisionBoxes) {
+                    char historyText[128];
+                    historyDescribe(historyText, sizeof(historyText));
+                    DrawText(historyText, 10, instructionsY + lineHeight*14, 20, YELLOW);
+                }
+                if (showCollisionBoxes) {
+                    char hudText[64];
+                    hudDescribe(hudText, sizeof(hudText));
+                    DrawText(hudText, 10, instructionsY + lineHeight*13, 20, YELLOW);
+                }
 
-                    // Check if the exit button is clicked
-                    if (CheckCollisionPointRec(GetMousePosition(), exitButton) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-                        safeExit();
+                // Memory accounting is refreshed every frame so budget warnings print even with the overlay hidden
+                memUpdate(map, currentRoom >= 0 ? rooms : nullptr);
+                if (memoryStats.showOverlay) {
+                    memDrawOverlay(GetScreenWidth() - 580, 20);
+                }
+                
+                if (isPaused) {
+                    // Keep the world as it looks now, later paused frames show this instead of drawing it
+                    if (!isTransitioning) {
+                        idleCaptureWorld();
                     }
-
+                    drawPauseScreen();
                     samurai.pauseSounds();
                 } else if(isComplete) {
                     // Draw completion screen with improved UI layout
@@ -1041,29 +1729,37 @@ int main()
                     const int centerX = GetScreenWidth() / 2;
                     const int centerY = GetScreenHeight() / 2;
 
-                    DrawText("GAME COMPLETED!", centerX - MeasureText("GAME COMPLETED!", 40) / 2, centerY - 100, 40, GOLD);
-                    DrawText("Congratulations!", centerX - MeasureText("Congratulations!", 30) / 2, centerY - 50, 30, WHITE);
-                    DrawText("Press 'E' to exit", centerX - MeasureText("Press 'E' to exit", 20) / 2, centerY + 20, 20, LIGHTGRAY);
-
                     // Define the exit button
                     Rectangle exitButton = { static_cast<float>(centerX - 100), 
                                             static_cast<float>(centerY + 60), 
                                             200.0f, 50.0f };
-
-                    // Draw the exit button with a hover effect
-                    Color exitButtonColor = CheckCollisionPointRec(GetMousePosition(), exitButton) ? LIGHTGRAY : DARKGRAY;
-                    DrawRectangleRec(exitButton, exitButtonColor);
-                    DrawText("Exit", centerX - MeasureText("Exit", 25) / 2, centerY + 75, 25, WHITE);
+                    bool exitHovered = CheckCollisionPointRec(inputGetMousePosition(), exitButton);
+
+                    // Cached, and drawn again only when the mouse moves on or off the button
+                    Rectangle completeBounds = { static_cast<float>(centerX - 250), static_cast<float>(centerY - 110),
+                                                 500.0f, 230.0f };
+                    if (hudBeginWidget(HUD_COMPLETE, completeBounds, exitHovered)) {
+                        DrawText("GAME COMPLETED!", centerX - MeasureText("GAME COMPLETED!", 40) / 2, centerY - 100, 40, GOLD);
+                        DrawText("Congratulations!", centerX - MeasureText("Congratulations!", 30) / 2, centerY - 50, 30, WHITE);
+                        DrawText("Press 'E' to exit", centerX - MeasureText("Press 'E' to exit", 20) / 2, centerY + 20, 20, LIGHTGRAY);
+
+                        // Draw the exit button with a hover effect
+                        Color exitButtonColor = exitHovered ? LIGHTGRAY : DARKGRAY;
+                        DrawRectangleRec(exitButton, exitButtonColor);
+                        DrawText("Exit", centerX - MeasureText("Exit", 25) / 2, centerY + 75, 25, WHITE);
+                        hudEndWidget();
+                    }
+                    hudDrawWidget(HUD_COMPLETE);
 
                     // Check if the exit button is clicked
-                    if (CheckCollisionPointRec(GetMousePosition(), exitButton) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+                    if (CheckCollisionPointRec(inputGetMousePosition(), exitButton) && inputIsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
                         if (startScreen.ShouldStartGame()) {
                             safeExit();
                         }
                     }
 
                     // Handle key press for exiting
-                    if (IsKeyPressed(KEY_E)) {
+                    if (inputIsKeyPressed(KEY_E)) {
                         if (startScreen.ShouldStartGame()) {
                             safeExit();
                         }
@@ -1076,29 +1772,43 @@ int main()
                     const int centerX = GetScreenWidth() / 2;
                     const int centerY = GetScreenHeight() / 2;
 
-                    // Draw Game Over text
-                    DrawText("GAME OVER", centerX - MeasureText("GAME OVER", 50) / 2, centerY - 100, 50, RED);
-                    DrawText("Better luck next time!", centerX - MeasureText("Better luck next time!", 25) / 2, centerY - 50, 25, WHITE);
-
                     // Define the Exit button
                     Rectangle exitButton = { static_cast<float>(centerX - 100), 
                                             static_cast<float>(centerY + 30), 
                                             200.0f, 50.0f };
-
-                    // Draw the Exit button with hover effect
-                    Color exitButtonColor = CheckCollisionPointRec(GetMousePosition(), exitButton) ? LIGHTGRAY : DARKGRAY;
-                    DrawRectangleRec(exitButton, exitButtonColor);
-                    DrawText("Exit", centerX - MeasureText("Exit", 25) / 2, centerY + 45, 25, WHITE);
+                    bool exitHovered = CheckCollisionPointRec(inputGetMousePosition(), exitButton);
+
+                    // Cached like the completion screen
+                    Rectangle gameOverBounds = { static_cast<float>(centerX - 250), static_cast<float>(centerY - 110),
+                                                 500.0f, 200.0f };
+                    if (hudBeginWidget(HUD_GAME_OVER, gameOverBounds, exitHovered)) {
+                        // Draw Game Over text
+                        DrawText("GAME OVER", centerX - MeasureText("GAME OVER", 50) / 2, centerY - 100, 50, RED);
+                        DrawText("Better luck next time!", centerX - MeasureText("Better luck next time!", 25) / 2, centerY - 50, 25, WHITE);
+                        DrawText("Press 'R' to respawn", centerX - MeasureText("Press 'R' to respawn", 20) / 2, centerY - 10, 20, LIGHTGRAY);
+
+                        // Draw the Exit button with hover effect
+                        Color exitButtonColor = exitHovered ? LIGHTGRAY : DARKGRAY;
+                        DrawRectangleRec(exitButton, exitButtonColor);
+                        DrawText("Exit", centerX - MeasureText("Exit", 25) / 2, centerY + 45, 25, WHITE);
+                        hudEndWidget();
+                    }
+                    hudDrawWidget(HUD_GAME_OVER);
 
                     // Check if the Exit button is clicked
-                    if (CheckCollisionPointRec(GetMousePosition(), exitButton) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+                    if (CheckCollisionPointRec(inputGetMousePosition(), exitButton) && inputIsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
                         safeExit(); // Close the game window
                     }
 
                     // Handle key press for exiting
-                    if (IsKeyPressed(KEY_E)) {
+                    if (inputIsKeyPressed(KEY_E)) {
                         safeExit();
                     }
+
+                    // Respawn at the last checkpoint
+                    if (inputIsKeyPressed(KEY_R)) {
+                        restoreCheckpoint();
+                    }
                 }
                 else 
                 {
@@ -1117,7 +1827,11 @@ int main()
 
                             if (transitionAction) 
                             {
+                                flightEndPhase(PHASE_DRAW_HUD);
+                                double actionStart = GetTime();
                                 transitionAction();  // run the map change
+                                benchmarkRecordAction(GetTime() - actionStart);
+                                flightEndPhase(PHASE_TRANSITION);
                             }
 
                             transitionFadeIn = true;
@@ -1136,15 +1850,46 @@ int main()
                                 triggerRoom3Dialogue();
                                 printf("Dialogue triggered after transition: %s\n", dialogueText.c_str());
                             }
+
+                            // Entering a room is a checkpoint
+                            if (!gameover) {
+                                saveCheckpoint();
+                            }
                         }
                     }
                 }
                 
+                flightEndPhase(PHASE_DRAW_HUD);
+                idleEndFrame(isPaused, IsMusicStreamPlaying(backgroundMusic));
+                TRACE_BEGIN("EndDrawing");
                 EndDrawing();
+                TRACE_END();
+                flightEndPhase(PHASE_PRESENT);
+
+                // Keep this frame in the flight recorder, which writes a report if it was a hitch
+                int entities = (samurai.checkDeath() ? 0 : 1) + ((demon != nullptr && !demon->isDead) ? 1 : 0);
+                flightEndFrame(map ? map->fileName : "", Vector2{ samurai.getRect().x, samurai.getRect().y }, entities,
+                               particlesCount(), isTransitioning, transitionAlpha);
+
+                if (benchmarkEndFrame(isTransitioning, map ? map->fileName : nullptr, gameover)) {
+                    safeExit();
+                }
+
+                // Keep this tick for rewinding, unless it was spent rewinding or nothing was playing
+                if (!rewinding && !isPaused && !isTransitioning && !gameover) {
+                    SnapshotWriter writer(historyState);
+                    writeWorld(writer);
+                    historyCapture(inputState.ticks, historyState);
+                }
 
 
                 break;
             }
         }
     }
+
+    inputShutdown();
+    traceWriteNext();
+    lowResShutdown();
+    jobsShutdown();
 }
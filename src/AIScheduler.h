@@ -0,0 +1,126 @@
+#ifndef AI_SCHEDULER_H
+#define AI_SCHEDULER_H
+
+#include "raylib.h"
+#include "raymath.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+// Level-of-detail scheduling for enemy AI. Each tick, every enemy is put in a tier by where it is:
+//   - near: close to the player. Thinks every tick, so fights feel exactly as before.
+//   - mid: elsewhere on screen. Thinks every few ticks. Enemies are split into buckets by index, one bucket per tick,
+//     so they don't all think on the same one.
+//   - far: off screen. Doesn't think or move, only its timers (animations, cooldowns) advance.
+// Thinking is deciding what to do next: chasing, attacking or idling. Enemies that aren't far still move every tick
+// with the velocity they last decided on, so slower thinking doesn't make them stutter.
+//
+// On top of the tiers, at most AI_THINK_BUDGET enemies think per tick. Near enemies always think. Mid enemies that are
+// due share what's left, the longest waiting first, and the rest wait for the next tick. The budget counts enemies
+// rather than measuring time so the schedule is the same on every machine, which keeps input replays in sync.
+
+const float AI_NEAR_DISTANCE = 200.0f;   // Pixels from the player within which an enemy thinks every tick
+const float AI_VIEW_MARGIN = 64.0f;      // Pixels outside the camera's view still treated as on screen
+const int AI_MID_INTERVAL = 4;           // Ticks between thoughts for mid enemies
+const int AI_THINK_BUDGET = 64;          // Enemies that may think in one tick
+
+enum AITier {
+    AI_TIER_NEAR,
+    AI_TIER_MID,
+    AI_TIER_FAR
+};
+
+struct AIAgent {
+    AITier tier;
+    long lastThink;              // Tick the agent last thought on
+    bool think;                  // Whether it thinks this tick
+};
+
+struct AIScheduler {
+    std::vector<AIAgent> agents;
+    std::vector<int> due;        // Scratch list of mid agents due to think
+    long tick = 0;
+    int tierCounts[3] = { 0 };
+    int thinks = 0;              // Agents that thought this tick
+    int deferred = 0;            // Due agents pushed to a later tick by the budget
+};
+
+inline AIScheduler aiScheduler;
+
+// Decide which agents think this tick. Agents are identified by their index in positions, which must stay the same
+// from tick to tick. Call once per tick, before updating any of them.
+inline void aiSchedule(const Vector2* positions, int count, Vector2 player, Rectangle view) {
+    AIScheduler& scheduler = aiScheduler;
+    scheduler.tick++;
+
+    // New agents start overdue, so they think as soon as they're seen
+    while ((int)scheduler.agents.size() < count) {
+        scheduler.agents.push_back(AIAgent{ AI_TIER_FAR, scheduler.tick - AI_MID_INTERVAL - 1, false });
+    }
+    scheduler.agents.resize(count);
+
+    Rectangle onScreen = { view.x - AI_VIEW_MARGIN, view.y - AI_VIEW_MARGIN, view.width + AI_VIEW_MARGIN * 2,
+                           view.height + AI_VIEW_MARGIN * 2 };
+    scheduler.tierCounts[AI_TIER_NEAR] = scheduler.tierCounts[AI_TIER_MID] = scheduler.tierCounts[AI_TIER_FAR] = 0;
+    scheduler.thinks = 0;
+    scheduler.due.clear();
+
+    for (int i = 0; i < count; i++) {
+        AIAgent& agent = scheduler.agents[i];
+        if (Vector2Distance(positions[i], player) < AI_NEAR_DISTANCE) {
+            agent.tier = AI_TIER_NEAR;
+        } else if (CheckCollisionPointRec(positions[i], onScreen)) {
+            agent.tier = AI_TIER_MID;
+        } else {
+            agent.tier = AI_TIER_FAR;
+        }
+        scheduler.tierCounts[agent.tier]++;
+
+        agent.think = (agent.tier == AI_TIER_NEAR);
+        if (agent.think) {
+            agent.lastThink = scheduler.tick;
+            scheduler.thinks++;
+        } else if (agent.tier == AI_TIER_MID) {
+            // Due on its bucket's tick, or straight away if it missed one, e.g. to the budget or by being far
+            long waited = scheduler.tick - agent.lastThink;
+            bool bucketTick = (scheduler.tick + i) % AI_MID_INTERVAL == 0;
+            if ((bucketTick && waited >= AI_MID_INTERVAL) || waited > AI_MID_INTERVAL) {
+                scheduler.due.push_back(i);
+            }
+        }
+    }
+
+    // Whatever budget the near agents left goes to the mid agents that have waited longest
+    int remaining = std::max(AI_THINK_BUDGET - scheduler.thinks, 0);
+    if ((int)scheduler.due.size() > remaining) {
+        std::nth_element(scheduler.due.begin(), scheduler.due.begin() + remaining, scheduler.due.end(),
+                         [&](int a, int b) { return scheduler.agents[a].lastThink < scheduler.agents[b].lastThink; });
+    }
+    int granted = std::min((int)scheduler.due.size(), remaining);
+    for (int n = 0; n < granted; n++) {
+        AIAgent& agent = scheduler.agents[scheduler.due[n]];
+        agent.think = true;
+        agent.lastThink = scheduler.tick;
+    }
+    scheduler.thinks += granted;
+    scheduler.deferred = (int)scheduler.due.size() - granted;
+}
+
+// Agents that haven't been scheduled yet are treated as far away
+inline AITier aiTier(int agent) {
+    return (agent < (int)aiScheduler.agents.size()) ? aiScheduler.agents[agent].tier : AI_TIER_FAR;
+}
+
+inline bool aiShouldThink(int agent) {
+    return agent < (int)aiScheduler.agents.size() && aiScheduler.agents[agent].think;
+}
+
+// One line for the debug overlay
+inline void aiDescribe(char* buffer, int bufferSize) {
+    const AIScheduler& scheduler = aiScheduler;
+    snprintf(buffer, bufferSize, "AI: %d near, %d mid, %d far, %d thinking this tick, %d deferred",
+             scheduler.tierCounts[AI_TIER_NEAR], scheduler.tierCounts[AI_TIER_MID], scheduler.tierCounts[AI_TIER_FAR],
+             scheduler.thinks, scheduler.deferred);
+}
+
+#endif // AI_SCHEDULER_H
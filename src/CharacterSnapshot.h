@@ -0,0 +1,153 @@
+#ifndef CHARACTER_SNAPSHOT_H
+#define CHARACTER_SNAPSHOT_H
+
+#include "raylib.h"
+#include "Samurai.h"
+#include "Demon.h"
+#include "WorldSnapshot.h"
+#include <utility>
+
+// The characters' part of a world snapshot (WorldSnapshot.h): everything about them that changes as the game plays,
+// i.e. position, health, animation and cooldowns. It's read and set through the Samurai's accessors and the Demon's
+// fields, never by copying the objects, since those own textures and sounds. What they load once stays as it is.
+//
+// Each character has a plain struct of its state, captured from it, stored field by field, read back and applied to
+// it. Reading and applying are separate so the whole snapshot can be read, and found to be complete, before anything
+// is changed. Bump SNAPSHOT_VERSION whenever a field is added here.
+
+struct SamuraiSnapshot {
+    Rectangle rect;
+    Vector2 velocity;
+    int health;
+    decltype(std::declval<const Samurai&>().getDirection()) direction;
+    decltype(std::declval<const Samurai&>().getAnimation()) animation;
+    int frame;
+    float frameTimer;
+    bool jumping;
+    float attackCooldown;
+    float dashCooldown;
+};
+
+struct DemonSnapshot {
+    Rectangle rect;
+    Vector2 velocity;
+    int health;
+    decltype(Demon::direction) direction;
+    decltype(Demon::state) state;
+    int currentFrame;
+    float frameTimer;
+    float attackCooldown;
+    bool isAttacking;
+    bool isDead;
+};
+
+inline SamuraiSnapshot snapshotCapture(const Samurai& samurai) {
+    SamuraiSnapshot state;
+    state.rect = samurai.getRect();
+    state.velocity = samurai.getVelocity();
+    state.health = samurai.getHealth();
+    state.direction = samurai.getDirection();
+    state.animation = samurai.getAnimation();
+    state.frame = samurai.getFrame();
+    state.frameTimer = samurai.getFrameTimer();
+    state.jumping = samurai.isJumping();
+    state.attackCooldown = samurai.getAttackCooldown();
+    state.dashCooldown = samurai.getDashCooldown();
+    return state;
+}
+
+inline DemonSnapshot snapshotCapture(const Demon& demon) {
+    DemonSnapshot state;
+    state.rect = demon.rect;
+    state.velocity = demon.velocity;
+    state.health = demon.health;
+    state.direction = demon.direction;
+    state.state = demon.state;
+    state.currentFrame = demon.currentFrame;
+    state.frameTimer = demon.frameTimer;
+    state.attackCooldown = demon.attackCooldown;
+    state.isAttacking = demon.isAttacking;
+    state.isDead = demon.isDead;
+    return state;
+}
+
+// Field by field rather than as one struct, so no padding ends up in the snapshot
+inline void snapshotPut(SnapshotWriter& writer, const SamuraiSnapshot& state) {
+    writer.put(state.rect);
+    writer.put(state.velocity);
+    writer.put(state.health);
+    writer.put(state.direction);
+    writer.put(state.animation);
+    writer.put(state.frame);
+    writer.put(state.frameTimer);
+    writer.put(state.jumping);
+    writer.put(state.attackCooldown);
+    writer.put(state.dashCooldown);
+}
+
+inline void snapshotPut(SnapshotWriter& writer, const DemonSnapshot& state) {
+    writer.put(state.rect);
+    writer.put(state.velocity);
+    writer.put(state.health);
+    writer.put(state.direction);
+    writer.put(state.state);
+    writer.put(state.currentFrame);
+    writer.put(state.frameTimer);
+    writer.put(state.attackCooldown);
+    writer.put(state.isAttacking);
+    writer.put(state.isDead);
+}
+
+inline void snapshotGet(SnapshotReader& reader, SamuraiSnapshot& state) {
+    state.rect = reader.get<Rectangle>();
+    state.velocity = reader.get<Vector2>();
+    state.health = reader.get<int>();
+    state.direction = reader.get<decltype(state.direction)>();
+    state.animation = reader.get<decltype(state.animation)>();
+    state.frame = reader.get<int>();
+    state.frameTimer = reader.get<float>();
+    state.jumping = reader.get<bool>();
+    state.attackCooldown = reader.get<float>();
+    state.dashCooldown = reader.get<float>();
+}
+
+inline void snapshotGet(SnapshotReader& reader, DemonSnapshot& state) {
+    state.rect = reader.get<Rectangle>();
+    state.velocity = reader.get<Vector2>();
+    state.health = reader.get<int>();
+    state.direction = reader.get<decltype(state.direction)>();
+    state.state = reader.get<decltype(state.state)>();
+    state.currentFrame = reader.get<int>();
+    state.frameTimer = reader.get<float>();
+    state.attackCooldown = reader.get<float>();
+    state.isAttacking = reader.get<bool>();
+    state.isDead = reader.get<bool>();
+}
+
+inline void snapshotApply(Samurai& samurai, const SamuraiSnapshot& state) {
+    samurai.setRect(state.rect);
+    samurai.setVelocity(state.velocity);
+    samurai.setHealth(state.health);
+    samurai.setDirection(state.direction);
+    samurai.setAnimation(state.animation);
+    samurai.setFrame(state.frame);
+    samurai.setFrameTimer(state.frameTimer);
+    samurai.setJumping(state.jumping);
+    samurai.setAttackCooldown(state.attackCooldown);
+    samurai.setDashCooldown(state.dashCooldown);
+}
+
+inline void snapshotApply(Demon& demon, const DemonSnapshot& state) {
+    demon.rect = state.rect;
+    demon.velocity = state.velocity;
+    demon.health = state.health;
+    demon.direction = state.direction;
+    demon.state = state.state;
+    demon.currentFrame = state.currentFrame;
+    demon.frameTimer = state.frameTimer;
+    demon.attackCooldown = state.attackCooldown;
+    demon.isAttacking = state.isAttacking;
+    demon.isDead = state.isDead;
+}
+
+#endif // CHARACTER_SNAPSHOT_H
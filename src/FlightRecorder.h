@@ -0,0 +1,143 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include "raylib.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+// Hitch flight recorder. Keeps the last few seconds of frames, with how long each phase of the frame took and what the
+// game was doing, in a ring buffer. When a frame takes longer than the threshold, the recorder waits a little so the
+// frames after the hitch are captured too, then writes the whole window to hitch-<date>-<time>-f<frame>.csv.
+//
+// Phases are timed back to back: each flightEndPhase() call charges the time since the previous one to the given
+// phase, so the phases of a frame add up to the whole frame.
+
+const int FLIGHT_CAPACITY = 300;        // Frames kept, five seconds at 60 fps
+const int FLIGHT_FRAMES_AFTER = 30;     // Frames recorded after a hitch before the window is written
+
+enum FlightPhase {
+    PHASE_UPDATE,       // Input, movement, collisions and the camera
+    PHASE_DRAW_WORLD,   // Map, characters and particles, along with the demon's AI
+    PHASE_DRAW_HUD,     // Dialogue, controls, menus and the transition fade
+    PHASE_TRANSITION,   // Switching maps at the peak of a transition
+    PHASE_PRESENT,      // EndDrawing(): flushing the batch, swapping buffers and waiting for the frame cap
+    PHASE_COUNT
+};
+
+inline const char* FLIGHT_PHASE_NAMES[PHASE_COUNT] = { "update", "world", "hud", "transition", "present" };
+
+struct FlightFrame {
+    long frame;
+    double time;                    // Seconds since the window opened
+    float frameMs;
+    float phaseMs[PHASE_COUNT];
+    char map[32];
+    float samuraiX, samuraiY;
+    int entities;                   // Characters alive
+    int particles;
+    bool transitioning;
+    float transitionAlpha;
+    bool hitch;
+};
+
+struct FlightRecorder {
+    bool enabled = true;
+    float thresholdMs = 50.0f;
+    FlightFrame frames[FLIGHT_CAPACITY];
+    long frameCount = 0;            // Frames recorded in total, the latest is frames[(frameCount - 1) % capacity]
+    FlightFrame current = {};
+    double frameStart = 0.0;
+    double phaseStart = 0.0;
+    long hitchFrame = -1;           // Frame that triggered the pending dump, or -1 if none is pending
+    int framesUntilDump = 0;
+};
+
+inline FlightRecorder flightRecorder;
+
+// Call at the top of the game loop
+inline void flightBeginFrame() {
+    FlightRecorder& recorder = flightRecorder;
+    memset(&recorder.current, 0, sizeof(FlightFrame));
+    recorder.frameStart = GetTime();
+    recorder.phaseStart = recorder.frameStart;
+}
+
+// Charge the time since the previous phase ended, or since the frame began, to the given phase
+inline void flightEndPhase(FlightPhase phase) {
+    FlightRecorder& recorder = flightRecorder;
+    double now = GetTime();
+    recorder.current.phaseMs[phase] += (float)((now - recorder.phaseStart) * 1000.0);
+    recorder.phaseStart = now;
+}
+
+inline void flightDump() {
+    FlightRecorder& recorder = flightRecorder;
+    char timestamp[32];
+    time_t now = time(NULL);
+    strftime(timestamp, sizeof(timestamp), "%Y%m%d-%H%M%S", localtime(&now));
+    char fileName[96];
+    snprintf(fileName, sizeof(fileName), "hitch-%s-f%ld.csv", timestamp, recorder.hitchFrame);
+
+    FILE* file = fopen(fileName, "w");
+    if (!file) {
+        printf("Failed to write hitch report: %s\n", fileName);
+        return;
+    }
+
+    fprintf(file, "frame,time_s,frame_ms");
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        fprintf(file, ",%s_ms", FLIGHT_PHASE_NAMES[phase]);
+    }
+    fprintf(file, ",map,samurai_x,samurai_y,entities,particles,transitioning,transition_alpha,hitch\n");
+
+    long count = (recorder.frameCount < FLIGHT_CAPACITY) ? recorder.frameCount : FLIGHT_CAPACITY;
+    for (long i = recorder.frameCount - count; i < recorder.frameCount; i++) {
+        const FlightFrame& frame = recorder.frames[i % FLIGHT_CAPACITY];
+        fprintf(file, "%ld,%.4f,%.3f", frame.frame, frame.time, frame.frameMs);
+        for (int phase = 0; phase < PHASE_COUNT; phase++) {
+            fprintf(file, ",%.3f", frame.phaseMs[phase]);
+        }
+        fprintf(file, ",%s,%.1f,%.1f,%d,%d,%d,%.2f,%d\n", frame.map, frame.samuraiX, frame.samuraiY, frame.entities,
+                frame.particles, frame.transitioning ? 1 : 0, frame.transitionAlpha, frame.hitch ? 1 : 0);
+    }
+    fclose(file);
+    printf("Frame %ld took longer than %.0f ms, wrote %s\n", recorder.hitchFrame, recorder.thresholdMs, fileName);
+}
+
+// Call once the frame is over, after EndDrawing(), with what the game was doing during it
+inline void flightEndFrame(const char* mapName, Vector2 samuraiPosition, int entities, int particles,
+                           bool transitioning, float transitionAlpha) {
+    FlightRecorder& recorder = flightRecorder;
+    if (!recorder.enabled) {
+        return;
+    }
+
+    FlightFrame& frame = recorder.current;
+    frame.frame = recorder.frameCount;
+    frame.time = recorder.frameStart;
+    frame.frameMs = (float)((GetTime() - recorder.frameStart) * 1000.0);
+    strncpy(frame.map, mapName ? mapName : "", sizeof(frame.map) - 1);
+    frame.samuraiX = samuraiPosition.x;
+    frame.samuraiY = samuraiPosition.y;
+    frame.entities = entities;
+    frame.particles = particles;
+    frame.transitioning = transitioning;
+    frame.transitionAlpha = transitionAlpha;
+    frame.hitch = frame.frameMs > recorder.thresholdMs;
+
+    recorder.frames[recorder.frameCount % FLIGHT_CAPACITY] = frame;
+    recorder.frameCount++;
+
+    // Hitches while a dump is pending land in the same window, so they don't start another one
+    if (frame.hitch && recorder.hitchFrame < 0) {
+        recorder.hitchFrame = frame.frame;
+        recorder.framesUntilDump = FLIGHT_FRAMES_AFTER;
+    }
+    if (recorder.hitchFrame >= 0 && recorder.framesUntilDump-- <= 0) {
+        flightDump();
+        recorder.hitchFrame = -1;
+    }
+}
+
+#endif // FLIGHT_RECORDER_H
@@ -0,0 +1,146 @@
+#ifndef HUD_LAYER_H
+#define HUD_LAYER_H
+
+#include "raylib.h"
+#include "rlgl.h"
+#include "MemoryStats.h"
+#include <cstdint>
+#include <cstdio>
+
+// Retained HUD. Text and panels that rarely change (the control list, the dialogue box, the pause and end screens)
+// are drawn once into a RenderTexture2D per widget, and every frame after that the widget costs a single textured
+// quad instead of its DrawText and MeasureText calls. A widget is drawn again only when its key changes: the caller
+// builds the key from whatever the widget shows, e.g. the dialogue's text or whether the mouse is over a button.
+//
+// The game keeps its draw calls in screen coordinates: between hudBeginWidget() and hudEndWidget() everything is
+// shifted by the widget's position, so drawing lands in the widget's texture at the same place it would appear on
+// screen. Inside the texture, color is blended as usual but alpha accumulates properly, which leaves premultiplied
+// color that is drawn to the screen with premultiplied blending. Semi-transparent panels then look exactly as they
+// did when drawn straight to the screen.
+//
+// Input isn't part of the layer. Buttons are still hit-tested by the game every frame, it only puts the hover state
+// in the key.
+
+enum HudWidgetId {
+    HUD_CONTROLS,
+    HUD_DIALOGUE,
+    HUD_PAUSE,
+    HUD_COMPLETE,
+    HUD_GAME_OVER,
+    HUD_WIDGET_COUNT
+};
+
+struct HudWidget {
+    RenderTexture2D target = { 0 };
+    Rectangle bounds = { 0 };    // Where the widget is on screen
+    uint64_t key = 0;            // What it showed when it was last drawn
+    bool drawn = false;
+};
+
+struct HudLayer {
+    HudWidget widgets[HUD_WIDGET_COUNT];
+    int redraws = 0;             // Widgets drawn into their texture since the game started
+};
+
+inline HudLayer hudLayer;
+
+// FNV-1a, to turn a widget's text into a key. Chain calls through seed to combine several values.
+inline uint64_t hudHash(const char* text, uint64_t seed = 14695981039346656037ull) {
+    uint64_t hash = seed;
+    for (const char* c = text; *c; c++) {
+        hash = (hash ^ (unsigned char)*c) * 1099511628211ull;
+    }
+    return hash;
+}
+
+inline uint64_t hudHash(uint64_t value, uint64_t seed = 14695981039346656037ull) {
+    uint64_t hash = seed;
+    for (int i = 0; i < 8; i++) {
+        hash = (hash ^ ((value >> (i * 8)) & 0xFF)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+inline void hudTrackTarget(const RenderTexture2D& target, int direction) {
+    // The color texture plus the depth renderbuffer, as for the low-res target
+    memTrackTexture(MEM_VRAM_RENDER_TARGETS, target.texture, direction);
+    memTrackBytes(MEM_VRAM_RENDER_TARGETS, direction * (long long)target.texture.width * target.texture.height * 4);
+}
+
+// Returns false when the widget already shows this key at these bounds, so there's nothing to draw. Otherwise starts
+// drawing into the widget's texture and returns true, and the caller draws the widget then calls hudEndWidget().
+inline bool hudBeginWidget(HudWidgetId id, Rectangle bounds, uint64_t key) {
+    HudWidget& widget = hudLayer.widgets[id];
+    bool moved = bounds.x != widget.bounds.x || bounds.y != widget.bounds.y;
+    bool resized = bounds.width != widget.bounds.width || bounds.height != widget.bounds.height;
+    if (widget.drawn && key == widget.key && !moved && !resized) {
+        return false;
+    }
+
+    if (widget.target.id == 0 || resized) {
+        if (widget.target.id != 0) {
+            hudTrackTarget(widget.target, -1);
+            UnloadRenderTexture(widget.target);
+        }
+        widget.target = LoadRenderTexture((int)bounds.width, (int)bounds.height);
+        if (widget.target.id == 0) {
+            printf("Failed to create a HUD render target\n");
+            widget.drawn = false;
+            return false;
+        }
+        SetTextureFilter(widget.target.texture, TEXTURE_FILTER_POINT);
+        hudTrackTarget(widget.target, 1);
+    }
+    widget.bounds = bounds;
+    widget.key = key;
+    widget.drawn = true;
+    hudLayer.redraws++;
+
+    BeginTextureMode(widget.target);
+    ClearBackground(BLANK);
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD,
+                              RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    rlPushMatrix();
+    rlTranslatef(-bounds.x, -bounds.y, 0.0f);
+    return true;
+}
+
+inline void hudEndWidget() {
+    rlPopMatrix();
+    EndBlendMode();
+    EndTextureMode();
+}
+
+// Draw the widget's cached texture to the screen. Render textures are stored upside down, hence the negative height.
+inline void hudDrawWidget(HudWidgetId id) {
+    const HudWidget& widget = hudLayer.widgets[id];
+    if (!widget.drawn) {
+        return;
+    }
+    Rectangle source = { 0.0f, 0.0f, (float)widget.target.texture.width, -(float)widget.target.texture.height };
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTextureRec(widget.target.texture, source, Vector2{ widget.bounds.x, widget.bounds.y }, WHITE);
+    EndBlendMode();
+}
+
+inline void hudShutdown() {
+    for (HudWidget& widget : hudLayer.widgets) {
+        if (widget.target.id != 0) {
+            hudTrackTarget(widget.target, -1);
+            UnloadRenderTexture(widget.target);
+            widget = HudWidget{};
+        }
+    }
+}
+
+// One line for the debug overlay
+inline void hudDescribe(char* buffer, int bufferSize) {
+    int cached = 0;
+    for (const HudWidget& widget : hudLayer.widgets) {
+        cached += widget.drawn ? 1 : 0;
+    }
+    snprintf(buffer, bufferSize, "HUD: %d widgets cached, %d redraws", cached, hudLayer.redraws);
+}
+
+#endif // HUD_LAYER_H
@@ -0,0 +1,132 @@
+#ifndef IDLE_MODE_H
+#define IDLE_MODE_H
+
+#include "raylib.h"
+#include "rlgl.h"
+#include "InputRecorder.h"
+#include "MemoryStats.h"
+#include <cstdio>
+
+// Low-power mode for the start screen and the pause screen, where nothing moves unless the player does something.
+//   - Paused, the world is drawn once and kept as a screenshot, so each frame after that is one quad under the pause
+//     screen instead of the background, the map, the characters and the HUD.
+//   - The frame rate drops to IDLE_FPS shortly after the last input, and comes back as soon as there's more.
+//   - With no music playing, the game sleeps until the OS delivers an input event instead of polling. Music has to
+//     be fed from the game loop, so while it plays the game keeps running at IDLE_FPS. Music streams are created
+//     with buffers long enough for that (IDLE_MUSIC_BUFFER_FRAMES).
+//
+// Waiting isn't game time. The tick after an idle frame has its frame time limited to a normal frame's, so unpausing
+// doesn't throw the characters forward by however long the game sat on the pause screen.
+//
+// Replays and benchmarks never wait or lower the frame rate. They still show the paused world from the screenshot,
+// so they take the same path through the game as live play.
+
+const int IDLE_FPS = 15;                       // Frame rate once idle, enough to keep the music buffers full
+const int IDLE_MUSIC_BUFFER_FRAMES = 4096;     // Frames per music sub-buffer, about 90 ms at 44.1 kHz
+const float IDLE_DELAY = 0.5f;                 // Seconds without input before the frame rate drops
+
+struct IdleMode {
+    bool allowed = false;        // Whether the frame rate may drop, off for replays and benchmarks
+    int activeFps = 60;          // Frame rate outside idle
+    bool lowered = false;        // Running at IDLE_FPS
+    bool waiting = false;        // Sleeping until input events arrive
+    bool idled = false;          // Whether the last frame was idle
+    float quietTime = 0.0f;      // Seconds since the last input
+    Vector2 lastMouse = { 0.0f, 0.0f };
+    Texture2D snapshot = { 0 };  // The paused world
+};
+
+inline IdleMode idleMode;
+
+// Call once the frame rate is set, after InitWindow()
+inline void idleInit(int activeFps, bool allowed) {
+    idleMode.activeFps = activeFps;
+    idleMode.allowed = allowed;
+}
+
+// Keep the screen as it is now as the paused world. Call while drawing, before the pause screen is drawn over it.
+inline void idleCaptureWorld() {
+    if (idleMode.snapshot.id != 0) {
+        memTrackTexture(MEM_VRAM_TEXTURES, idleMode.snapshot, -1);
+        UnloadTexture(idleMode.snapshot);
+    }
+    rlDrawRenderBatchActive();   // Flush what's been drawn so far so the read sees it
+    Image screen = LoadImageFromScreen();
+    idleMode.snapshot = LoadTextureFromImage(screen);
+    UnloadImage(screen);
+    if (idleMode.snapshot.id != 0) {
+        memTrackTexture(MEM_VRAM_TEXTURES, idleMode.snapshot);
+    }
+}
+
+// Draw the paused world, or nothing when there's no snapshot (rendering is off)
+inline void idleDrawWorld() {
+    const Texture2D& snapshot = idleMode.snapshot;
+    if (snapshot.id == 0) {
+        return;
+    }
+    DrawTexturePro(snapshot, Rectangle{ 0.0f, 0.0f, (float)snapshot.width, (float)snapshot.height },
+                   Rectangle{ 0.0f, 0.0f, (float)GetScreenWidth(), (float)GetScreenHeight() }, Vector2{ 0.0f, 0.0f },
+                   0.0f, WHITE);
+}
+
+inline void idleReleaseWorld() {
+    if (idleMode.snapshot.id != 0) {
+        memTrackTexture(MEM_VRAM_TEXTURES, idleMode.snapshot, -1);
+        UnloadTexture(idleMode.snapshot);
+        idleMode.snapshot = Texture2D{ 0 };
+    }
+}
+
+inline bool idleInputActive() {
+    const InputState& input = inputState;
+    if (input.mouseButtons != 0 || input.mousePosition.x != idleMode.lastMouse.x ||
+        input.mousePosition.y != idleMode.lastMouse.y) {
+        return true;
+    }
+    for (int key = 0; key < INPUT_MAX_KEYS; key++) {
+        if (input.keysDown[key]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Call every frame just before EndDrawing(), with whether the game is on an idle screen and whether music is
+// streaming. Switches the frame rate and event waiting, which take effect from EndDrawing() on.
+inline void idleEndFrame(bool idle, bool musicPlaying) {
+    IdleMode& mode = idleMode;
+    mode.quietTime = idleInputActive() ? 0.0f : mode.quietTime + inputGetFrameTime();
+    mode.lastMouse = inputState.mousePosition;
+    if (!idle) {
+        idleReleaseWorld();
+    }
+
+    bool lower = mode.allowed && idle && mode.quietTime >= IDLE_DELAY;
+    bool wait = lower && !musicPlaying;
+    if (lower != mode.lowered) {
+        SetTargetFPS(lower ? IDLE_FPS : mode.activeFps);
+        mode.lowered = lower;
+    }
+    if (wait != mode.waiting) {
+        if (wait) {
+            EnableEventWaiting();
+        } else {
+            DisableEventWaiting();
+        }
+        mode.waiting = wait;
+    }
+
+    // The next tick's frame time includes this frame's wait
+    if (lower) {
+        inputCapNextFrameTime(1.0f / mode.activeFps);
+    }
+    mode.idled = lower;
+}
+
+// Whether the last frame ran slow on purpose, so its frame time says nothing about performance
+inline bool idleLastFrameIdled() {
+    return idleMode.idled;
+}
+
+#endif // IDLE_MODE_H
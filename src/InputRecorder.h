@@ -0,0 +1,222 @@
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include "raylib.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// Input layer that every keyboard, mouse and frame time read in the game goes through. Each tick it either samples
+// raylib (live and recording) or reads the next tick from a replay file, so the game sees exactly the same input
+// when a recorded session is played back.
+//
+// Replay file layout, little-endian:
+//   header: "FCIR", uint32 version, uint32 RNG seed
+//   tick:   float frame time, int16 mouse X, int16 mouse Y, uint8 mouse buttons down,
+//           uint16 number of keys that changed state, then that many uint16 key codes
+// Only keys that were pressed or released since the previous tick are stored, so idle ticks cost 11 bytes.
+
+const int INPUT_MAX_KEYS = 512;          // Matches raylib's MAX_KEYBOARD_KEYS
+const int INPUT_MAX_MOUSE_BUTTONS = 7;   // MOUSE_BUTTON_LEFT through MOUSE_BUTTON_BACK
+const uint32_t INPUT_FILE_VERSION = 1;
+
+enum InputMode { INPUT_LIVE, INPUT_RECORD, INPUT_REPLAY };
+
+struct InputState {
+    InputMode mode = INPUT_LIVE;
+    FILE* file = nullptr;
+    unsigned int seed = 0;
+    long ticks = 0;
+    double inputTime = 0.0;   // Sum of every tick's frame time, i.e. how long the session took when it was played
+
+    // Current and previous tick. Pressed/released are derived from the difference between the two.
+    uint8_t keysDown[INPUT_MAX_KEYS] = { 0 };
+    uint8_t previousKeysDown[INPUT_MAX_KEYS] = { 0 };
+    uint8_t mouseButtons = 0;
+    uint8_t previousMouseButtons = 0;
+    Vector2 mousePosition = { 0.0f, 0.0f };
+    float frameTime = 0.0f;
+    float frameTimeCap = 0.0f;   // Limit on the next live tick's frame time, 0 for none
+};
+
+inline InputState inputState;
+
+// Record input to the given file. The seed is applied to raylib's RNG and stored so the replay can restore it.
+inline bool inputStartRecording(const char* fileName, unsigned int seed) {
+    FILE* file = fopen(fileName, "wb");
+    if (!file) {
+        printf("Failed to open input recording: %s\n", fileName);
+        return false;
+    }
+
+    fwrite("FCIR", 1, 4, file);
+    fwrite(&INPUT_FILE_VERSION, sizeof(uint32_t), 1, file);
+    uint32_t storedSeed = seed;
+    fwrite(&storedSeed, sizeof(uint32_t), 1, file);
+
+    SetRandomSeed(seed);
+    inputState.mode = INPUT_RECORD;
+    inputState.file = file;
+    inputState.seed = seed;
+    printf("Recording input to %s (seed %u)\n", fileName, seed);
+    return true;
+}
+
+// Play back a file written by inputStartRecording(). Restores the RNG seed the session was recorded with.
+inline bool inputStartReplay(const char* fileName) {
+    FILE* file = fopen(fileName, "rb");
+    if (!file) {
+        printf("Failed to open input replay: %s\n", fileName);
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0, seed = 0;
+    if (fread(magic, 1, 4, file) != 4 || memcmp(magic, "FCIR", 4) != 0 ||
+        fread(&version, sizeof(uint32_t), 1, file) != 1 || version != INPUT_FILE_VERSION ||
+        fread(&seed, sizeof(uint32_t), 1, file) != 1) {
+        printf("Not a valid input replay: %s\n", fileName);
+        fclose(file);
+        return false;
+    }
+
+    SetRandomSeed(seed);
+    inputState.mode = INPUT_REPLAY;
+    inputState.file = file;
+    inputState.seed = seed;
+    printf("Replaying input from %s (seed %u)\n", fileName, seed);
+    return true;
+}
+
+inline void inputWriteTick() {
+    FILE* file = inputState.file;
+    int16_t mouseX = (int16_t)inputState.mousePosition.x;
+    int16_t mouseY = (int16_t)inputState.mousePosition.y;
+    uint16_t changed[INPUT_MAX_KEYS];
+    uint16_t changedCount = 0;
+    for (int key = 0; key < INPUT_MAX_KEYS; key++) {
+        if (inputState.keysDown[key] != inputState.previousKeysDown[key]) {
+            changed[changedCount++] = (uint16_t)key;
+        }
+    }
+
+    fwrite(&inputState.frameTime, sizeof(float), 1, file);
+    fwrite(&mouseX, sizeof(int16_t), 1, file);
+    fwrite(&mouseY, sizeof(int16_t), 1, file);
+    fwrite(&inputState.mouseButtons, sizeof(uint8_t), 1, file);
+    fwrite(&changedCount, sizeof(uint16_t), 1, file);
+    fwrite(changed, sizeof(uint16_t), changedCount, file);
+}
+
+inline bool inputReadTick() {
+    FILE* file = inputState.file;
+    int16_t mouseX, mouseY;
+    uint16_t changedCount;
+    if (fread(&inputState.frameTime, sizeof(float), 1, file) != 1 ||
+        fread(&mouseX, sizeof(int16_t), 1, file) != 1 ||
+        fread(&mouseY, sizeof(int16_t), 1, file) != 1 ||
+        fread(&inputState.mouseButtons, sizeof(uint8_t), 1, file) != 1 ||
+        fread(&changedCount, sizeof(uint16_t), 1, file) != 1) {
+        return false;
+    }
+
+    inputState.mousePosition = { (float)mouseX, (float)mouseY };
+    for (uint16_t i = 0; i < changedCount; i++) {
+        uint16_t key;
+        if (fread(&key, sizeof(uint16_t), 1, file) != 1 || key >= INPUT_MAX_KEYS) {
+            return false;
+        }
+        inputState.keysDown[key] = !inputState.keysDown[key];
+    }
+    return true;
+}
+
+// Advance to the next tick. Call once at the top of the game loop, before anything reads input.
+// Returns false when a replay has run out of ticks.
+inline bool inputBeginTick() {
+    memcpy(inputState.previousKeysDown, inputState.keysDown, sizeof(inputState.keysDown));
+    inputState.previousMouseButtons = inputState.mouseButtons;
+
+    if (inputState.mode == INPUT_REPLAY) {
+        if (!inputReadTick()) {
+            return false;
+        }
+    } else {
+        for (int key = 0; key < INPUT_MAX_KEYS; key++) {
+            inputState.keysDown[key] = IsKeyDown(key) ? 1 : 0;
+        }
+        inputState.mouseButtons = 0;
+        for (int button = 0; button < INPUT_MAX_MOUSE_BUTTONS; button++) {
+            if (IsMouseButtonDown(button)) inputState.mouseButtons |= (uint8_t)(1 << button);
+        }
+        inputState.mousePosition = GetMousePosition();
+        inputState.frameTime = GetFrameTime();
+        if (inputState.frameTimeCap > 0.0f && inputState.frameTime > inputState.frameTimeCap) {
+            inputState.frameTime = inputState.frameTimeCap;
+        }
+        inputState.frameTimeCap = 0.0f;
+
+        if (inputState.mode == INPUT_RECORD) {
+            inputWriteTick();
+        }
+    }
+
+    inputState.ticks++;
+    inputState.inputTime += inputState.frameTime;
+    return true;
+}
+
+// Close the recording or replay file. Safe to call more than once.
+inline void inputShutdown() {
+    if (inputState.file) {
+        fclose(inputState.file);
+        inputState.file = nullptr;
+    }
+    inputState.mode = INPUT_LIVE;
+}
+
+// Limit the next tick's frame time, for a frame that spent time waiting rather than playing. Recordings store the
+// limited time, so replays see the same.
+inline void inputCapNextFrameTime(float seconds) {
+    inputState.frameTimeCap = seconds;
+}
+
+inline bool inputIsReplaying() { return inputState.mode == INPUT_REPLAY; }
+
+inline bool inputIsKeyDown(int key) {
+    return key >= 0 && key < INPUT_MAX_KEYS && inputState.keysDown[key];
+}
+
+inline bool inputIsKeyUp(int key) { return !inputIsKeyDown(key); }
+
+inline bool inputIsKeyPressed(int key) {
+    return inputIsKeyDown(key) && !inputState.previousKeysDown[key];
+}
+
+inline bool inputIsKeyReleased(int key) {
+    return key >= 0 && key < INPUT_MAX_KEYS && !inputState.keysDown[key] && inputState.previousKeysDown[key];
+}
+
+inline bool inputIsMouseButtonDown(int button) {
+    return button >= 0 && button < INPUT_MAX_MOUSE_BUTTONS && (inputState.mouseButtons & (1 << button));
+}
+
+inline bool inputIsMouseButtonUp(int button) { return !inputIsMouseButtonDown(button); }
+
+inline bool inputIsMouseButtonPressed(int button) {
+    return inputIsMouseButtonDown(button) && !(inputState.previousMouseButtons & (1 << button));
+}
+
+inline bool inputIsMouseButtonReleased(int button) {
+    return button >= 0 && button < INPUT_MAX_MOUSE_BUTTONS && !(inputState.mouseButtons & (1 << button)) &&
+           (inputState.previousMouseButtons & (1 << button));
+}
+
+inline Vector2 inputGetMousePosition() { return inputState.mousePosition; }
+inline int inputGetMouseX() { return (int)inputState.mousePosition.x; }
+inline int inputGetMouseY() { return (int)inputState.mousePosition.y; }
+
+// Frame time is part of the recording so time-based movement replays identically at any speed
+inline float inputGetFrameTime() { return inputState.frameTime; }
+
+#endif // INPUT_RECORDER_H
@@ -0,0 +1,310 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool for the per-tick work that doesn't touch raylib: particle integration, the navigation
+// search and the like. Anything that draws, plays sound or reads input stays on the main thread.
+//
+// Each thread, the main one included, has its own queue. A thread takes new work from the back of its own queue and,
+// when that's empty, steals from the front of another's, so the jobs a thread spawns stay on it while idle threads
+// pick up the oldest, usually biggest, pieces elsewhere. A thread waiting for jobs to finish runs queued jobs in the
+// meantime instead of blocking, which is what lets jobs wait for jobs they spawned.
+//
+// Three ways in:
+//   - jobsRun() queues one function and counts it against a JobCounter, jobsWait() returns once the counter is 0.
+//   - jobsParallelFor() splits a range into chunks and returns when every chunk is done.
+//   - A JobGraph is a set of functions with dependencies between them. jobsRunGraph() starts each as soon as the
+//     ones it depends on are done and returns when all are.
+// Every way in returns only once its work is finished, so the tick has a fixed join point and jobs that write
+// disjoint data give the same result however they were scheduled. Input replays stay in sync.
+//
+// With no workers (one core, or --jobs 0) everything runs on the main thread in submission order.
+
+struct JobCounter {
+    std::atomic<int> remaining{ 0 };
+};
+
+struct Job {
+    void (*function)(void* data, int begin, int end);
+    void* data;
+    int begin, end;
+    JobCounter* counter;
+};
+
+struct JobQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+};
+
+struct JobThreadStats {
+    std::atomic<long long> busyNs{ 0 };      // Time spent running jobs
+    std::atomic<long> jobs{ 0 };
+    std::atomic<long> steals{ 0 };
+    long long sampledBusyNs = 0;             // busyNs when utilization was last computed
+    float utilization = 0.0f;                // Share of the last sample period spent running jobs
+};
+
+struct JobSystem {
+    int threadCount = 1;                     // Queues, the main thread's first
+    std::unique_ptr<JobQueue[]> queues;
+    std::unique_ptr<JobThreadStats[]> stats;
+    std::vector<std::thread> workers;
+    std::atomic<int> queued{ 0 };            // Jobs in all the queues
+    std::atomic<bool> stopping{ false };
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::chrono::steady_clock::time_point sampleTime;
+};
+
+inline JobSystem jobSystem;
+inline thread_local int jobThreadIndex = 0;   // 0 on the main thread
+inline thread_local int jobDepth = 0;         // Jobs running on this thread, more than one while a job waits
+
+inline long long jobsNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline bool jobsTake(int thread, Job& job) {
+    JobSystem& system = jobSystem;
+    {
+        JobQueue& own = system.queues[thread];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            system.queued--;
+            return true;
+        }
+    }
+    for (int n = 1; n < system.threadCount; n++) {
+        JobQueue& victim = system.queues[(thread + n) % system.threadCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            system.queued--;
+            system.stats[thread].steals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void jobsExecute(int thread, const Job& job) {
+    long long start = jobsNowNs();
+    jobDepth++;
+    job.function(job.data, job.begin, job.end);
+    jobDepth--;
+    JobThreadStats& stats = jobSystem.stats[thread];
+    if (jobDepth == 0) {
+        stats.busyNs += jobsNowNs() - start;   // Jobs run while waiting are already inside this one's time
+    }
+    stats.jobs++;
+    job.counter->remaining--;
+}
+
+inline void jobsWorkerLoop(int thread) {
+    JobSystem& system = jobSystem;
+    jobThreadIndex = thread;
+    Job job;
+    while (!system.stopping) {
+        if (jobsTake(thread, job)) {
+            jobsExecute(thread, job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(system.sleepMutex);
+        system.wake.wait(lock, [&] { return system.queued > 0 || system.stopping; });
+    }
+}
+
+// Start the workers. Pass -1 for one per core besides the main thread's.
+inline void jobsInit(int workerCount) {
+    JobSystem& system = jobSystem;
+    if (workerCount < 0) {
+        workerCount = std::max((int)std::thread::hardware_concurrency() - 1, 0);
+    }
+    system.threadCount = workerCount + 1;
+    system.queues.reset(new JobQueue[system.threadCount]);
+    system.stats.reset(new JobThreadStats[system.threadCount]);
+    system.sampleTime = std::chrono::steady_clock::now();
+    for (int thread = 1; thread < system.threadCount; thread++) {
+        system.workers.emplace_back(jobsWorkerLoop, thread);
+    }
+    printf("Job system: %d worker threads\n", workerCount);
+}
+
+// Stop and join the workers. Call before the program exits.
+inline void jobsShutdown() {
+    JobSystem& system = jobSystem;
+    {
+        std::lock_guard<std::mutex> lock(system.sleepMutex);
+        system.stopping = true;
+    }
+    system.wake.notify_all();
+    for (std::thread& worker : system.workers) {
+        worker.join();
+    }
+    system.workers.clear();
+}
+
+inline void jobsPush(void (*function)(void*, int, int), void* data, int begin, int end, JobCounter& counter) {
+    JobSystem& system = jobSystem;
+    counter.remaining++;
+    if (!system.queues) {
+        // Not started, run it here
+        function(data, begin, end);
+        counter.remaining--;
+        return;
+    }
+    {
+        JobQueue& queue = system.queues[jobThreadIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(Job{ function, data, begin, end, &counter });
+        system.queued++;
+    }
+    if (system.threadCount > 1) {
+        std::lock_guard<std::mutex> lock(system.sleepMutex);
+        system.wake.notify_one();
+    }
+}
+
+// Run queued jobs until the counter's jobs are all done
+inline void jobsWait(JobCounter& counter) {
+    JobSystem& system = jobSystem;
+    Job job;
+    while (counter.remaining > 0) {
+        if (system.queues && jobsTake(jobThreadIndex, job)) {
+            jobsExecute(jobThreadIndex, job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// Queue a function. It must stay alive until jobsWait() on the counter returns.
+template <typename Function>
+inline void jobsRun(Function& function, JobCounter& counter) {
+    jobsPush([](void* data, int, int) { (*static_cast<Function*>(data))(); }, &function, 0, 0, counter);
+}
+
+// Call function(begin, end) over [0, count) in chunks of at least grain items, spread over every thread
+template <typename Function>
+inline void jobsParallelFor(int count, int grain, Function&& function) {
+    if (count <= 0) {
+        return;
+    }
+    int chunks = std::min((count + grain - 1) / std::max(grain, 1), jobSystem.threadCount * 4);
+    chunks = std::max(chunks, 1);
+    int chunkSize = (count + chunks - 1) / chunks;
+    using FunctionType = typename std::remove_reference<Function>::type;
+    JobCounter counter;
+    for (int begin = 0; begin < count; begin += chunkSize) {
+        jobsPush([](void* data, int first, int last) { (*static_cast<FunctionType*>(data))(first, last); },
+                 &function, begin, std::min(begin + chunkSize, count), counter);
+    }
+    jobsWait(counter);
+}
+
+// Jobs with dependencies. Build it with jobsGraphAdd() and jobsGraphDepend(), then run it with jobsRunGraph().
+// A graph can be cleared and rebuilt every tick, its storage is reused.
+struct JobGraph {
+    struct Node {
+        std::function<void()> work;
+        std::vector<int> successors;
+        int dependencies = 0;
+    };
+    std::vector<Node> nodes;
+    int nodeCount = 0;
+    std::unique_ptr<std::atomic<int>[]> pending;
+    int pendingCapacity = 0;
+    JobCounter counter;
+};
+
+inline void jobsGraphClear(JobGraph& graph) {
+    for (int i = 0; i < graph.nodeCount; i++) {
+        graph.nodes[i].work = nullptr;
+        graph.nodes[i].successors.clear();
+        graph.nodes[i].dependencies = 0;
+    }
+    graph.nodeCount = 0;
+}
+
+inline int jobsGraphAdd(JobGraph& graph, std::function<void()> work) {
+    if (graph.nodeCount == (int)graph.nodes.size()) {
+        graph.nodes.emplace_back();
+    }
+    graph.nodes[graph.nodeCount].work = std::move(work);
+    return graph.nodeCount++;
+}
+
+// Make node wait for dependency to finish
+inline void jobsGraphDepend(JobGraph& graph, int node, int dependency) {
+    graph.nodes[dependency].successors.push_back(node);
+    graph.nodes[node].dependencies++;
+}
+
+inline void jobsGraphRunNode(void* data, int node, int) {
+    JobGraph& graph = *static_cast<JobGraph*>(data);
+    graph.nodes[node].work();
+    for (int successor : graph.nodes[node].successors) {
+        if (--graph.pending[successor] == 0) {
+            jobsPush(jobsGraphRunNode, &graph, successor, 0, graph.counter);
+        }
+    }
+}
+
+inline void jobsRunGraph(JobGraph& graph) {
+    if (graph.pendingCapacity < graph.nodeCount) {
+        graph.pending.reset(new std::atomic<int>[graph.nodeCount]);
+        graph.pendingCapacity = graph.nodeCount;
+    }
+    for (int i = 0; i < graph.nodeCount; i++) {
+        graph.pending[i] = graph.nodes[i].dependencies;
+    }
+    for (int i = 0; i < graph.nodeCount; i++) {
+        if (graph.nodes[i].dependencies == 0) {
+            jobsPush(jobsGraphRunNode, &graph, i, 0, graph.counter);
+        }
+    }
+    jobsWait(graph.counter);
+}
+
+// One line for the debug overlay: how busy each thread was over the last second or so, the main thread first
+inline void jobsDescribe(char* buffer, int bufferSize) {
+    JobSystem& system = jobSystem;
+    auto now = std::chrono::steady_clock::now();
+    double elapsedNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(now - system.sampleTime).count();
+    if (system.stats && elapsedNs >= 1e9) {
+        for (int thread = 0; thread < system.threadCount; thread++) {
+            JobThreadStats& stats = system.stats[thread];
+            long long busy = stats.busyNs;
+            stats.utilization = (float)((busy - stats.sampledBusyNs) / elapsedNs);
+            stats.sampledBusyNs = busy;
+        }
+        system.sampleTime = now;
+    }
+
+    int length = snprintf(buffer, bufferSize, "Jobs: %d threads, busy", system.threadCount);
+    long steals = 0;
+    for (int thread = 0; thread < system.threadCount && system.stats && length < bufferSize; thread++) {
+        length += snprintf(buffer + length, bufferSize - length, " %.0f%%", system.stats[thread].utilization * 100.0f);
+        steals += system.stats[thread].steals;
+    }
+    if (length < bufferSize) {
+        snprintf(buffer + length, bufferSize - length, ", %ld steals", steals);
+    }
+}
+
+#endif // JOB_SYSTEM_H
@@ -0,0 +1,110 @@
+#ifndef LOW_RES_RENDERER_H
+#define LOW_RES_RENDERER_H
+
+#include "raylib.h"
+#include <cstdio>
+
+// Optional low-resolution target for the world. The map, background and characters are drawn into a RenderTexture2D
+// smaller than the window, which is then scaled up with nearest filtering. The pixel art is already magnified several
+// times by the camera so little detail is lost, while the fragment work drops with the square of the scale. The HUD
+// is drawn after the world and stays at the window's resolution.
+//
+// The target is allocated for the smallest scale (highest resolution) that will be used. Larger scales draw into the
+// top-left part of it, clipped with a scissor so the rest of the target costs nothing, which lets the scale change
+// from frame to frame without reallocating anything. See ResolutionGovernor.h.
+
+struct LowResRenderer {
+    bool enabled = false;
+    float scale = 1.0f;      // Window size divided by the size the world is drawn at
+    float minScale = 1.0f;   // The scale the target was allocated for
+    int screenWidth = 0;
+    int screenHeight = 0;
+    RenderTexture2D target = { 0 };
+};
+
+inline LowResRenderer lowResRenderer;
+
+// Create the target at 1/minScale of the window's size and start drawing at that scale. Call after InitWindow().
+inline bool lowResInit(int screenWidth, int screenHeight, float minScale) {
+    if (minScale < 1.0f) {
+        return false;
+    }
+    if (lowResRenderer.enabled) {
+        UnloadRenderTexture(lowResRenderer.target);
+        lowResRenderer.enabled = false;
+    }
+
+    lowResRenderer.target = LoadRenderTexture((int)(screenWidth / minScale), (int)(screenHeight / minScale));
+    if (lowResRenderer.target.id == 0) {
+        printf("Failed to create the low-res render target\n");
+        return false;
+    }
+    SetTextureFilter(lowResRenderer.target.texture, TEXTURE_FILTER_POINT);
+    lowResRenderer.enabled = true;
+    lowResRenderer.scale = minScale;
+    lowResRenderer.minScale = minScale;
+    lowResRenderer.screenWidth = screenWidth;
+    lowResRenderer.screenHeight = screenHeight;
+    printf("Rendering the world at up to %dx%d\n", lowResRenderer.target.texture.width,
+           lowResRenderer.target.texture.height);
+    return true;
+}
+
+// Change the scale the world is drawn at. It can't go below the scale the target was allocated for.
+inline void lowResSetScale(float scale) {
+    lowResRenderer.scale = (scale > lowResRenderer.minScale) ? scale : lowResRenderer.minScale;
+}
+
+// Size, in pixels, of the part of the target the world is drawn into at the current scale
+inline int lowResWidth() { return (int)(lowResRenderer.screenWidth / lowResRenderer.scale); }
+inline int lowResHeight() { return (int)(lowResRenderer.screenHeight / lowResRenderer.scale); }
+
+// The given camera scaled down to the target, so exactly the same part of the world is visible as when drawing to the
+// window. Anything that culls against the framebuffer while the world is drawn, like DrawTMX(), needs this camera.
+inline Camera2D lowResWorldCamera(Camera2D camera) {
+    if (lowResRenderer.enabled) {
+        float scale = lowResRenderer.scale;
+        camera.offset.x /= scale;
+        camera.offset.y /= scale;
+        camera.zoom /= scale;
+    }
+    return camera;
+}
+
+// Begin drawing the world through the given camera, see lowResWorldCamera()
+inline void lowResBeginWorld(Camera2D camera) {
+    camera = lowResWorldCamera(camera);
+    if (lowResRenderer.enabled) {
+        BeginTextureMode(lowResRenderer.target);
+        ClearBackground(BLACK);
+        BeginScissorMode(0, 0, lowResWidth(), lowResHeight());
+    }
+    BeginMode2D(camera);
+}
+
+// Finish drawing the world and, in low-res mode, scale the target up to fill the window
+inline void lowResEndWorld() {
+    EndMode2D();
+    if (lowResRenderer.enabled) {
+        EndScissorMode();
+        EndTextureMode();
+
+        // Render textures are stored upside down, so the top-left part that was drawn into is at the bottom of the
+        // texture and the source height is negative
+        const Texture2D& texture = lowResRenderer.target.texture;
+        float width = (float)lowResWidth();
+        float height = (float)lowResHeight();
+        Rectangle source = { 0.0f, (float)texture.height - height, width, -height };
+        Rectangle dest = { 0.0f, 0.0f, (float)lowResRenderer.screenWidth, (float)lowResRenderer.screenHeight };
+        DrawTexturePro(texture, source, dest, Vector2{ 0.0f, 0.0f }, 0.0f, WHITE);
+    }
+}
+
+inline void lowResShutdown() {
+    if (lowResRenderer.enabled) {
+        UnloadRenderTexture(lowResRenderer.target);
+        lowResRenderer.enabled = false;
+    }
+}
+
+#endif // LOW_RES_RENDERER_H
@@ -0,0 +1,146 @@
+#ifndef MEMORY_STATS_H
+#define MEMORY_STATS_H
+
+#include "raylib.h"
+#include "raytmx.h"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+// Memory accounting for the debug overlay. Every resource the game owns is counted against a category, each with a
+// budget, split between CPU heap, texture VRAM and audio buffers:
+//   - Maps are measured directly with GetMemoryUsageTMX(), which reports raytmx's MemAlloc()'d arenas and chunks
+//     along with the VRAM of the map's textures.
+//   - Everything else is counted where the game loads or allocates it, with memTrackBytes(), memTrackTexture() and
+//     memTrackMusic(). Resources loaded by the character classes themselves aren't visible here.
+// Fixed pools, like the particles, are counted as heap because they're just as much part of the footprint.
+//
+// The overlay also shows how much each category grew between entering the previous room and entering the current one,
+// so anything a room hop leaks stands out for as long as the player stays in the new room.
+
+enum MemoryCategory {
+    MEM_HEAP_MAPS,
+    MEM_HEAP_CHARACTERS,
+    MEM_HEAP_POOLS,
+    MEM_HEAP_NAVIGATION,
+    MEM_HEAP_HISTORY,
+    MEM_VRAM_MAPS,
+    MEM_VRAM_TEXTURES,
+    MEM_VRAM_RENDER_TARGETS,
+    MEM_AUDIO_MUSIC,
+    MEM_CATEGORY_COUNT
+};
+
+inline const char* MEMORY_CATEGORY_NAMES[MEM_CATEGORY_COUNT] = {
+    "heap: maps", "heap: characters", "heap: pools", "heap: navigation", "heap: history", "vram: maps",
+    "vram: textures", "vram: render targets", "audio: music streams"
+};
+
+const size_t MEMORY_MB = 1024 * 1024;
+
+inline size_t MEMORY_BUDGETS[MEM_CATEGORY_COUNT] = {
+    64 * MEMORY_MB,     // Maps are large: 1500x500 tiles of four bytes is about 3 MB a layer
+    1 * MEMORY_MB,
+    16 * MEMORY_MB,
+    16 * MEMORY_MB,     // The grid's cells alone are 750 KB for a 1500x500 map
+    8 * MEMORY_MB,      // The rewind buffer is allocated once, at HISTORY_BUDGET
+    64 * MEMORY_MB,
+    32 * MEMORY_MB,
+    32 * MEMORY_MB,
+    1 * MEMORY_MB
+};
+
+struct MemoryStats {
+    size_t bytes[MEM_CATEGORY_COUNT] = { 0 };
+    size_t roomStartBytes[MEM_CATEGORY_COUNT] = { 0 };  // Snapshot taken when the current room was entered
+    long long lastHopBytes[MEM_CATEGORY_COUNT] = { 0 };  // Growth from the previous room's snapshot to this one's
+    bool overBudget[MEM_CATEGORY_COUNT] = { false };
+    char room[64] = "";          // File name of the map the deltas are measured from
+    bool showOverlay = false;
+};
+
+inline MemoryStats memoryStats;
+
+// Count bytes allocated (positive) or freed (negative) against a category
+inline void memTrackBytes(MemoryCategory category, long long bytes) {
+    memoryStats.bytes[category] += bytes;
+}
+
+inline size_t memTextureBytes(const Texture2D& texture) {
+    return (size_t)GetPixelDataSize(texture.width, texture.height, texture.format);
+}
+
+// Count a texture the game loaded (direction 1) or unloaded (direction -1)
+inline void memTrackTexture(MemoryCategory category, const Texture2D& texture, int direction = 1) {
+    memoryStats.bytes[category] += direction * (long long)memTextureBytes(texture);
+}
+
+// Music is streamed, so only its buffers are resident: raylib keeps two sub-buffers, of the size given to
+// SetAudioStreamBufferSizeDefault() or 1/30 s if that's 0. The decoder's own state isn't visible, so this is an estimate.
+inline void memTrackMusic(const Music& music, int subBufferFrames, int direction = 1) {
+    const AudioStream& stream = music.stream;
+    size_t frames = (subBufferFrames > 0) ? (size_t)subBufferFrames : stream.sampleRate / 30;
+    size_t bytes = 2 * frames * stream.channels * (stream.sampleSize / 8);
+    memoryStats.bytes[MEM_AUDIO_MUSIC] += direction * (long long)bytes;
+}
+
+// Refresh the measured categories from the current map, or from every map of the world it was streamed in from.
+// Call every frame so room hops are noticed.
+inline void memUpdate(const TmxMap* map, const TmxWorld* world = nullptr) {
+    MemoryStats& stats = memoryStats;
+    stats.bytes[MEM_HEAP_MAPS] = 0;
+    stats.bytes[MEM_VRAM_MAPS] = 0;
+    uint32_t mapCount = world ? world->mapsLength : 1;
+    for (uint32_t i = 0; i < mapCount; i++) {
+        TmxMemoryUsage usage = GetMemoryUsageTMX(world ? world->maps[i].map : map);
+        stats.bytes[MEM_HEAP_MAPS] += usage.heapBytes + usage.chunkBytes;
+        stats.bytes[MEM_VRAM_MAPS] += usage.textureBytes;
+    }
+
+    const char* room = (map && map->fileName) ? map->fileName : "";
+    if (strcmp(room, stats.room) != 0) {
+        strncpy(stats.room, room, sizeof(stats.room) - 1);
+        for (int i = 0; i < MEM_CATEGORY_COUNT; i++) {
+            stats.lastHopBytes[i] = (long long)stats.bytes[i] - (long long)stats.roomStartBytes[i];
+            stats.roomStartBytes[i] = stats.bytes[i];
+        }
+    }
+
+    // Warn once each time a category goes over its budget
+    for (int i = 0; i < MEM_CATEGORY_COUNT; i++) {
+        bool over = stats.bytes[i] > MEMORY_BUDGETS[i];
+        if (over && !stats.overBudget[i]) {
+            printf("Memory budget exceeded: %s is %.2f MB of %.2f MB\n", MEMORY_CATEGORY_NAMES[i],
+                   (double)stats.bytes[i] / MEMORY_MB, (double)MEMORY_BUDGETS[i] / MEMORY_MB);
+        }
+        stats.overBudget[i] = over;
+    }
+}
+
+// Draw the overlay at the given screen position. Categories over budget are drawn in red.
+inline void memDrawOverlay(int x, int y) {
+    const MemoryStats& stats = memoryStats;
+    const int lineHeight = 22;
+    const int budgetX = x + 230, deltaX = x + 420;
+    DrawRectangle(x - 10, y - 10, 560, lineHeight * (MEM_CATEGORY_COUNT + 2) + 20, Fade(BLACK, 0.7f));
+    DrawText("MEMORY (F4)", x, y, 20, WHITE);
+    DrawText("used / budget", budgetX, y, 20, WHITE);
+    DrawText("last hop", deltaX, y, 20, WHITE);
+
+    size_t total = 0;
+    for (int i = 0; i < MEM_CATEGORY_COUNT; i++) {
+        total += stats.bytes[i];
+        double used = (double)stats.bytes[i] / MEMORY_MB;
+        double budget = (double)MEMORY_BUDGETS[i] / MEMORY_MB;
+        double delta = (double)stats.lastHopBytes[i] / MEMORY_MB;
+        Color color = stats.overBudget[i] ? RED : (stats.bytes[i] > MEMORY_BUDGETS[i] * 3 / 4 ? YELLOW : LIGHTGRAY);
+        int lineY = y + lineHeight * (i + 1);
+        DrawText(MEMORY_CATEGORY_NAMES[i], x, lineY, 20, color);
+        DrawText(TextFormat("%.2f / %.0f MB", used, budget), budgetX, lineY, 20, color);
+        DrawText(TextFormat("%+.2f MB", delta), deltaX, lineY, 20, color);
+    }
+    DrawText(TextFormat("total %.2f MB", (double)total / MEMORY_MB), x, y + lineHeight * (MEM_CATEGORY_COUNT + 1),
+             20, WHITE);
+}
+
+#endif // MEMORY_STATS_H
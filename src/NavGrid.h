@@ -0,0 +1,290 @@
+#ifndef NAV_GRID_H
+#define NAV_GRID_H
+
+#include "raylib.h"
+#include "raytmx.h"
+#include "MemoryStats.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// Navigation for ground enemies, shared by all of them: one flow field toward the player that any enemy can sample
+// in constant time, so its cost doesn't grow with the number of enemies.
+//
+// The grid is built from the collision layer whenever the map changes. The map is cut into tile-sized cells, and a
+// cell is solid if any collision object overlaps it. The graph's nodes are the cells a character can stand in: free,
+// with free space above and solid ground below. Its edges are the moves a character can make from one to another:
+//   - walking to the next cell, or stepping up or down one,
+//   - falling off an edge to wherever the column below lands,
+//   - jumping up to NAV_JUMP_CELLS cells and NAV_JUMP_REACH cells across, when nothing is in the way overhead.
+//
+// The flow field is a breadth-first search from the player's node over the reversed edges, which gives every node its
+// distance to the player and the next node on a shortest way there. It's rebuilt when the player reaches a different
+// node. The search is spread over several ticks, NAV_NODES_PER_TICK nodes at a time, and enemies keep following the
+// previous field until the new one is done. Like the AI budget, it counts nodes rather than time, to keep replays in
+// sync.
+
+const int NAV_JUMP_CELLS = 4;            // Highest jump in cells
+const int NAV_JUMP_REACH = 2;            // Farthest a jump goes across in cells
+const int NAV_MAX_FALL = 64;             // Farthest fall in cells, anything deeper is treated as a pit
+const int NAV_NODES_PER_TICK = 4096;     // Nodes the flow field search visits per tick
+const int NAV_UNREACHABLE = INT_MAX;
+
+struct NavGrid {
+    const TmxMap* map = nullptr;
+    char mapName[64] = "";
+    int cellSize = 16;
+    int width = 0, height = 0;           // In cells
+    std::vector<unsigned char> solid;    // One per cell
+    std::vector<int> nodeOfCell;         // Node standing in each cell, or -1
+    std::vector<int> nodeCell;           // Cell of each node
+    std::vector<int> edgeStart, edges;   // Moves out of each node, edges[edgeStart[n]] to edges[edgeStart[n + 1] - 1]
+    std::vector<int> reverseStart, reverseEdges; // Moves into each node, laid out the same way
+    size_t bytes = 0;                    // Counted in the memory overlay
+
+    // The field enemies follow
+    std::vector<int> distance, next;     // Moves to the goal, and the node to move to, for each node
+    int goal = -1;
+
+    // The field being searched
+    std::vector<int> searchDistance, searchNext, queue;
+    size_t queueHead = 0;
+    int searchGoal = -1;
+    bool searching = false;
+    int searchTicks = 0;                 // Ticks the last completed search took
+};
+
+// One step along the flow field
+struct NavStep {
+    bool valid;                          // False off the grid, or where the player can't be reached from
+    int dx, dy;                          // Direction to the next cell, dy < 0 is up (a jump or a step up)
+    int distance;                        // Moves left to the player
+};
+
+inline NavGrid navGrid;
+
+inline bool navInside(int x, int y) {
+    return x >= 0 && y >= 0 && x < navGrid.width && y < navGrid.height;
+}
+
+inline bool navSolid(int x, int y) {
+    return !navInside(x, y) || navGrid.solid[(size_t)y * navGrid.width + x];
+}
+
+inline int navNodeAt(int x, int y) {
+    return navInside(x, y) ? navGrid.nodeOfCell[(size_t)y * navGrid.width + x] : -1;
+}
+
+// Add every object group with the given name's objects to the solid cells
+inline void navRasterizeLayers(const TmxLayer* layers, uint32_t layersLength, const char* layerName) {
+    NavGrid& nav = navGrid;
+    for (uint32_t i = 0; i < layersLength; i++) {
+        const TmxLayer& layer = layers[i];
+        if (layer.type == LAYER_TYPE_GROUP) {
+            navRasterizeLayers(layer.layers, layer.layersLength, layerName);
+            continue;
+        }
+        if (layer.type != LAYER_TYPE_OBJECT_GROUP || strcmp(layer.name, layerName) != 0) {
+            continue;
+        }
+        const TmxObjectGroup& group = layer.exact.objectGroup;
+        for (uint32_t o = 0; o < group.objectsLength; o++) {
+            Rectangle aabb = group.objects[o].aabb;
+            int left = (int)(aabb.x / nav.cellSize), right = (int)((aabb.x + aabb.width) / nav.cellSize);
+            int top = (int)(aabb.y / nav.cellSize), bottom = (int)((aabb.y + aabb.height) / nav.cellSize);
+            for (int y = (top > 0 ? top : 0); y <= bottom && y < nav.height; y++) {
+                for (int x = (left > 0 ? left : 0); x <= right && x < nav.width; x++) {
+                    nav.solid[(size_t)y * nav.width + x] = 1;
+                }
+            }
+        }
+    }
+}
+
+// Lay out (from, to) pairs as a compressed adjacency list: start[n] is where node n's entries begin in list
+inline void navBuildAdjacency(const std::vector<std::pair<int, int>>& pairs, int nodeCount, bool reversed,
+                              std::vector<int>& start, std::vector<int>& list) {
+    start.assign(nodeCount + 1, 0);
+    for (const std::pair<int, int>& pair : pairs) {
+        start[(reversed ? pair.second : pair.first) + 1]++;
+    }
+    for (int n = 0; n < nodeCount; n++) {
+        start[n + 1] += start[n];
+    }
+    list.resize(pairs.size());
+    std::vector<int> fill(start.begin(), start.end() - 1);
+    for (const std::pair<int, int>& pair : pairs) {
+        int from = reversed ? pair.second : pair.first;
+        list[fill[from]++] = reversed ? pair.first : pair.second;
+    }
+}
+
+// Build the grid and its graph from the map's collision layer. Forgets any flow field.
+inline void navBuild(const TmxMap* map, const char* layerName) {
+    NavGrid& nav = navGrid;
+    nav.map = map;
+    strncpy(nav.mapName, (map && map->fileName) ? map->fileName : "", sizeof(nav.mapName) - 1);
+    nav.cellSize = (map && map->tileWidth > 0) ? (int)map->tileWidth : 16;
+    nav.width = map ? (int)map->width : 0;
+    nav.height = map ? (int)map->height : 0;
+    nav.solid.assign((size_t)nav.width * nav.height, 0);
+    nav.nodeOfCell.assign((size_t)nav.width * nav.height, -1);
+    nav.nodeCell.clear();
+    if (map) {
+        navRasterizeLayers(map->layers, map->layersLength, layerName);
+    }
+
+    // Nodes: free cells with room for a character's head and ground to stand on
+    for (int y = 0; y < nav.height; y++) {
+        for (int x = 0; x < nav.width; x++) {
+            if (!navSolid(x, y) && !navSolid(x, y - 1) && navInside(x, y + 1) && navSolid(x, y + 1)) {
+                nav.nodeOfCell[(size_t)y * nav.width + x] = (int)nav.nodeCell.size();
+                nav.nodeCell.push_back(y * nav.width + x);
+            }
+        }
+    }
+
+    // Edges: every move a character can make from each node
+    std::vector<std::pair<int, int>> pairs;
+    int nodeCount = (int)nav.nodeCell.size();
+    for (int node = 0; node < nodeCount; node++) {
+        int x = nav.nodeCell[node] % nav.width, y = nav.nodeCell[node] / nav.width;
+        size_t first = pairs.size();
+        auto addEdge = [&](int target) {
+            for (size_t i = first; i < pairs.size(); i++) {
+                if (pairs[i].second == target) {
+                    return;
+                }
+            }
+            pairs.push_back(std::make_pair(node, target));
+        };
+
+        for (int dir = -1; dir <= 1; dir += 2) {
+            int side = x + dir;
+            if (navNodeAt(side, y) >= 0) {
+                addEdge(navNodeAt(side, y));                        // Walk
+            } else if (navNodeAt(side, y - 1) >= 0) {
+                addEdge(navNodeAt(side, y - 1));                    // Step up
+            } else if (!navSolid(side, y)) {
+                // Walk off the edge and fall until something is underfoot
+                for (int fall = 1; fall <= NAV_MAX_FALL && !navSolid(side, y + fall); fall++) {
+                    if (navNodeAt(side, y + fall) >= 0) {
+                        addEdge(navNodeAt(side, y + fall));
+                        break;
+                    }
+                }
+            }
+        }
+
+        for (int up = 1; up <= NAV_JUMP_CELLS && !navSolid(x, y - up - 1); up++) {
+            for (int across = -NAV_JUMP_REACH; across <= NAV_JUMP_REACH; across++) {
+                if (navNodeAt(x + across, y - up) >= 0) {
+                    addEdge(navNodeAt(x + across, y - up));
+                }
+            }
+        }
+    }
+    navBuildAdjacency(pairs, nodeCount, false, nav.edgeStart, nav.edges);
+    navBuildAdjacency(pairs, nodeCount, true, nav.reverseStart, nav.reverseEdges);
+
+    nav.distance.assign(nodeCount, NAV_UNREACHABLE);
+    nav.next.assign(nodeCount, -1);
+    nav.searchDistance.assign(nodeCount, NAV_UNREACHABLE);
+    nav.searchNext.assign(nodeCount, -1);
+    nav.queue.clear();
+    nav.queue.reserve(nodeCount);
+    nav.goal = nav.searchGoal = -1;
+    nav.searching = false;
+
+    size_t bytes = nav.solid.size() + sizeof(int) * (nav.nodeOfCell.size() + nav.nodeCell.size() +
+                   nav.edgeStart.size() + nav.edges.size() + nav.reverseStart.size() + nav.reverseEdges.size() +
+                   5 * (size_t)nodeCount);
+    memTrackBytes(MEM_HEAP_NAVIGATION, (long long)bytes - (long long)nav.bytes);
+    nav.bytes = bytes;
+    printf("Navigation grid for %s: %dx%d cells, %d nodes, %zu moves\n", nav.mapName, nav.width, nav.height,
+           nodeCount, nav.edges.size());
+}
+
+// The node a character is standing in, looking a few cells below its feet in case it's in the air
+inline int navNodeUnder(Rectangle character) {
+    NavGrid& nav = navGrid;
+    int x = (int)((character.x + character.width / 2) / nav.cellSize);
+    int y = (int)((character.y + character.height - 1.0f) / nav.cellSize);
+    for (int below = 0; below <= 2; below++) {
+        int node = navNodeAt(x, y + below);
+        if (node >= 0) {
+            return node;
+        }
+    }
+    return -1;
+}
+
+// Rebuild the grid if the map changed, and move the flow field along. Call once per tick.
+inline void navUpdate(const TmxMap* map, const char* layerName, Rectangle player) {
+    NavGrid& nav = navGrid;
+    if (map != nav.map || (map && map->fileName && strcmp(map->fileName, nav.mapName) != 0)) {
+        navBuild(map, layerName);
+    }
+
+    // Start over when the player reaches a different node. In the air, the last node they stood on is kept.
+    int playerNode = navNodeUnder(player);
+    int target = nav.searching ? nav.searchGoal : nav.goal;
+    if (playerNode >= 0 && playerNode != target) {
+        std::fill(nav.searchDistance.begin(), nav.searchDistance.end(), NAV_UNREACHABLE);
+        nav.searchDistance[playerNode] = 0;
+        nav.searchNext[playerNode] = playerNode;
+        nav.queue.clear();
+        nav.queue.push_back(playerNode);
+        nav.queueHead = 0;
+        nav.searchGoal = playerNode;
+        nav.searching = true;
+        nav.searchTicks = 0;
+    }
+    if (!nav.searching) {
+        return;
+    }
+
+    // Walk the moves backwards from the goal, so each node learns which move leads toward it
+    nav.searchTicks++;
+    for (int visited = 0; visited < NAV_NODES_PER_TICK && nav.queueHead < nav.queue.size(); visited++) {
+        int node = nav.queue[nav.queueHead++];
+        for (int i = nav.reverseStart[node]; i < nav.reverseStart[node + 1]; i++) {
+            int from = nav.reverseEdges[i];
+            if (nav.searchDistance[from] == NAV_UNREACHABLE) {
+                nav.searchDistance[from] = nav.searchDistance[node] + 1;
+                nav.searchNext[from] = node;
+                nav.queue.push_back(from);
+            }
+        }
+    }
+    if (nav.queueHead == nav.queue.size()) {
+        nav.distance.swap(nav.searchDistance);
+        nav.next.swap(nav.searchNext);
+        nav.goal = nav.searchGoal;
+        nav.searching = false;
+    }
+}
+
+// Which way a character should go to reach the player
+inline NavStep navSample(Rectangle character) {
+    NavGrid& nav = navGrid;
+    int node = (nav.goal >= 0) ? navNodeUnder(character) : -1;
+    if (node < 0 || nav.distance[node] == NAV_UNREACHABLE) {
+        return NavStep{ false, 0, 0, NAV_UNREACHABLE };
+    }
+    int from = nav.nodeCell[node], to = nav.nodeCell[nav.next[node]];
+    int dx = (to % nav.width) - (from % nav.width), dy = (to / nav.width) - (from / nav.width);
+    return NavStep{ true, (dx > 0) - (dx < 0), (dy > 0) - (dy < 0), nav.distance[node] };
+}
+
+// One line for the debug overlay
+inline void navDescribe(char* buffer, int bufferSize) {
+    const NavGrid& nav = navGrid;
+    snprintf(buffer, bufferSize, "Nav: %d nodes, %zu moves, %s (last search %d ticks)", (int)nav.nodeCell.size(),
+             nav.edges.size(), nav.searching ? "searching" : "field ready", nav.searchTicks);
+}
+
+#endif // NAV_GRID_H
@@ -0,0 +1,204 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include "raylib.h"
+#include "rlgl.h"
+#include <cmath>
+#include <cstdint>
+
+// Particles for combat effects: sword sparks, blood, dust and death bursts.
+//
+// Every particle lives in one fixed-capacity pool stored as a structure of arrays, so updating them is a handful of
+// straight loops over contiguous floats that the compiler vectorizes, with no allocation after startup. Dead
+// particles are removed by moving the last live particle into their slot, which keeps the live ones packed at the
+// front. All of them are drawn as flat-colored quads inside a single rlBegin()/rlEnd(), which raylib submits in as few
+// batches as its vertex buffer allows instead of one draw call per particle.
+//
+// Particles are purely visual. They use their own random numbers so emitting them doesn't change the sequence the
+// game's logic gets from GetRandomValue(), which input replays depend on.
+
+const int PARTICLE_CAPACITY = 131072;
+
+struct ParticlePool {
+    int count = 0;
+    alignas(32) float posX[PARTICLE_CAPACITY];
+    alignas(32) float posY[PARTICLE_CAPACITY];
+    alignas(32) float velX[PARTICLE_CAPACITY];
+    alignas(32) float velY[PARTICLE_CAPACITY];
+    alignas(32) float gravity[PARTICLE_CAPACITY];
+    alignas(32) float life[PARTICLE_CAPACITY];        // Seconds left
+    alignas(32) float inverseLifetime[PARTICLE_CAPACITY]; // 1 / starting life, for fading out
+    alignas(32) float size[PARTICLE_CAPACITY];
+    Color color[PARTICLE_CAPACITY];
+};
+
+// Describes one kind of burst. Speeds are in pixels per second, angles in degrees with 0 pointing right and 90 down.
+struct ParticleEmitter {
+    Color color;
+    float minSpeed, maxSpeed;
+    float angle;                 // Direction of the burst
+    float spread;                // Particles leave within this many degrees either side of the angle
+    float minLife, maxLife;
+    float minSize, maxSize;
+    float gravity;               // Pixels per second squared, positive is down
+};
+
+const ParticleEmitter SPARK_EMITTER = { Color{ 255, 220, 120, 255 }, 80.0f, 220.0f, -90.0f, 70.0f,
+                                        0.15f, 0.35f, 1.0f, 2.0f, 300.0f };
+const ParticleEmitter BLOOD_EMITTER = { Color{ 170, 10, 20, 255 }, 40.0f, 140.0f, -90.0f, 60.0f,
+                                        0.3f, 0.7f, 1.5f, 3.0f, 500.0f };
+const ParticleEmitter DUST_EMITTER = { Color{ 150, 140, 130, 160 }, 10.0f, 50.0f, -90.0f, 80.0f,
+                                       0.3f, 0.6f, 2.0f, 4.0f, -20.0f };
+const ParticleEmitter DEATH_EMITTER = { Color{ 120, 40, 160, 255 }, 30.0f, 180.0f, -90.0f, 180.0f,
+                                        0.6f, 1.4f, 2.0f, 4.0f, 60.0f };
+
+inline ParticlePool particles;
+inline uint32_t particleRandomState = 0x9E3779B9u;
+
+// xorshift32, mapped to [0, 1)
+inline float particleRandom() {
+    uint32_t x = particleRandomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    particleRandomState = x;
+    return (x >> 8) * (1.0f / 16777216.0f);
+}
+
+inline float particleRandomRange(float min, float max) {
+    return min + (max - min) * particleRandom();
+}
+
+// Emit up to count particles at the given position. Particles that don't fit in the pool are dropped.
+// Pass a direction of -1 to mirror the burst horizontally, e.g. for a character facing left.
+inline void particlesEmit(const ParticleEmitter& emitter, Vector2 position, int count, float direction = 1.0f) {
+    ParticlePool& pool = particles;
+    if (count > PARTICLE_CAPACITY - pool.count) {
+        count = PARTICLE_CAPACITY - pool.count;
+    }
+
+    for (int n = 0; n < count; n++) {
+        int i = pool.count++;
+        float angle = (emitter.angle + particleRandomRange(-emitter.spread, emitter.spread)) * DEG2RAD;
+        float speed = particleRandomRange(emitter.minSpeed, emitter.maxSpeed);
+        float life = particleRandomRange(emitter.minLife, emitter.maxLife);
+
+        pool.posX[i] = position.x;
+        pool.posY[i] = position.y;
+        pool.velX[i] = cosf(angle) * speed * direction;
+        pool.velY[i] = sinf(angle) * speed;
+        pool.gravity[i] = emitter.gravity;
+        pool.life[i] = life;
+        pool.inverseLifetime[i] = 1.0f / life;
+        pool.size[i] = particleRandomRange(emitter.minSize, emitter.maxSize);
+        pool.color[i] = emitter.color;
+    }
+}
+
+// Integrate the live particles in [begin, end) over dt seconds. Separate ranges can be integrated in parallel.
+inline void particlesIntegrate(int begin, int end, float dt) {
+    ParticlePool& pool = particles;
+    float* __restrict posX = pool.posX;
+    float* __restrict posY = pool.posY;
+    float* __restrict velX = pool.velX;
+    float* __restrict velY = pool.velY;
+    const float* __restrict gravity = pool.gravity;
+    float* __restrict life = pool.life;
+
+    // No branches or calls, so each of these compiles to packed SIMD arithmetic
+    for (int i = begin; i < end; i++) {
+        velY[i] += gravity[i] * dt;
+    }
+    for (int i = begin; i < end; i++) {
+        posX[i] += velX[i] * dt;
+        posY[i] += velY[i] * dt;
+        life[i] -= dt;
+    }
+}
+
+// Remove the particles that expired. Call after every range has been integrated.
+inline void particlesCompact() {
+    ParticlePool& pool = particles;
+    const int count = pool.count;
+    float* posX = pool.posX;
+    float* posY = pool.posY;
+    float* velX = pool.velX;
+    float* velY = pool.velY;
+    float* life = pool.life;
+
+    // Compact. Walking backwards means the particle moved into a dead slot has already been checked.
+    int live = count;
+    for (int i = count - 1; i >= 0; i--) {
+        if (life[i] <= 0.0f) {
+            live--;
+            posX[i] = posX[live];
+            posY[i] = posY[live];
+            velX[i] = velX[live];
+            velY[i] = velY[live];
+            pool.gravity[i] = pool.gravity[live];
+            life[i] = life[live];
+            pool.inverseLifetime[i] = pool.inverseLifetime[live];
+            pool.size[i] = pool.size[live];
+            pool.color[i] = pool.color[live];
+        }
+    }
+    pool.count = live;
+}
+
+// Integrate every live particle over dt seconds and remove the ones that expired
+inline void particlesUpdate(float dt) {
+    particlesIntegrate(0, particles.count, dt);
+    particlesCompact();
+}
+
+// Draw every live particle that overlaps the view. Call between BeginMode2D() and EndMode2D().
+inline void particlesDraw(Rectangle view) {
+    const ParticlePool& pool = particles;
+    if (pool.count == 0) {
+        return;
+    }
+
+    float left = view.x, top = view.y, right = view.x + view.width, bottom = view.y + view.height;
+
+    // Sample the same white texel raylib's shapes use, so the quads can share a batch with them
+    Texture2D shapesTexture = GetShapesTexture();
+    Rectangle shapesRect = GetShapesTextureRectangle();
+    float u = (shapesRect.x + shapesRect.width * 0.5f) / shapesTexture.width;
+    float v = (shapesRect.y + shapesRect.height * 0.5f) / shapesTexture.height;
+
+    rlSetTexture(shapesTexture.id);
+    rlBegin(RL_QUADS);
+    for (int i = 0; i < pool.count; i++) {
+        float x = pool.posX[i], y = pool.posY[i], s = pool.size[i];
+        if (x + s < left || x > right || y + s < top || y > bottom) {
+            continue;
+        }
+
+        Color color = pool.color[i];
+        float fade = pool.life[i] * pool.inverseLifetime[i];
+        rlColor4ub(color.r, color.g, color.b, (unsigned char)(color.a * fade));
+        rlTexCoord2f(u, v);
+        // Counter-clockwise, matching raylib's own quads
+        rlVertex2f(x, y);
+        rlVertex2f(x, y + s);
+        rlVertex2f(x + s, y + s);
+        rlVertex2f(x + s, y);
+    }
+    rlEnd();
+    rlSetTexture(0);
+}
+
+inline int particlesCount() { return particles.count; }
+
+// Move every live particle by the same offset, e.g. when the coordinates they're in are shifted
+inline void particlesTranslate(Vector2 offset) {
+    ParticlePool& pool = particles;
+    for (int i = 0; i < pool.count; i++) {
+        pool.posX[i] += offset.x;
+        pool.posY[i] += offset.y;
+    }
+}
+
+inline void particlesClear() { particles.count = 0; }
+
+#endif // PARTICLE_SYSTEM_H
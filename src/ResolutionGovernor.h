@@ -0,0 +1,128 @@
+#ifndef RESOLUTION_GOVERNOR_H
+#define RESOLUTION_GOVERNOR_H
+
+#include "LowResRenderer.h"
+#include <cmath>
+#include <cstdio>
+
+// Dynamic resolution. Watches the measured frame time and moves the low-res renderer's scale between two bounds to
+// hold a target frame time.
+//
+// With a frame cap, a frame that has time to spare still takes exactly the target time, so spare time can't be
+// measured directly. Instead the governor lowers the resolution as soon as the recent average misses the target,
+// and only tries a higher resolution again after a long run of frames on target. Lowering reacts within half a
+// second while raising waits several seconds, and every change clears the history, so the scale can't oscillate.
+// If a step up is followed by a miss soon after, the step is undone and the wait before the next attempt doubles.
+
+const int GOVERNOR_WINDOW = 30;              // Frames averaged before any decision
+const int GOVERNOR_UPGRADE_FRAMES = 180;     // Frames on target before trying a higher resolution
+const int GOVERNOR_MAX_UPGRADE_FRAMES = 3600;
+const float GOVERNOR_MISS_RATIO = 1.10f;     // Average above this much of the target lowers the resolution
+const float GOVERNOR_ON_TARGET_RATIO = 1.03f; // Average below this much of the target counts as on target
+
+struct ResolutionGovernor {
+    bool enabled = false;
+    float targetFrameTime = 1.0f / 60.0f;
+    float minScale = 1.0f;
+    float maxScale = 3.0f;
+    float step = 0.25f;
+
+    float frameTimes[GOVERNOR_WINDOW] = { 0 };
+    int frameCount = 0;          // Frames recorded since the last change, the window holds the latest of them
+    float averageFrameTime = 0.0f;
+    int framesOnTarget = 0;
+    int upgradeFrames = GOVERNOR_UPGRADE_FRAMES;
+    bool probing = false;        // True right after a step up, until the new scale has proven itself
+    char lastDecision[96] = "none";
+};
+
+inline ResolutionGovernor governor;
+
+// Start governing the low-res renderer. The target is allocated for minScale, the highest resolution allowed.
+inline bool governorInit(int screenWidth, int screenHeight, float targetFrameTime, float minScale, float maxScale) {
+    if (!lowResInit(screenWidth, screenHeight, minScale)) {
+        return false;
+    }
+    governor.enabled = true;
+    governor.targetFrameTime = targetFrameTime;
+    governor.minScale = minScale;
+    governor.maxScale = (maxScale > minScale) ? maxScale : minScale;
+    lowResSetScale(minScale);
+    printf("Dynamic resolution: scale %.2f to %.2f, target %.1f ms\n", governor.minScale, governor.maxScale,
+           targetFrameTime * 1000.0f);
+    return true;
+}
+
+inline void governorSetScale(float scale, const char* reason) {
+    float previous = lowResRenderer.scale;
+    lowResSetScale(scale);
+    snprintf(governor.lastDecision, sizeof(governor.lastDecision), "%.2f -> %.2f (%s, avg %.1f ms)", previous,
+             lowResRenderer.scale, reason, governor.averageFrameTime * 1000.0f);
+    printf("Dynamic resolution: %s\n", governor.lastDecision);
+
+    // The frames so far were drawn at the old scale and say nothing about the new one
+    governor.frameCount = 0;
+    governor.framesOnTarget = 0;
+}
+
+// Record the last frame's time and adjust the scale. Call once per frame with the real, unscaled frame time.
+inline void governorUpdate(float frameTime) {
+    if (!governor.enabled) {
+        return;
+    }
+
+    // A single hitch, like loading a room, shouldn't outweigh the rest of the window
+    float limit = governor.targetFrameTime * 2.0f;
+    governor.frameTimes[governor.frameCount % GOVERNOR_WINDOW] = (frameTime < limit) ? frameTime : limit;
+    governor.frameCount++;
+    if (governor.frameCount < GOVERNOR_WINDOW) {
+        return;
+    }
+
+    float sum = 0.0f;
+    for (int i = 0; i < GOVERNOR_WINDOW; i++) {
+        sum += governor.frameTimes[i];
+    }
+    governor.averageFrameTime = sum / GOVERNOR_WINDOW;
+    float scale = lowResRenderer.scale;
+
+    if (governor.averageFrameTime > governor.targetFrameTime * GOVERNOR_MISS_RATIO) {
+        if (governor.probing) {
+            // The step up didn't fit, so wait longer before the next try
+            governor.upgradeFrames *= 2;
+            if (governor.upgradeFrames > GOVERNOR_MAX_UPGRADE_FRAMES) {
+                governor.upgradeFrames = GOVERNOR_MAX_UPGRADE_FRAMES;
+            }
+            governor.probing = false;
+        }
+        if (scale < governor.maxScale) {
+            governorSetScale(fminf(scale + governor.step, governor.maxScale), "missed target");
+        }
+        return;
+    }
+
+    if (governor.averageFrameTime < governor.targetFrameTime * GOVERNOR_ON_TARGET_RATIO) {
+        governor.framesOnTarget++;
+    } else {
+        governor.framesOnTarget = 0;
+    }
+
+    if (governor.probing && governor.framesOnTarget >= GOVERNOR_WINDOW) {
+        // The last step up held, so the next one can come sooner
+        governor.probing = false;
+        governor.upgradeFrames = GOVERNOR_UPGRADE_FRAMES;
+    }
+
+    if (governor.framesOnTarget >= governor.upgradeFrames && scale > governor.minScale) {
+        governorSetScale(fmaxf(scale - governor.step, governor.minScale), "on target");
+        governor.probing = true;
+    }
+}
+
+// One line for the debug overlay
+inline void governorDescribe(char* buffer, int bufferSize) {
+    snprintf(buffer, bufferSize, "Render scale %.2f (%dx%d), avg %.1f ms, last change %s", lowResRenderer.scale,
+             lowResWidth(), lowResHeight(), governor.averageFrameTime * 1000.0f, governor.lastDecision);
+}
+
+#endif // RESOLUTION_GOVERNOR_H
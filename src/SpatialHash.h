@@ -0,0 +1,140 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include "raylib.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Spatial hash of the entities in the world, used to decide which of them are awake. Each frame the game asks for the
+// entities near the camera, and only those are simulated and drawn. The rest stay dormant, costing nothing, until
+// the camera comes close enough to wake them.
+//
+// The world is divided into square cells and each entity is filed under the cell its top-left corner is in, in one of
+// a fixed number of buckets picked by hashing the cell's coordinates. Moving an entity only touches the buckets when
+// it crosses into another cell. A query visits the cells the area overlaps, plus one more row and column up and to the
+// left for entities that start in a neighbouring cell and reach into the area, which assumes no entity is bigger than
+// a cell.
+
+const float SPATIAL_CELL_SIZE = 256.0f;
+const int SPATIAL_BUCKETS = 1024;        // A power of two
+const float ACTIVATION_MARGIN = 256.0f;  // Pixels around the camera's view in which entities are awake
+
+struct SpatialEntity {
+    Rectangle rect;
+    int cellX, cellY;
+    bool used;                           // False once removed, the slot is reused by the next insert
+    bool awake;
+};
+
+struct SpatialHash {
+    std::vector<SpatialEntity> entities;
+    std::vector<int> buckets[SPATIAL_BUCKETS];
+    std::vector<int> awake;              // Entities found by the last spatialActivate()
+    std::vector<int> freeSlots;
+    int count = 0;
+};
+
+inline SpatialHash spatialHash;
+
+inline int spatialCell(float coordinate) {
+    return (int)floorf(coordinate / SPATIAL_CELL_SIZE);
+}
+
+inline std::vector<int>& spatialBucket(int cellX, int cellY) {
+    unsigned int hash = ((unsigned int)cellX * 73856093u) ^ ((unsigned int)cellY * 19349663u);
+    return spatialHash.buckets[hash & (SPATIAL_BUCKETS - 1)];
+}
+
+inline void spatialUnlink(int entity) {
+    const SpatialEntity& e = spatialHash.entities[entity];
+    std::vector<int>& bucket = spatialBucket(e.cellX, e.cellY);
+    for (size_t i = 0; i < bucket.size(); i++) {
+        if (bucket[i] == entity) {
+            bucket[i] = bucket.back();
+            bucket.pop_back();
+            return;
+        }
+    }
+}
+
+// Add an entity and return its ID, which stays valid until it's removed. New entities are dormant.
+inline int spatialInsert(Rectangle rect) {
+    SpatialHash& hash = spatialHash;
+    int entity;
+    if (!hash.freeSlots.empty()) {
+        entity = hash.freeSlots.back();
+        hash.freeSlots.pop_back();
+    } else {
+        entity = (int)hash.entities.size();
+        hash.entities.push_back(SpatialEntity{});
+    }
+    hash.entities[entity] = SpatialEntity{ rect, spatialCell(rect.x), spatialCell(rect.y), true, false };
+    spatialBucket(hash.entities[entity].cellX, hash.entities[entity].cellY).push_back(entity);
+    hash.count++;
+    return entity;
+}
+
+inline void spatialRemove(int entity) {
+    SpatialHash& hash = spatialHash;
+    if (entity < 0 || entity >= (int)hash.entities.size() || !hash.entities[entity].used) {
+        return;
+    }
+    spatialUnlink(entity);
+    hash.entities[entity].used = false;
+    hash.entities[entity].awake = false;
+    hash.freeSlots.push_back(entity);
+    hash.count--;
+}
+
+// Call whenever an entity moves
+inline void spatialMove(int entity, Rectangle rect) {
+    if (entity < 0 || entity >= (int)spatialHash.entities.size() || !spatialHash.entities[entity].used) {
+        return;
+    }
+    SpatialEntity& e = spatialHash.entities[entity];
+    int cellX = spatialCell(rect.x), cellY = spatialCell(rect.y);
+    if (cellX != e.cellX || cellY != e.cellY) {
+        spatialUnlink(entity);
+        e.cellX = cellX;
+        e.cellY = cellY;
+        spatialBucket(cellX, cellY).push_back(entity);
+    }
+    e.rect = rect;
+}
+
+// Wake the entities overlapping the area and put every other one to sleep. Returns the awake entities.
+inline const std::vector<int>& spatialActivate(Rectangle area) {
+    SpatialHash& hash = spatialHash;
+    for (int entity : hash.awake) {
+        hash.entities[entity].awake = false;
+    }
+    hash.awake.clear();
+
+    int left = spatialCell(area.x) - 1, right = spatialCell(area.x + area.width);
+    int top = spatialCell(area.y) - 1, bottom = spatialCell(area.y + area.height);
+    for (int cellY = top; cellY <= bottom; cellY++) {
+        for (int cellX = left; cellX <= right; cellX++) {
+            // Other cells can share the bucket, so check each entity's own cell too
+            for (int entity : spatialBucket(cellX, cellY)) {
+                SpatialEntity& e = hash.entities[entity];
+                if (e.cellX == cellX && e.cellY == cellY && !e.awake && CheckCollisionRecs(e.rect, area)) {
+                    e.awake = true;
+                    hash.awake.push_back(entity);
+                }
+            }
+        }
+    }
+    return hash.awake;
+}
+
+inline bool spatialIsAwake(int entity) {
+    return entity >= 0 && entity < (int)spatialHash.entities.size() && spatialHash.entities[entity].awake;
+}
+
+// One line for the debug overlay
+inline void spatialDescribe(char* buffer, int bufferSize) {
+    snprintf(buffer, bufferSize, "Entities: %d awake of %d", (int)spatialHash.awake.size(), spatialHash.count);
+}
+
+#endif // SPATIAL_HASH_H
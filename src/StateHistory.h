@@ -0,0 +1,265 @@
+#ifndef STATE_HISTORY_H
+#define STATE_HISTORY_H
+
+#include "raylib.h"
+#include "MemoryStats.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Tick-by-tick history of the world for rewinding, built from the same snapshots as checkpoints (WorldSnapshot.h).
+// Every HISTORY_KEYFRAME_INTERVAL ticks the whole snapshot is stored as a keyframe. The ticks in between are stored
+// as deltas against their keyframe: only the byte ranges that differ from it, so a tick in which little moved costs a
+// few bytes. Any tick is rebuilt from its keyframe and its own delta, without replaying the ticks before it.
+//
+// Records go one after another in a single buffer of HISTORY_BUDGET bytes, allocated once. When it's full the
+// oldest records are dropped to make room, a keyframe and its deltas together, so the history covers as many of the
+// most recent ticks as fit. Capturing a tick is one pass over the snapshot to compare it with the keyframe and a copy
+// into the buffer, with no allocation, so its cost grows with the snapshot's size and not with the length of the
+// history. Snapshots over HISTORY_MAX_STATE_BYTES aren't stored, which bounds that cost too, and a warning is printed
+// the first time one comes along.
+//
+// Delta layout: uint16 bytes to keep from the keyframe, uint16 bytes that changed, then the changed bytes, repeated
+// to the end of the snapshot.
+
+const size_t HISTORY_BUDGET = 4 * 1024 * 1024;
+const int HISTORY_KEYFRAME_INTERVAL = 60;        // Ticks, one second at 60 fps
+const size_t HISTORY_MAX_STATE_BYTES = 0xFFFF;   // Runs are counted in uint16
+const int HISTORY_MAX_RECORDS = 1 << 16;         // About 18 minutes at 60 fps
+
+struct HistoryRecord {
+    long tick;
+    uint32_t offset;             // Where its bytes are in the buffer
+    uint32_t size;
+    bool keyframe;
+};
+
+struct StateHistory {
+    std::vector<uint8_t> buffer;
+    std::vector<HistoryRecord> records;      // Ring, oldest at head
+    int head = 0;
+    int count = 0;
+    uint32_t writeOffset = 0;                // Where the next record goes
+    std::vector<uint8_t> keyframe;           // The snapshot new deltas are taken against
+    long keyframeTick = -1;
+    int sinceKeyframe = HISTORY_KEYFRAME_INTERVAL;
+    std::vector<uint8_t> delta;              // Scratch for encoding
+    size_t usedBytes = 0;
+    double captureMs = 0.0;                  // Time the last capture took, and the most any took
+    double maxCaptureMs = 0.0;
+    bool warnedOversize = false;             // A snapshot too big to store has been reported
+};
+
+inline StateHistory stateHistory;
+
+inline void historyInit() {
+    StateHistory& history = stateHistory;
+    history.buffer.assign(HISTORY_BUDGET, 0);
+    history.records.assign(HISTORY_MAX_RECORDS, HistoryRecord{});
+    history.keyframe.reserve(HISTORY_MAX_STATE_BYTES);
+    history.delta.reserve(HISTORY_MAX_STATE_BYTES * 3);   // A delta can be bigger than its snapshot
+    memTrackBytes(MEM_HEAP_HISTORY, (long long)(HISTORY_BUDGET + HISTORY_MAX_RECORDS * sizeof(HistoryRecord) +
+                                                HISTORY_MAX_STATE_BYTES * 4));
+}
+
+inline HistoryRecord& historyRecordAt(int index) {
+    return stateHistory.records[(stateHistory.head + index) % HISTORY_MAX_RECORDS];
+}
+
+inline void historyDropOldest() {
+    StateHistory& history = stateHistory;
+    history.usedBytes -= history.records[history.head].size;
+    history.head = (history.head + 1) % HISTORY_MAX_RECORDS;
+    history.count--;
+}
+
+// Make room for a record of the given size at the write position and return its offset
+inline uint32_t historyAllocate(uint32_t size) {
+    StateHistory& history = stateHistory;
+    if (history.writeOffset + size > history.buffer.size()) {
+        // Wrap around. The records between here and the end are the oldest, and the tail goes unused.
+        while (history.count > 0 && history.records[history.head].offset >= history.writeOffset) {
+            historyDropOldest();
+        }
+        history.writeOffset = 0;
+    }
+    while (history.count > 0 && (history.count == HISTORY_MAX_RECORDS ||
+           (history.records[history.head].offset >= history.writeOffset &&
+            history.records[history.head].offset < history.writeOffset + size))) {
+        historyDropOldest();
+    }
+    // Deltas are useless without their keyframe
+    while (history.count > 0 && !history.records[history.head].keyframe) {
+        historyDropOldest();
+    }
+    uint32_t offset = history.writeOffset;
+    history.writeOffset += size;
+    return offset;
+}
+
+inline void historyEncodeDelta(const std::vector<uint8_t>& state) {
+    StateHistory& history = stateHistory;
+    const uint8_t* base = history.keyframe.data();
+    const uint8_t* next = state.data();
+    size_t size = state.size();
+    history.delta.clear();
+    size_t i = 0;
+    while (i < size) {
+        size_t same = i;
+        while (same < size && base[same] == next[same]) {
+            same++;
+        }
+        size_t changed = same;
+        while (changed < size && base[changed] != next[changed]) {
+            changed++;
+        }
+        uint16_t keep = (uint16_t)(same - i), copy = (uint16_t)(changed - same);
+        history.delta.insert(history.delta.end(), (const uint8_t*)&keep, (const uint8_t*)&keep + sizeof(keep));
+        history.delta.insert(history.delta.end(), (const uint8_t*)&copy, (const uint8_t*)&copy + sizeof(copy));
+        history.delta.insert(history.delta.end(), next + same, next + changed);
+        i = changed;
+    }
+}
+
+// Store the world's state for a tick. Ticks must only go up, call historyDiscardAfter() before going back.
+inline void historyCapture(long tick, const std::vector<uint8_t>& state) {
+    StateHistory& history = stateHistory;
+    if (history.buffer.empty()) {
+        return;
+    }
+    if (state.size() > HISTORY_MAX_STATE_BYTES) {
+        if (!history.warnedOversize) {
+            printf("History: a %zu byte snapshot is over the %zu byte limit, ticks aren't kept while it's this big\n",
+                   state.size(), HISTORY_MAX_STATE_BYTES);
+            history.warnedOversize = true;
+        }
+        return;
+    }
+    double start = GetTime();
+
+    // A keyframe when it's time, when the snapshot's size changed (e.g. new dialogue text) so it can't be compared,
+    // or when the last keyframe has been dropped to make room
+    bool keyframe = history.sinceKeyframe >= HISTORY_KEYFRAME_INTERVAL || state.size() != history.keyframe.size() ||
+                    history.count == 0 || history.keyframeTick < historyRecordAt(0).tick;
+    if (!keyframe) {
+        historyEncodeDelta(state);
+        keyframe = history.delta.size() >= state.size();   // Most of it changed, the delta saves nothing
+    }
+    const std::vector<uint8_t>* bytes = &history.delta;
+    if (keyframe) {
+        history.keyframe = state;
+        history.keyframeTick = tick;
+        history.sinceKeyframe = 0;
+        bytes = &state;
+    } else {
+        history.sinceKeyframe++;
+    }
+
+    uint32_t size = (uint32_t)bytes->size();
+    uint32_t offset = historyAllocate(size);
+    if (!keyframe && (history.count == 0 || history.keyframeTick < historyRecordAt(0).tick)) {
+        // Making room dropped the keyframe this delta is against. Skip the tick, the next one is a keyframe.
+        history.writeOffset = offset;
+        return;
+    }
+    memcpy(history.buffer.data() + offset, bytes->data(), size);
+    historyRecordAt(history.count) = HistoryRecord{ tick, offset, size, keyframe };
+    history.count++;
+    history.usedBytes += size;
+
+    history.captureMs = (GetTime() - start) * 1000.0;
+    history.maxCaptureMs = (history.captureMs > history.maxCaptureMs) ? history.captureMs : history.maxCaptureMs;
+}
+
+inline bool historyEmpty() { return stateHistory.count == 0; }
+inline long historyOldestTick() { return historyEmpty() ? -1 : historyRecordAt(0).tick; }
+inline long historyNewestTick() { return historyEmpty() ? -1 : historyRecordAt(stateHistory.count - 1).tick; }
+
+// Index of the newest record at or before the tick, or -1
+inline int historyFind(long tick) {
+    int low = 0, high = stateHistory.count - 1, found = -1;
+    while (low <= high) {
+        int middle = (low + high) / 2;
+        if (historyRecordAt(middle).tick <= tick) {
+            found = middle;
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return found;
+}
+
+// Rebuild the snapshot of the newest stored tick at or before the given one. Returns the tick it's from, or -1.
+inline long historyRestore(long tick, std::vector<uint8_t>& state) {
+    int index = historyFind(tick);
+    if (index < 0) {
+        return -1;
+    }
+    int keyIndex = index;
+    while (!historyRecordAt(keyIndex).keyframe) {
+        keyIndex--;
+    }
+
+    const std::vector<uint8_t>& buffer = stateHistory.buffer;
+    const HistoryRecord& key = historyRecordAt(keyIndex);
+    state.assign(buffer.begin() + key.offset, buffer.begin() + key.offset + key.size);
+
+    const HistoryRecord& record = historyRecordAt(index);
+    if (!record.keyframe) {
+        const uint8_t* delta = buffer.data() + record.offset;
+        const uint8_t* end = delta + record.size;
+        size_t position = 0;
+        while (delta < end) {
+            uint16_t keep, copy;
+            memcpy(&keep, delta, sizeof(keep));
+            memcpy(&copy, delta + sizeof(keep), sizeof(copy));
+            delta += sizeof(keep) + sizeof(copy);
+            position += keep;
+            memcpy(state.data() + position, delta, copy);
+            delta += copy;
+            position += copy;
+        }
+    }
+    return record.tick;
+}
+
+// Forget every tick after the given one, e.g. after rewinding to it
+inline void historyDiscardAfter(long tick) {
+    StateHistory& history = stateHistory;
+    int keep = historyFind(tick) + 1;
+    while (history.count > keep) {
+        const HistoryRecord& newest = historyRecordAt(history.count - 1);
+        history.usedBytes -= newest.size;
+        history.writeOffset = newest.offset;
+        history.count--;
+    }
+    if (history.count == 0) {
+        history.writeOffset = 0;
+        history.sinceKeyframe = HISTORY_KEYFRAME_INTERVAL;
+        history.keyframeTick = -1;
+        return;
+    }
+
+    // New deltas continue from the newest remaining keyframe
+    int keyIndex = history.count - 1;
+    while (!historyRecordAt(keyIndex).keyframe) {
+        keyIndex--;
+    }
+    const HistoryRecord& key = historyRecordAt(keyIndex);
+    history.keyframe.assign(history.buffer.begin() + key.offset, history.buffer.begin() + key.offset + key.size);
+    history.keyframeTick = key.tick;
+    history.sinceKeyframe = history.count - 1 - keyIndex;
+    const HistoryRecord& newest = historyRecordAt(history.count - 1);
+    history.writeOffset = newest.offset + newest.size;
+}
+
+// One line for the debug overlay
+inline void historyDescribe(char* buffer, int bufferSize) {
+    const StateHistory& history = stateHistory;
+    snprintf(buffer, bufferSize, "History: %d ticks, %zu KB of %zu KB, capture %.3f ms (max %.3f)", history.count,
+             history.usedBytes / 1024, HISTORY_BUDGET / 1024, history.captureMs, history.maxCaptureMs);
+}
+
+#endif // STATE_HISTORY_H
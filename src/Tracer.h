@@ -0,0 +1,147 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+// Timeline instrumentation written as Chrome trace-event JSON, which chrome://tracing, Perfetto (ui.perfetto.dev)
+// and Speedscope can all open.
+//
+// Build with -DFC_TRACING to compile it in. Without it, TRACE_SCOPE(), TRACE_BEGIN() and TRACE_END() expand to
+// nothing, so the instrumented code is exactly what it would be without them.
+//
+// Each thread records begin/end events into a buffer of its own, so recording threads don't contend. The
+// buffers are written out and emptied by traceWrite(), which the game calls on F3 and on exit. Event names must be
+// string literals, or otherwise outlive the trace, because only the pointer is stored.
+
+#ifdef FC_TRACING
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+const size_t TRACE_BUFFER_CAPACITY = 1 << 20; // Events per thread between writes, 16 MB at most
+
+struct TraceEvent {
+    const char* name;   // nullptr for an end event, which closes the latest begin event on the same thread
+    int64_t timestamp;  // Microseconds since the tracer started
+};
+
+struct TraceBuffer {
+    std::mutex mutex;   // Only ever contended while traceWrite() is copying this buffer
+    std::vector<TraceEvent> events;
+    int threadIndex = 0;
+    bool full = false;
+};
+
+struct Tracer {
+    std::mutex mutex;
+    std::vector<TraceBuffer*> buffers;   // Never freed, a thread's buffer outlives the thread so it can be written
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int fileCount = 0;
+};
+
+inline Tracer tracer;
+
+inline TraceBuffer* traceThreadBuffer() {
+    thread_local TraceBuffer* buffer = nullptr;
+    if (!buffer) {
+        buffer = new TraceBuffer();
+        buffer->events.reserve(4096);
+        std::lock_guard<std::mutex> lock(tracer.mutex);
+        buffer->threadIndex = (int)tracer.buffers.size();
+        tracer.buffers.push_back(buffer);
+    }
+    return buffer;
+}
+
+inline void traceRecord(const char* name) {
+    int64_t timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - tracer.start).count();
+    TraceBuffer* buffer = traceThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    if (buffer->events.size() < TRACE_BUFFER_CAPACITY) {
+        buffer->events.push_back(TraceEvent{ name, timestamp });
+    } else {
+        buffer->full = true;
+    }
+}
+
+inline void traceBegin(const char* name) { traceRecord(name); }
+inline void traceEnd() { traceRecord(nullptr); }
+
+// Begins an event when constructed and ends it when it goes out of scope
+struct TraceScope {
+    explicit TraceScope(const char* name) { traceBegin(name); }
+    ~TraceScope() { traceEnd(); }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+// Write every thread's events to the given file and empty the buffers. Returns false if the file can't be written.
+inline bool traceWrite(const char* fileName) {
+    FILE* file = fopen(fileName, "w");
+    if (!file) {
+        printf("Failed to write trace: %s\n", fileName);
+        return false;
+    }
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    size_t written = 0;
+    std::lock_guard<std::mutex> tracerLock(tracer.mutex);
+    for (TraceBuffer* buffer : tracer.buffers) {
+        std::vector<TraceEvent> events;
+        bool full;
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            events.swap(buffer->events);
+            buffer->events.reserve(4096);
+            full = buffer->full;
+            buffer->full = false;
+        }
+        if (full) {
+            printf("Trace buffer of thread %d filled up, later events were dropped\n", buffer->threadIndex);
+        }
+
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s %d\"}}",
+                written++ ? ",\n" : "", buffer->threadIndex, buffer->threadIndex == 0 ? "main" : "worker",
+                buffer->threadIndex);
+        for (const TraceEvent& event : events) {
+            if (event.name) {
+                fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"B\",\"pid\":1,\"tid\":%d,\"ts\":%lld}", event.name,
+                        buffer->threadIndex, (long long)event.timestamp);
+            } else {
+                fprintf(file, ",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%d,\"ts\":%lld}", buffer->threadIndex,
+                        (long long)event.timestamp);
+            }
+        }
+    }
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    printf("Wrote trace: %s\n", fileName);
+    return true;
+}
+
+// Write to trace-<n>.json, numbered so that repeated writes don't overwrite each other
+inline void traceWriteNext() {
+    char fileName[64];
+    snprintf(fileName, sizeof(fileName), "trace-%d.json", tracer.fileCount++);
+    traceWrite(fileName);
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_BEGIN(name) traceBegin(name)
+#define TRACE_END() traceEnd()
+
+#else
+
+#define TRACE_SCOPE(name)
+#define TRACE_BEGIN(name)
+#define TRACE_END()
+
+inline void traceWriteNext() {}
+
+#endif // FC_TRACING
+
+#endif // TRACER_H
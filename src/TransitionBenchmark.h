@@ -0,0 +1,234 @@
+#ifndef TRANSITION_BENCHMARK_H
+#define TRANSITION_BENCHMARK_H
+
+#include "raylib.h"
+#include "MemoryStats.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+// Room switch benchmark. Walks the samurai through every portal in the game, in a fixed order, a given number of
+// times, and writes what each transition cost to a JSON file so that loading changes can be compared run to run.
+//
+// The samurai is moved into a portal's trigger area just before the game checks the portals, so every transition
+// goes through the same code as in play. For each one the benchmark records:
+//   - how long the map switch (the transition's action) blocked the frame it ran in,
+//   - the longest frame from the portal triggering until the fade in finished,
+//   - resident memory afterwards, as the OS reports it and as the memory overlay counts it.
+//
+// The second level has no portal back to the first, so each pass ends with a reset the game performs on request,
+// which is timed like the others.
+
+struct BenchmarkPortal {
+    const char* name;
+    const char* destination;     // File name of the map expected once the transition is over
+    float x, y;                  // A position inside the portal's trigger area
+    bool reset;                  // Not a portal: the game goes back to the first level by itself
+};
+
+const BenchmarkPortal BENCHMARK_ROUTE[] = {
+    { "LevelDesign -> Room2", "Room2.tmx", 925.0f, 1502.0f, false },
+    { "Room2 -> LevelDesign", "LevelDesign.tmx", 535.0f, 2175.0f, false },
+    { "LevelDesign -> Room3", "Room3.tmx", 5425.0f, 877.5f, false },
+    { "Room3 -> LevelDesign", "LevelDesign.tmx", 1555.0f, 2174.0f, false },
+    { "LevelDesign -> Room4", "Room4.tmx", 8310.0f, 2174.0f, false },
+    { "Room4 -> LevelDesign", "LevelDesign.tmx", 3060.0f, 2172.0f, false },
+    { "LevelDesign -> LevelDesign2", "LevelDesign2.tmx", 18800.0f, 3670.0f, false },
+    { "LevelDesign2 -> Lv2RoomOne", "Lv2RoomOne.tmx", 4415.0f, 2770.0f, false },
+    { "Lv2RoomOne -> LevelDesign2", "LevelDesign2.tmx", 1050.0f, 1250.0f, false },
+    { "LevelDesign2 -> Lv2RoomTwo", "Lv2RoomTwo.tmx", 5650.0f, 3350.0f, false },
+    { "Lv2RoomTwo -> LevelDesign2", "LevelDesign2.tmx", 1605.0f, 3400.0f, false },
+    { "LevelDesign2 -> Lv2Room3", "Lv2Room3.tmx", 7540.0f, 2950.0f, false },
+    { "Lv2Room3 -> LevelDesign2", "LevelDesign2.tmx", 1050.0f, 1250.0f, false },
+    { "LevelDesign2 -> Lv2Room4", "Lv2Room4.tmx", 9150.0f, 2050.0f, false },
+    { "Lv2Room4 -> LevelDesign2", "LevelDesign2.tmx", 1050.0f, 1250.0f, false },
+    { "LevelDesign2 -> LevelDesign (reset)", "LevelDesign.tmx", 0.0f, 0.0f, true }
+};
+
+const int BENCHMARK_ROUTE_LENGTH = sizeof(BENCHMARK_ROUTE) / sizeof(BENCHMARK_ROUTE[0]);
+
+struct BenchmarkResult {
+    int iteration;
+    int portal;                  // Index into BENCHMARK_ROUTE
+    double actionMs;
+    double maxFrameMs;
+    int frames;
+    long long residentBytes;     // -1 where the OS figure isn't available
+    long long trackedBytes;
+};
+
+enum BenchmarkPhase {
+    BENCHMARK_IDLE,              // Waiting to place the samurai in the next portal
+    BENCHMARK_PLACED,            // Placed this frame, the portal should have triggered
+    BENCHMARK_RUNNING            // Fading out and back in
+};
+
+struct TransitionBenchmark {
+    bool enabled = false;
+    int iterations = 0;
+    char fileName[128] = "transition-benchmark.json";
+    int iteration = 0;
+    int step = 0;
+    BenchmarkPhase phase = BENCHMARK_IDLE;
+    double lastFrameEnd = 0.0;
+    BenchmarkResult current = {};
+    std::vector<BenchmarkResult> results;
+};
+
+inline TransitionBenchmark transitionBenchmark;
+
+inline bool benchmarkStart(int iterations) {
+    if (iterations <= 0) {
+        printf("Transition benchmark needs at least one iteration\n");
+        return false;
+    }
+    transitionBenchmark.enabled = true;
+    transitionBenchmark.iterations = iterations;
+    transitionBenchmark.results.reserve((size_t)iterations * BENCHMARK_ROUTE_LENGTH);
+    printf("Transition benchmark: %d passes over %d transitions\n", iterations, BENCHMARK_ROUTE_LENGTH);
+    return true;
+}
+
+// Resident set size of the process, or -1 where it can't be read
+inline long long benchmarkResidentBytes() {
+#ifdef __linux__
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (!file) {
+        return -1;
+    }
+    long long pages = 0, residentPages = 0;
+    int read = fscanf(file, "%lld %lld", &pages, &residentPages);
+    fclose(file);
+    return (read == 2) ? residentPages * sysconf(_SC_PAGESIZE) : -1;
+#else
+    return -1;
+#endif
+}
+
+// Returns the portal to put the samurai in this frame, or nullptr while a transition is still running.
+// Call just before the game checks the portals.
+inline const BenchmarkPortal* benchmarkNextPortal(bool transitioning) {
+    TransitionBenchmark& benchmark = transitionBenchmark;
+    if (!benchmark.enabled || benchmark.phase != BENCHMARK_IDLE || transitioning) {
+        return nullptr;
+    }
+    benchmark.phase = BENCHMARK_PLACED;
+    benchmark.current = BenchmarkResult{ benchmark.iteration, benchmark.step, 0.0, 0.0, 0, -1, 0 };
+    return &BENCHMARK_ROUTE[benchmark.step];
+}
+
+// Call with how long the transition's action took
+inline void benchmarkRecordAction(double seconds) {
+    if (transitionBenchmark.enabled) {
+        transitionBenchmark.current.actionMs += seconds * 1000.0;
+    }
+}
+
+inline void benchmarkWrite() {
+    const TransitionBenchmark& benchmark = transitionBenchmark;
+    FILE* file = fopen(benchmark.fileName, "w");
+    if (!file) {
+        printf("Failed to write benchmark results: %s\n", benchmark.fileName);
+        return;
+    }
+
+    fprintf(file, "{\n  \"iterations\": %d,\n  \"transitions\": [\n", benchmark.iterations);
+    for (size_t i = 0; i < benchmark.results.size(); i++) {
+        const BenchmarkResult& result = benchmark.results[i];
+        fprintf(file, "    {\"iteration\": %d, \"name\": \"%s\", \"action_ms\": %.3f, \"max_frame_ms\": %.3f, "
+                "\"frames\": %d, \"resident_bytes\": %lld, \"tracked_bytes\": %lld}%s\n", result.iteration,
+                BENCHMARK_ROUTE[result.portal].name, result.actionMs, result.maxFrameMs, result.frames,
+                result.residentBytes, result.trackedBytes, (i + 1 < benchmark.results.size()) ? "," : "");
+    }
+
+    // Per-portal aggregates over every pass, the numbers to compare between runs
+    fprintf(file, "  ],\n  \"summary\": [\n");
+    for (int portal = 0; portal < BENCHMARK_ROUTE_LENGTH; portal++) {
+        int count = 0;
+        double actionSum = 0.0, actionMax = 0.0, frameMax = 0.0;
+        for (const BenchmarkResult& result : benchmark.results) {
+            if (result.portal == portal) {
+                count++;
+                actionSum += result.actionMs;
+                actionMax = (result.actionMs > actionMax) ? result.actionMs : actionMax;
+                frameMax = (result.maxFrameMs > frameMax) ? result.maxFrameMs : frameMax;
+            }
+        }
+        fprintf(file, "    {\"name\": \"%s\", \"count\": %d, \"action_ms_mean\": %.3f, \"action_ms_max\": %.3f, "
+                "\"max_frame_ms\": %.3f}%s\n", BENCHMARK_ROUTE[portal].name, count,
+                count ? actionSum / count : 0.0, actionMax, frameMax,
+                (portal + 1 < BENCHMARK_ROUTE_LENGTH) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    printf("Wrote benchmark results: %s\n", benchmark.fileName);
+}
+
+// Call once per frame after EndDrawing(). Returns true once the benchmark is over, whether it finished or failed,
+// and the results so far have been written.
+inline bool benchmarkEndFrame(bool transitioning, const char* mapFileName, bool gameOver) {
+    TransitionBenchmark& benchmark = transitionBenchmark;
+    if (!benchmark.enabled) {
+        return false;
+    }
+    if (gameOver) {
+        printf("Transition benchmark: the samurai died, stopping\n");
+        benchmarkWrite();
+        return true;
+    }
+
+    double now = GetTime();
+    double frameMs = (benchmark.lastFrameEnd > 0.0) ? (now - benchmark.lastFrameEnd) * 1000.0 : 0.0;
+    benchmark.lastFrameEnd = now;
+    BenchmarkResult& result = benchmark.current;
+    const BenchmarkPortal& portal = BENCHMARK_ROUTE[benchmark.step];
+
+    if (benchmark.phase == BENCHMARK_PLACED) {
+        if (!transitioning) {
+            printf("Transition benchmark: %s didn't trigger, stopping\n", portal.name);
+            benchmarkWrite();
+            return true;
+        }
+        benchmark.phase = BENCHMARK_RUNNING;
+    }
+    if (benchmark.phase != BENCHMARK_RUNNING) {
+        return false;
+    }
+
+    result.frames++;
+    result.maxFrameMs = (frameMs > result.maxFrameMs) ? frameMs : result.maxFrameMs;
+    if (transitioning) {
+        return false;
+    }
+
+    long long tracked = 0;
+    for (int i = 0; i < MEM_CATEGORY_COUNT; i++) {
+        tracked += (long long)memoryStats.bytes[i];
+    }
+    result.residentBytes = benchmarkResidentBytes();
+    result.trackedBytes = tracked;
+    benchmark.results.push_back(result);
+    benchmark.phase = BENCHMARK_IDLE;
+
+    if (!mapFileName || strcmp(mapFileName, portal.destination) != 0) {
+        printf("Transition benchmark: %s ended in %s instead of %s, stopping\n", portal.name,
+               mapFileName ? mapFileName : "no map", portal.destination);
+        benchmarkWrite();
+        return true;
+    }
+
+    if (++benchmark.step == BENCHMARK_ROUTE_LENGTH) {
+        benchmark.step = 0;
+        printf("Transition benchmark: pass %d of %d done\n", benchmark.iteration + 1, benchmark.iterations);
+        if (++benchmark.iteration == benchmark.iterations) {
+            benchmarkWrite();
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // TRANSITION_BENCHMARK_H
@@ -0,0 +1,116 @@
+#ifndef WORLD_SNAPSHOT_H
+#define WORLD_SNAPSHOT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Binary snapshots of the game's state, for checkpoints and quick saves. A snapshot is a flat byte buffer written
+// field by field in a fixed order and read back in the same order, with nothing to parse and no allocation beyond
+// the buffer itself, so saving and restoring take microseconds. The game decides what goes in (see writeWorld() in
+// 2dgame.cpp), this only provides the format.
+//
+// Layout, in the machine's byte order since snapshots don't leave the process:
+//   header: "FCWS", uint32 version, uint32 payload size
+//   payload: the fields, each stored as its raw bytes. Strings are a uint16 length followed by their characters.
+// Bump SNAPSHOT_VERSION whenever the fields change, so an old snapshot is refused rather than misread.
+
+const uint32_t SNAPSHOT_VERSION = 4;
+const size_t SNAPSHOT_HEADER_SIZE = 12;
+
+struct SnapshotWriter {
+    std::vector<uint8_t>& bytes;
+
+    // Start a snapshot in the given buffer, reusing its storage
+    explicit SnapshotWriter(std::vector<uint8_t>& buffer) : bytes(buffer) {
+        bytes.clear();
+        bytes.insert(bytes.end(), { 'F', 'C', 'W', 'S' });
+        put(SNAPSHOT_VERSION);
+        put(uint32_t(0));    // Payload size, filled in by finish()
+    }
+
+    template <typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be stored as bytes");
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(&value);
+        bytes.insert(bytes.end(), data, data + sizeof(T));
+    }
+
+    void putString(const std::string& text) {
+        uint16_t length = (uint16_t)(text.size() < 0xFFFF ? text.size() : 0xFFFF);
+        put(length);
+        bytes.insert(bytes.end(), text.begin(), text.begin() + length);
+    }
+
+    void finish() {
+        uint32_t payload = (uint32_t)(bytes.size() - SNAPSHOT_HEADER_SIZE);
+        memcpy(bytes.data() + 8, &payload, sizeof(payload));
+    }
+};
+
+// Reads fields back in the order they were written. A read past the end fails, and so does every read after it,
+// so callers can check ok once at the end.
+struct SnapshotReader {
+    const std::vector<uint8_t>& bytes;
+    size_t offset = SNAPSHOT_HEADER_SIZE;
+    bool ok = false;
+
+    // Checks the header. ok is false when the buffer isn't a snapshot of this version.
+    explicit SnapshotReader(const std::vector<uint8_t>& buffer) : bytes(buffer) {
+        uint32_t version = 0, payload = 0;
+        if (bytes.size() < SNAPSHOT_HEADER_SIZE || memcmp(bytes.data(), "FCWS", 4) != 0) {
+            return;
+        }
+        memcpy(&version, bytes.data() + 4, sizeof(version));
+        memcpy(&payload, bytes.data() + 8, sizeof(payload));
+        if (version != SNAPSHOT_VERSION) {
+            printf("Snapshot is version %u, expected %u\n", version, SNAPSHOT_VERSION);
+            return;
+        }
+        ok = (payload == bytes.size() - SNAPSHOT_HEADER_SIZE);
+    }
+
+    template <typename T>
+    T get() {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be read as bytes");
+        T value{};
+        if (ok && offset + sizeof(T) <= bytes.size()) {
+            memcpy(&value, bytes.data() + offset, sizeof(T));
+            offset += sizeof(T);
+        } else {
+            ok = false;
+        }
+        return value;
+    }
+
+    std::string getString() {
+        uint16_t length = get<uint16_t>();
+        if (!ok || offset + length > bytes.size()) {
+            ok = false;
+            return std::string();
+        }
+        std::string text(reinterpret_cast<const char*>(bytes.data() + offset), length);
+        offset += length;
+        return text;
+    }
+};
+
+// Fixed-size sets of flags, stored as one word
+inline uint32_t snapshotPackFlags(const bool* const* flags, int count) {
+    uint32_t packed = 0;
+    for (int i = 0; i < count && i < 32; i++) {
+        packed |= (*flags[i] ? 1u : 0u) << i;
+    }
+    return packed;
+}
+
+inline void snapshotUnpackFlags(uint32_t packed, bool* const* flags, int count) {
+    for (int i = 0; i < count && i < 32; i++) {
+        *flags[i] = (packed >> i) & 1u;
+    }
+}
+
+#endif // WORLD_SNAPSHOT_H
@@ -0,0 +1,408 @@
+// Synthetic TMX maps for measuring how raytmx scales, and a benchmark to run against them.
+//
+//   stressmap generate <out.tmx> [options]   write a map
+//   stressmap bench <map.tmx>... [options]   load, draw and query each map, and append a CSV row per map
+//
+// Generate options:
+//   --width <tiles>, --height <tiles>   map size (default 1500x500, the size of the game's maps)
+//   --layers <n>                        tile layers (default 1)
+//   --density <0-1>                     fraction of each layer's tiles that aren't empty (default 0.3)
+//   --objects <n>                       objects in the object layer (default 128)
+//   --shapes <list>                     comma-separated mix of rect, polygon and tile (default rect)
+//   --encoding <csv|base64|zlib>        how tile layers are written (default csv)
+//   --tileset <file.tsx>                tileset to reference, relative to the map (default the game's)
+//   --seed <n>                          random seed, the same options and seed write the same file
+//
+// Bench options:
+//   --loads <n>       times each map is loaded, the mean is reported (default 5)
+//   --frames <n>      frames drawn while the camera pans across the map (default 300)
+//   --queries <n>     random collision queries against the object layers (default 100000)
+//   --gpu             draw tile layers with EnableGpuRenderingTMX()
+//   --csv <file>      append results to this file instead of stdout, writing the header if it's new
+//
+// Build next to the game, e.g.:
+//   g++ -std=c++17 -O2 -I lib tools/StressMap.cpp -o stressmap -lraylib -lGL -lm -lpthread -ldl
+
+#define RAYTMX_IMPLEMENTATION
+#include "raylib.h"
+#include "raytmx.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+const int TILE_SIZE = 16;
+const int TILESET_TILE_COUNT = 60;
+
+struct GenerateOptions {
+    int width = 1500;
+    int height = 500;
+    int layers = 1;
+    float density = 0.3f;
+    int objects = 128;
+    bool rects = true;
+    bool polygons = false;
+    bool tileObjects = false;
+    const char* encoding = "csv";
+    const char* tileset = "16 x16 Purple Dungeon Sprite Sheet.tsx";
+    uint32_t seed = 1;
+};
+
+struct BenchOptions {
+    int loads = 5;
+    int frames = 300;
+    int queries = 100000;
+    bool gpu = false;
+    const char* csv = nullptr;
+};
+
+// xorshift32, so a seed writes the same map on every platform
+uint32_t randomState = 1;
+
+uint32_t randomNext() {
+    uint32_t x = randomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    randomState = x;
+    return x;
+}
+
+float randomRange(float min, float max) {
+    return min + (max - min) * ((randomNext() >> 8) * (1.0f / 16777216.0f));
+}
+
+uint32_t adler32(const unsigned char* data, int length) {
+    uint32_t a = 1, b = 0;
+    for (int i = 0; i < length; i++) {
+        a = (a + data[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+// Write the layer's GIDs as Base64, zlib-wrapped first if asked. Returns false if raylib couldn't compress them.
+bool writeBase64Tiles(FILE* file, const std::vector<uint32_t>& gids, bool zlib) {
+    // GIDs are stored little-endian, which is what every platform the game targets uses in memory
+    std::vector<unsigned char> bytes((const unsigned char*)gids.data(),
+                                     (const unsigned char*)gids.data() + gids.size() * sizeof(uint32_t));
+    if (zlib) {
+        // raylib's CompressData() writes raw DEFLATE, so add the two byte zlib header and the Adler-32 trailer
+        int compressedLength = 0;
+        unsigned char* compressed = CompressData(bytes.data(), (int)bytes.size(), &compressedLength);
+        if (compressed == NULL) {
+            return false;
+        }
+        uint32_t checksum = adler32(bytes.data(), (int)bytes.size());
+        std::vector<unsigned char> wrapped = { 0x78, 0x9C };
+        wrapped.insert(wrapped.end(), compressed, compressed + compressedLength);
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            wrapped.push_back((unsigned char)(checksum >> shift));
+        }
+        MemFree(compressed);
+        bytes.swap(wrapped);
+    }
+
+    int encodedLength = 0;
+    char* encoded = EncodeDataBase64(bytes.data(), (int)bytes.size(), &encodedLength);
+    if (encoded == NULL) {
+        return false;
+    }
+    // Older raylib versions don't terminate the string, so write exactly the encoded characters
+    fwrite(encoded, 1, 4 * ((bytes.size() + 2) / 3), file);
+    MemFree(encoded);
+    return true;
+}
+
+void writeObject(FILE* file, int id, const GenerateOptions& options) {
+    float mapWidth = (float)(options.width * TILE_SIZE), mapHeight = (float)(options.height * TILE_SIZE);
+
+    // Pick uniformly among the enabled shapes
+    int kinds[3], kindCount = 0;
+    if (options.rects) kinds[kindCount++] = 0;
+    if (options.polygons) kinds[kindCount++] = 1;
+    if (options.tileObjects) kinds[kindCount++] = 2;
+    int kind = kinds[randomNext() % kindCount];
+
+    float x = randomRange(0.0f, mapWidth - 64.0f), y = randomRange(0.0f, mapHeight - 64.0f);
+    if (kind == 0) {
+        fprintf(file, "  <object id=\"%d\" x=\"%.2f\" y=\"%.2f\" width=\"%.2f\" height=\"%.2f\"/>\n", id, x, y,
+                randomRange(8.0f, 256.0f), randomRange(8.0f, 64.0f));
+    } else if (kind == 1) {
+        // A convex polygon: points around a circle at increasing angles
+        int points = 3 + (int)(randomNext() % 6);
+        float radius = randomRange(8.0f, 32.0f);
+        fprintf(file, "  <object id=\"%d\" x=\"%.2f\" y=\"%.2f\">\n   <polygon points=\"", id, x + 32.0f, y + 32.0f);
+        for (int i = 0; i < points; i++) {
+            float angle = (i + randomRange(0.0f, 0.8f)) * (2.0f * PI / points);
+            fprintf(file, "%s%.2f,%.2f", i ? " " : "", cosf(angle) * radius, sinf(angle) * radius);
+        }
+        fprintf(file, "\"/>\n  </object>\n");
+    } else {
+        // Tile objects are positioned by their bottom-left corner
+        fprintf(file, "  <object id=\"%d\" gid=\"%d\" x=\"%.2f\" y=\"%.2f\" width=\"%d\" height=\"%d\"/>\n", id,
+                1 + (int)(randomNext() % TILESET_TILE_COUNT), x, y + TILE_SIZE, TILE_SIZE, TILE_SIZE);
+    }
+}
+
+bool generate(const char* fileName, const GenerateOptions& options) {
+    FILE* file = fopen(fileName, "w");
+    if (!file) {
+        printf("Failed to write %s\n", fileName);
+        return false;
+    }
+    randomState = options.seed ? options.seed : 1;
+
+    fprintf(file, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    fprintf(file, "<map version=\"1.10\" tiledversion=\"1.11.2\" orientation=\"orthogonal\" renderorder=\"right-down\" "
+            "width=\"%d\" height=\"%d\" tilewidth=\"%d\" tileheight=\"%d\" infinite=\"0\" nextlayerid=\"%d\" "
+            "nextobjectid=\"%d\">\n", options.width, options.height, TILE_SIZE, TILE_SIZE, options.layers + 2,
+            options.objects + 1);
+    fprintf(file, " <tileset firstgid=\"1\" source=\"%s\"/>\n", options.tileset);
+
+    std::vector<uint32_t> gids((size_t)options.width * options.height);
+    bool csv = strcmp(options.encoding, "csv") == 0;
+    bool zlib = strcmp(options.encoding, "zlib") == 0;
+    for (int layer = 0; layer < options.layers; layer++) {
+        for (uint32_t& gid : gids) {
+            gid = (randomRange(0.0f, 1.0f) < options.density) ? 1 + randomNext() % TILESET_TILE_COUNT : 0;
+        }
+
+        fprintf(file, " <layer id=\"%d\" name=\"Tile Layer %d\" width=\"%d\" height=\"%d\">\n", layer + 1, layer + 1,
+                options.width, options.height);
+        if (csv) {
+            fprintf(file, "  <data encoding=\"csv\">\n");
+            for (int y = 0; y < options.height; y++) {
+                for (int x = 0; x < options.width; x++) {
+                    bool last = (y == options.height - 1) && (x == options.width - 1);
+                    fprintf(file, "%u%s", gids[(size_t)y * options.width + x], last ? "" : ",");
+                }
+                fprintf(file, "\n");
+            }
+        } else {
+            fprintf(file, zlib ? "  <data encoding=\"base64\" compression=\"zlib\">\n   "
+                               : "  <data encoding=\"base64\">\n   ");
+            if (!writeBase64Tiles(file, gids, zlib)) {
+                printf("Failed to encode tile layer %d, raylib may have been built without compression\n", layer + 1);
+                fclose(file);
+                return false;
+            }
+            fprintf(file, "\n");
+        }
+        fprintf(file, "  </data>\n </layer>\n");
+    }
+
+    fprintf(file, " <objectgroup id=\"%d\" name=\"Object Layer 1\">\n", options.layers + 1);
+    for (int i = 0; i < options.objects; i++) {
+        writeObject(file, i + 1, options);
+    }
+    fprintf(file, " </objectgroup>\n</map>\n");
+    fclose(file);
+
+    printf("Wrote %s: %dx%d, %d layer(s) at %.0f%% density, %d objects, %s\n", fileName, options.width,
+           options.height, options.layers, options.density * 100.0f, options.objects, options.encoding);
+    return true;
+}
+
+bool bench(const char* fileName, const BenchOptions& options, FILE* out) {
+    // Loading, averaged over several loads. Each one reads and parses the document and loads the tileset's image.
+    double loadTotal = 0.0;
+    TmxMap* map = NULL;
+    for (int i = 0; i < options.loads; i++) {
+        if (map) {
+            UnloadTMX(map);
+        }
+        double start = GetTime();
+        map = LoadTMX(fileName);
+        loadTotal += GetTime() - start;
+        if (!map) {
+            printf("Failed to load %s\n", fileName);
+            return false;
+        }
+    }
+    if (options.gpu) {
+        EnableGpuRenderingTMX(map);
+    }
+
+    long long tiles = 0, objects = 0;
+    for (uint32_t i = 0; i < map->layersLength; i++) {
+        const TmxLayer& layer = map->layers[i];
+        if (layer.type == LAYER_TYPE_TILE_LAYER) {
+            for (uint32_t t = 0; t < layer.exact.tileLayer.tilesLength; t++) {
+                tiles += (layer.exact.tileLayer.tiles[t] != 0);
+            }
+        } else if (layer.type == LAYER_TYPE_OBJECT_GROUP) {
+            objects += layer.exact.objectGroup.objectsLength;
+        }
+    }
+    TmxMemoryUsage usage = GetMemoryUsageTMX(map);
+    float mapWidth = (float)(map->width * map->tileWidth), mapHeight = (float)(map->height * map->tileHeight);
+
+    // Drawing, with the game's camera panning left to right across the middle of the map
+    Camera2D camera = { 0 };
+    camera.offset = Vector2{ GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f };
+    camera.zoom = 3.3f;
+    double drawTotal = 0.0, drawMax = 0.0;
+    for (int frame = 0; frame < options.frames; frame++) {
+        camera.target = Vector2{ mapWidth * (frame + 0.5f) / options.frames, mapHeight / 2.0f };
+        double start = GetTime();
+        BeginDrawing();
+        ClearBackground(BLACK);
+        BeginMode2D(camera);
+        DrawTMX(map, &camera, 0, 0, WHITE);
+        EndMode2D();
+        EndDrawing();
+        double elapsed = GetTime() - start;
+        drawTotal += elapsed;
+        drawMax = (elapsed > drawMax) ? elapsed : drawMax;
+    }
+
+    // Collision queries with the samurai's size at random positions, against every object layer like the game does
+    randomState = 12345;
+    long long hits = 0;
+    double queryStart = GetTime();
+    for (int query = 0; query < options.queries; query++) {
+        Rectangle rect = { randomRange(0.0f, mapWidth), randomRange(0.0f, mapHeight), 32.0f, 48.0f };
+        for (uint32_t i = 0; i < map->layersLength; i++) {
+            if (map->layers[i].type == LAYER_TYPE_OBJECT_GROUP) {
+                hits += CheckCollisionTMXObjectGroupRec(map->layers[i].exact.objectGroup, rect, NULL);
+            }
+        }
+    }
+    double queryTotal = GetTime() - queryStart;
+
+    fprintf(out, "%s,%u,%u,%u,%lld,%lld,%d,%.3f,%zu,%.3f,%.3f,%.3f,%lld\n", GetFileName(fileName), map->width,
+            map->height, map->layersLength, tiles, objects, GetFileLength(fileName),
+            loadTotal * 1000.0 / options.loads, usage.heapBytes + usage.chunkBytes,
+            drawTotal * 1000.0 / options.frames, drawMax * 1000.0,
+            options.queries ? queryTotal * 1e6 / options.queries : 0.0, hits);
+    fflush(out);
+    UnloadTMX(map);
+    return true;
+}
+
+void printUsage() {
+    printf("Usage: stressmap generate <out.tmx> [--width n] [--height n] [--layers n] [--density f] [--objects n]\n"
+           "                 [--shapes rect,polygon,tile] [--encoding csv|base64|zlib] [--tileset file] [--seed n]\n"
+           "       stressmap bench <map.tmx>... [--loads n] [--frames n] [--queries n] [--gpu] [--csv file]\n");
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+
+    if (strcmp(argv[1], "generate") == 0) {
+        GenerateOptions options;
+        for (int i = 3; i < argc; i += 2) {
+            if (i + 1 >= argc) {
+                printf("Missing value for %s\n", argv[i]);
+                return 1;
+            } else if (strcmp(argv[i], "--width") == 0) {
+                options.width = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "--height") == 0) {
+                options.height = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "--layers") == 0) {
+                options.layers = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "--density") == 0) {
+                options.density = (float)atof(argv[i + 1]);
+            } else if (strcmp(argv[i], "--objects") == 0) {
+                options.objects = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "--shapes") == 0) {
+                options.rects = strstr(argv[i + 1], "rect") != NULL;
+                options.polygons = strstr(argv[i + 1], "polygon") != NULL;
+                options.tileObjects = strstr(argv[i + 1], "tile") != NULL;
+            } else if (strcmp(argv[i], "--encoding") == 0) {
+                options.encoding = argv[i + 1];
+            } else if (strcmp(argv[i], "--tileset") == 0) {
+                options.tileset = argv[i + 1];
+            } else if (strcmp(argv[i], "--seed") == 0) {
+                options.seed = (uint32_t)strtoul(argv[i + 1], NULL, 10);
+            } else {
+                printf("Unknown option: %s\n", argv[i]);
+                printUsage();
+                return 1;
+            }
+        }
+        if (options.width <= 0 || options.height <= 0 || options.layers < 0 || options.objects < 0) {
+            printf("Map size must be positive and counts can't be negative\n");
+            return 1;
+        }
+        if (!options.rects && !options.polygons && !options.tileObjects) {
+            printf("--shapes needs at least one of rect, polygon and tile\n");
+            return 1;
+        }
+        if (strcmp(options.encoding, "csv") != 0 && strcmp(options.encoding, "base64") != 0 &&
+            strcmp(options.encoding, "zlib") != 0) {
+            printf("Unknown encoding: %s\n", options.encoding);
+            return 1;
+        }
+        return generate(argv[2], options) ? 0 : 1;
+    }
+
+    if (strcmp(argv[1], "bench") == 0) {
+        BenchOptions options;
+        std::vector<const char*> maps;
+        for (int i = 2; i < argc; i++) {
+            if (strcmp(argv[i], "--gpu") == 0) {
+                options.gpu = true;
+            } else if (strncmp(argv[i], "--", 2) != 0) {
+                maps.push_back(argv[i]);
+            } else if (i + 1 >= argc) {
+                printf("Missing value for %s\n", argv[i]);
+                return 1;
+            } else if (strcmp(argv[i], "--loads") == 0) {
+                options.loads = atoi(argv[++i]);
+            } else if (strcmp(argv[i], "--frames") == 0) {
+                options.frames = atoi(argv[++i]);
+            } else if (strcmp(argv[i], "--queries") == 0) {
+                options.queries = atoi(argv[++i]);
+            } else if (strcmp(argv[i], "--csv") == 0) {
+                options.csv = argv[++i];
+            } else {
+                printf("Unknown option: %s\n", argv[i]);
+                printUsage();
+                return 1;
+            }
+        }
+        if (options.loads < 1) options.loads = 1;
+        if (options.frames < 1) options.frames = 1;
+
+        FILE* out = stdout;
+        bool writeHeader = true;
+        if (options.csv) {
+            writeHeader = !FileExists(options.csv);
+            out = fopen(options.csv, "a");
+            if (!out) {
+                printf("Failed to open %s\n", options.csv);
+                return 1;
+            }
+        }
+        if (writeHeader) {
+            fprintf(out, "map,width,height,layers,tiles,objects,file_bytes,load_ms,heap_bytes,draw_ms_mean,"
+                    "draw_ms_max,query_us,hits\n");
+        }
+
+        // A window is needed for the textures and drawing, but nobody needs to see it, or wait for vsync
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        SetTraceLogLevel(LOG_WARNING);
+        InitWindow(1920, 1080, "stressmap");
+        SetTargetFPS(0);
+
+        bool ok = true;
+        for (const char* mapFile : maps) {
+            ok = bench(mapFile, options, out) && ok;
+        }
+        CloseWindow();
+        if (out != stdout) {
+            fclose(out);
+        }
+        return ok ? 0 : 1;
+    }
+
+    printUsage();
+    return 1;
+}